@@ -0,0 +1,32 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+/*-- layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+
+/*-- uniform layout(binding=0, rgba16f) restrict --*/ image2D frame_image;
+/*-- uniform layout(binding=1, rgba32f) restrict --*/ image2D accumulated_frames;
+
+// Running average of the frames rendered with the stochastic transparency since the last change of the uniforms.
+// The average replaces the frame in the fbo.
+void main(void){
+    const ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if(pixel.x >= int(uniforms.width) || pixel.y >= int(uniforms.height)){
+        return;
+    }
+
+    const vec4 frame = imageLoad(frame_image, pixel);
+    vec4 average = frame;
+    if(uniforms.stochastic_frame > 0){
+        average = imageLoad(accumulated_frames, pixel);
+        average += (frame - average) / float(uniforms.stochastic_frame + 1);
+    }
+
+    imageStore(accumulated_frames, pixel, average);
+    imageStore(frame_image, pixel, average);
+}
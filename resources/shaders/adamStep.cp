@@ -0,0 +1,124 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+/*-- layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+#include "./common/SphericalHarmonics.h"
+
+uniform float lr_positions;
+uniform float lr_scales;
+uniform float lr_rotations;
+uniform float lr_opacities;
+uniform float lr_sh_dc;
+uniform float lr_sh_rest;
+uniform float beta1;
+uniform float beta2;
+uniform float adam_epsilon;
+uniform float bias_correction1; // 1 - beta1^t
+uniform float bias_correction2; // 1 - beta2^t
+
+// Updates the moments in place and returns the step to subtract from the parameters.
+vec4 adam(const vec4 grad, ___inout vec4 m, ___inout vec4 v, const vec4 lr){
+    m = beta1 * m + (1.0f - beta1) * grad;
+    v = beta2 * v + (1.0f - beta2) * grad * grad;
+    return lr * (m / bias_correction1) / (sqrt(v / bias_correction2) + adam_epsilon);
+}
+
+float getDLoss_dsh_coeff(const int GaussianID, const int j){
+    const int i = GaussianID * 16 + j / 3;
+    const int c = j % 3;
+    return c == 0 ? uniforms.dLoss_dsh_coeffs_red[i] : c == 1 ? uniforms.dLoss_dsh_coeffs_green[i] : uniforms.dLoss_dsh_coeffs_blue[i];
+}
+
+void setSHCoeff(const int GaussianID, const int j, const float value){
+    const int i = GaussianID * 16 + j / 3;
+    const int c = j % 3;
+    if(c == 0) uniforms.sh_coeffs_red[i] = value;
+    if(c == 1) uniforms.sh_coeffs_green[i] = value;
+    if(c == 2) uniforms.sh_coeffs_blue[i] = value;
+}
+
+// Adam step on all the attributes of the gaussians in a single pass, one thread per gaussian.
+// The scales and opacities are stored after their activation, so the step is taken on the parameters
+// before the activation, log(scale) and logit(opacity), and the activation is applied again in place.
+// The moments are stored as (first, second) for each gaussian, see CommonTypes.h. CpuAdam is the cpu reference.
+void main(void){
+    const int GaussianID = int(gl_GlobalInvocationID.x);
+    if(GaussianID >= uniforms.num_gaussians)
+        return;
+
+    // the w components of the gradients are 0, so the w components of the attributes don't change
+    {
+        vec4 m = uniforms.moments_positions[GaussianID * 2 + 0];
+        vec4 v = uniforms.moments_positions[GaussianID * 2 + 1];
+        uniforms.positions[GaussianID] -= adam(uniforms.dLoss_dpositions[GaussianID], m, v, vec4(lr_positions));
+        uniforms.moments_positions[GaussianID * 2 + 0] = m;
+        uniforms.moments_positions[GaussianID * 2 + 1] = v;
+    }
+
+    {
+        vec4 m = uniforms.moments_scales[GaussianID * 2 + 0];
+        vec4 v = uniforms.moments_scales[GaussianID * 2 + 1];
+        const vec4 scale = uniforms.scales[GaussianID];
+        const vec4 dLoss_dlog_scale = uniforms.dLoss_dscales[GaussianID] * scale;
+        uniforms.scales[GaussianID] = scale * exp(-adam(dLoss_dlog_scale, m, v, vec4(lr_scales)));
+        uniforms.moments_scales[GaussianID * 2 + 0] = m;
+        uniforms.moments_scales[GaussianID * 2 + 1] = v;
+    }
+
+    {
+        // the rotations are unit quaternions
+        vec4 m = uniforms.moments_rotations[GaussianID * 2 + 0];
+        vec4 v = uniforms.moments_rotations[GaussianID * 2 + 1];
+        const vec4 rotation = uniforms.rotations[GaussianID] - adam(uniforms.dLoss_drotations[GaussianID], m, v, vec4(lr_rotations));
+        uniforms.rotations[GaussianID] = normalize(rotation);
+        uniforms.moments_rotations[GaussianID * 2 + 0] = m;
+        uniforms.moments_rotations[GaussianID * 2 + 1] = v;
+    }
+
+    float new_opacity;
+    {
+        vec4 m = vec4(uniforms.moments_opacities[GaussianID].x, 0.0f, 0.0f, 0.0f);
+        vec4 v = vec4(uniforms.moments_opacities[GaussianID].y, 0.0f, 0.0f, 0.0f);
+        const float opacity = clamp(uniforms.opacities[GaussianID], 1.0E-6f, 1.0f - 1.0E-6f);
+        const float dLoss_dlogit = uniforms.dLoss_dopacities[GaussianID] * opacity * (1.0f - opacity);
+        const float logit = log(opacity / (1.0f - opacity)) - adam(vec4(dLoss_dlogit, 0.0f, 0.0f, 0.0f), m, v, vec4(lr_opacities)).x;
+        new_opacity = 1.0f / (1.0f + exp(-logit));
+        uniforms.opacities[GaussianID] = new_opacity;
+        uniforms.moments_opacities[GaussianID] = vec2(m.x, v.x);
+    }
+
+    // The step is taken on the interleaved layout, 4 coefficients at a time, and copied to the planar layout.
+    vec3 dc = vec3(0.0f);
+    for(int q=0; q<SH_INTERLEAVED_VEC4; q++){
+        vec4 grad;
+        vec4 lr;
+        for(int l=0; l<4; l++){
+            grad[l] = getDLoss_dsh_coeff(GaussianID, q * 4 + l);
+            lr[l] = q * 4 + l < 3 ? lr_sh_dc : lr_sh_rest;
+        }
+
+        vec4 m = uniforms.moments_sh[GaussianID * SH_INTERLEAVED_VEC4 * 2 + q];
+        vec4 v = uniforms.moments_sh[GaussianID * SH_INTERLEAVED_VEC4 * 2 + SH_INTERLEAVED_VEC4 + q];
+        const vec4 sh_coeffs = uniforms.sh_coeffs_interleaved[GaussianID * SH_INTERLEAVED_VEC4 + q] - adam(grad, m, v, lr);
+        uniforms.moments_sh[GaussianID * SH_INTERLEAVED_VEC4 * 2 + q] = m;
+        uniforms.moments_sh[GaussianID * SH_INTERLEAVED_VEC4 * 2 + SH_INTERLEAVED_VEC4 + q] = v;
+
+        uniforms.sh_coeffs_interleaved[GaussianID * SH_INTERLEAVED_VEC4 + q] = sh_coeffs;
+        for(int l=0; l<4; l++){
+            setSHCoeff(GaussianID, q * 4 + l, sh_coeffs[l]);
+        }
+        if(q == 0){
+            dc = vec3(sh_coeffs);
+        }
+    }
+
+    // same as the colors baked at load time
+    const vec3 color = clamp(0.5f + SH_C0 * dc, 0.0f, 1.0f);
+    uniforms.baked_colors[GaussianID] = packUnorm4x8(vec4(color, new_opacity));
+}
@@ -0,0 +1,110 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+
+const int BATCH_SIZE = 16*16;
+/*-- layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+#include "./common/Tiles.h"
+
+/*-- uniform layout(binding=0, rgba16f) restrict --*/ image2D accumulated_image;
+uniform int depth_slice; // always 0 outside of the hybrid mode
+
+// gaussians of the current batch, loaded cooperatively by the threads of the tile
+shared vec4 batch_bounding_box[BATCH_SIZE];
+shared vec4 batch_conic_opacity[BATCH_SIZE];
+shared vec4 batch_color[BATCH_SIZE];
+shared int num_done;
+
+// One workgroup per tile, one thread per pixel. The gaussians overlapping the tile are blended in the depth order
+// with the same equations as the hardware blending of quad.fs, and the result is written to the fbo.
+// In the hybrid mode, the blending starts from the content of the fbo, which holds the previous depth slices.
+void main(void){
+    const int width = int(uniforms.width);
+    const int height = int(uniforms.height);
+    const int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    const int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    const int tile = int(gl_WorkGroupID.y) * tiles_x + int(gl_WorkGroupID.x);
+    const ivec2 range = uniforms.tile_ranges[depth_slice * tiles_x * tiles_y + tile];
+
+    const ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    const vec2 pixel_center = vec2(pixel) + 0.5f;
+    const bool inside = pixel.x < width && pixel.y < height;
+    const int thread = int(gl_LocalInvocationIndex);
+
+    vec3 color = vec3(0.0f);
+    float transmittance = 1.0f; // the fbo is cleared with alpha = 1
+    if(uniforms.hybrid_blending > 0){
+        if(range.x == range.y){
+            return; // nothing to add to the fbo, the whole workgroup leaves
+        }
+        if(inside){
+            const vec4 C = imageLoad(accumulated_image, pixel);
+            color = vec3(C);
+            transmittance = C.w;
+        }
+    }
+    bool done = !inside || (uniforms.front_to_back > 0 && transmittance < MIN_TRANSMITTANCE);
+
+    for(int batch = range.x; batch < range.y; batch += BATCH_SIZE){
+        // stop as soon as all the pixels of the tile are done
+        if(thread == 0){
+            num_done = 0;
+        }
+        barrier();
+        if(done){
+            atomicAdd(num_done, 1);
+        }
+        barrier();
+        if(num_done == BATCH_SIZE){
+            break;
+        }
+
+        const int i = batch + thread;
+        if(i < range.y){
+            const int n = int(uint(uniforms.sorted_tile_keys[i])); // lower 32 bits: index in the depth order
+            batch_bounding_box[thread] = uniforms.bounding_boxes[n];
+            batch_conic_opacity[thread] = uniforms.conic_opacity[n];
+            batch_color[thread] = uniforms.predicted_colors[n];
+        }
+        barrier();
+
+        const int count = min(BATCH_SIZE, range.y - batch);
+        for(int j=0; j<count && !done; j++){
+            const vec2 local_coord = pixel_center - vec2(batch_bounding_box[j]);
+            const vec4 conic_opacity = batch_conic_opacity[j];
+            const mat2 cov2D = mat2(conic_opacity.x, conic_opacity.y, conic_opacity.y, conic_opacity.z);
+
+            const float power = -0.5f * dot(local_coord, cov2D * local_coord);
+            if(power > 0.0f){
+                continue;
+            }
+
+            const float alpha = min(0.99f, conic_opacity.w * exp(power));
+            if(alpha < uniforms.min_opacity){
+                continue;
+            }
+
+            const vec3 c = vec3(batch_color[j]);
+            if(uniforms.front_to_back > 0){
+                // glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA)
+                color += transmittance * c * alpha;
+                transmittance *= 1.0f - alpha;
+                done = transmittance < MIN_TRANSMITTANCE;
+            }else{
+                // glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA), the alpha of the fbo stays at 1
+                color = c * alpha + (1.0f - alpha) * color;
+            }
+        }
+    }
+
+    if(inside){
+        imageStore(accumulated_image, pixel, vec4(color, transmittance));
+    }
+
+}
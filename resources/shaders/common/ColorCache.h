@@ -0,0 +1,45 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_COLORCACHE_H
+#define HARDWARERASTERIZED3DGS_COLORCACHE_H
+
+#include "Uniforms.h"
+
+// The view-dependent color of a gaussian only depends on the direction from the camera to its center.
+// The color is cached along with the direction it was evaluated at, and reused while the angle between
+// that direction and the current one stays below the threshold, and the degree of the spherical harmonics is the same.
+
+bool colorCacheLookup(const int GaussianID, const vec3 dir, const int degree, ___out vec4 color){
+    if(uniforms.color_cache == 0){
+        return false;
+    }
+    const vec4 cached_dir = uniforms.color_cache_dirs[GaussianID];
+    if(cached_dir.w != float(degree + 1) || dot(dir, vec3(cached_dir)) < uniforms.color_cache_min_cos){
+        return false;
+    }
+    color = uniforms.color_cache_colors[GaussianID];
+    return true;
+}
+
+void colorCacheStore(const int GaussianID, const vec3 dir, const int degree, const vec4 color){
+    if(uniforms.color_cache == 0){
+        return;
+    }
+    uniforms.color_cache_dirs[GaussianID] = vec4(dir, float(degree + 1));
+    uniforms.color_cache_colors[GaussianID] = color;
+}
+
+// One atomic per subgroup.
+void colorCacheCountHits(const bool hit){
+    if(uniforms.color_cache == 0){
+        return;
+    }
+    const uint hits = subgroupBallotBitCount(subgroupBallot(hit));
+    if(subgroupElect() && hits > 0){
+        atomicAdd(uniforms.color_cache_hits, int(hits));
+    }
+}
+
+#endif //HARDWARERASTERIZED3DGS_COLORCACHE_H
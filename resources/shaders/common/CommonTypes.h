@@ -7,6 +7,13 @@
 
 #include "GLSLDefines.h"
 
+// Accumulation of the gradients of the splats in quad_interlock_bwd.fs, see Uniforms::gradient_accumulation
+const int GRADIENTS_FP16_PARTITIONED = 0; // summed over the fragments of a splat in the subgroup, then fp16 atomics
+const int GRADIENTS_FP16_ATOMIC = 1; // fp16 atomics for each fragment
+const int GRADIENTS_FP32_ATOMIC = 2; // fp32 atomics for each fragment
+const int GRADIENTS_FP32_PARTITIONED = 3; // summed over the fragments of a splat in the subgroup, then fp32 atomics
+const int GRADIENTS_MODES = 4;
+
 struct Uniforms{
     mat4 viewMat;
     mat4 projMat;
@@ -28,17 +35,57 @@ struct Uniforms{
     int antialiasing;
     int front_to_back;
 
+    int color_cache; // reuse the cached colors when > 0
+    float color_cache_min_cos; // cosine of the maximum angle between the cached and current view directions
+    int sh_lod; // select the degree of the spherical harmonics from the screen-space size of the gaussians when > 0
+    float point_decimation_distance; // distance beyond which the baked points are decimated, disabled when <= 0
+
+    float sh_lod_degree1_pixels; // minimum half extent of the oriented bounding box to use the degree 1
+    float sh_lod_degree2_pixels; // same for the degree 2
+    float sh_lod_degree3_pixels; // same for the degree 3
+    int tiled_blending; // count the tiles overlapped by the visible gaussians when > 0, see Tiles.h
+    int hybrid_blending; // draw the large splats as quads and the small ones with the tiles when > 0
+    float hybrid_max_area; // area in pixels of the largest oriented bounding box blended with the tiles
+    int depth_slices; // number of depth slices in which the tiles and the quads are interleaved
+    int early_termination; // skip the fragments of the saturated pixels when > 0
+    float termination_transmittance; // transmittance below which a pixel is saturated
+    int proxy_sides; // number of sides of the polygon drawn for each splat, see SplatProxy.h
+    int instanced_strips; // one instance of a triangle strip per splat when > 0, instead of a list of triangles
+    int stochastic_transparency; // depth tested quads with a hashed alpha test when > 0, see quad_stochastic.fs
+    int stochastic_frame; // number of frames accumulated since the last change of the view or of the settings
+    int foveation; // coarser pixels away from the gaze point when > 0, see Foveation.h
+    float gaze_x; // gaze point in the fbo, in pixels
+    float gaze_y;
+    float fovea_radius; // in pixels
+    float fovea_max_pixel_size; // size of the coarsest pixels in the periphery, a power of 2
+    float fovea_cull_size; // the gaussians whose bounding box is smaller than this many coarse pixels are culled
+    int gradient_accumulation; // GRADIENTS_*, the fp32 modes write to the *_fp32 buffers
+
     vec4* restrict positions;
     vec4* restrict rotations;
     vec4* restrict scales;
     float* restrict opacities;
+    uint* restrict baked_colors; // rgba8 view-averaged colors, with the opacity in alpha
     float* restrict sh_coeffs_red;
     float* restrict sh_coeffs_green;
     float* restrict sh_coeffs_blue;
+    vec4* restrict sh_coeffs_interleaved; // 16 coeffs * (r, g, b) per gaussian, see SphericalHarmonics.h
 
     float* restrict dLoss_dsh_coeffs_red;
     float* restrict dLoss_dsh_coeffs_green;
     float* restrict dLoss_dsh_coeffs_blue;
+    vec4* restrict dLoss_dpositions;
+    vec4* restrict dLoss_dscales;
+    vec4* restrict dLoss_drotations;
+    float* restrict dLoss_dopacities;
+
+    // moments of the Adam optimizer, (first moment, second moment) for each gaussian, see adamStep.cp
+    vec4* restrict moments_positions;
+    vec4* restrict moments_scales; // of log(scale)
+    vec4* restrict moments_rotations;
+    vec2* restrict moments_opacities; // of logit(opacity)
+    vec4* restrict moments_sh; // SH_INTERLEAVED_VEC4 first moments then SH_INTERLEAVED_VEC4 second moments, interleaved layout
+    vec2* restrict densification_stats; // vec2(sum of the norms of dLoss_dmean2D, number of views), see Densification.h
 
     int* restrict visible_gaussians_counter;
     float* restrict gaussians_depth;
@@ -52,11 +99,67 @@ struct Uniforms{
     vec2* restrict eigen_vecs; // principal direction of the 2D ellipsoid corresponding to the largest eigen value
     vec4* restrict predicted_colors;
 
+    // tiled rasterizer, see Tiles.h
+    int* restrict tiles_touched; // number of tiles overlapped by each visible gaussian
+    int* restrict tile_offsets; // inclusive prefix sum of tiles_touched
+    uint64_t* restrict tile_keys; // (tile index << 32) | index in the depth order, for every tile overlapped by a visible gaussian
+    uint64_t* restrict sorted_tile_keys;
+    ivec2* restrict tile_ranges; // [begin, end) of the keys of each tile in sorted_tile_keys, for each depth slice
+    int* restrict large_splats; // 1 if the visible gaussian is drawn as a quad in the hybrid mode
+    int* restrict large_splat_offsets; // inclusive prefix sum of large_splats
+    int* restrict large_splat_indices; // indices in the depth order of the large splats, packed
+    uvec4* restrict hybrid_draws; // DrawArraysIndirectCommand of the large splats of each depth slice
+
+    vec4* restrict color_cache_dirs; // vec4(direction the cached color was evaluated at, sh degree + 1), for all the gaussians
+    vec4* restrict color_cache_colors; // cached colors, for all the gaussians
+    int* restrict color_cache_hits; // number of visible gaussians whose color was read from the cache
+
     f16vec4* restrict dLoss_dconic_opacity;
     f16vec4* restrict dLoss_dpredicted_colors;
+    f16vec2* restrict dLoss_dmean2D; // derivative with respect to the center of the bounding box, in pixels
+    float* restrict dLoss_dconic_opacity_fp32; // same as dLoss_dconic_opacity, 4 floats per visible gaussian
+    float* restrict dLoss_dpredicted_colors_fp32; // same, 4 floats
+    float* restrict dLoss_dmean2D_fp32; // same, 2 floats
+    float* restrict loss; // sum of the squared errors of the last training view
 
     uint64_t ground_truth_image; // handle of the ground truth picture
     uint64_t accumulated_image_fwd;  // handle of the image used for alpha blending in the forward pass
 };
 
+// Uniform block of densifyMark.cp and densifyScatter.cp, the input attributes are read from the common uniforms.
+struct DensifyUniforms{
+    int num_gaussians; // before the densification
+    float grad_threshold; // mean norm of dLoss_dmean2D above which a gaussian is cloned or split
+    float split_scale; // largest scale above which a gaussian is split instead of cloned
+    float prune_opacity; // opacity below which a gaussian is removed
+
+    float prune_scale; // largest scale above which a gaussian is removed, disabled when <= 0
+    uint seed; // of the positions of the split gaussians
+    int padding0;
+    int padding1;
+
+    int* restrict kinds; // DENSIFY_* for each gaussian
+    int* restrict counts; // number of gaussians written to the output for each gaussian: 0, 1 or 2
+    int* restrict offsets; // inclusive prefix sum of counts
+    int* restrict kind_counters; // number of gaussians of each kind
+
+    // output attributes, same layout as the buffers of Uniforms
+    vec4* restrict positions;
+    vec4* restrict rotations;
+    vec4* restrict scales;
+    float* restrict opacities;
+    uint* restrict baked_colors;
+    float* restrict sh_coeffs_red;
+    float* restrict sh_coeffs_green;
+    float* restrict sh_coeffs_blue;
+    vec4* restrict sh_coeffs_interleaved;
+
+    // output moments of the Adam optimizer
+    vec4* restrict moments_positions;
+    vec4* restrict moments_scales;
+    vec4* restrict moments_rotations;
+    vec2* restrict moments_opacities;
+    vec4* restrict moments_sh;
+};
+
 #endif //COMMONTYPES_H
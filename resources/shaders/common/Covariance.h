@@ -29,7 +29,9 @@ float mat3_sum(const mat3 m){
     m[2][0] + m[2][1] + m[2][2];
 }
 
-void quat2mat_bwd(const vec4 q, const mat3 dLoss_dR, ___out vec4 dLoss_dq){
+// The backward functions return their derivatives instead of writing to out parameters:
+// ___out is empty in c++, so that the functions can be checked on the cpu (see CovarianceGradCheck.cpp).
+vec4 quat2mat_bwd(const vec4 q, const mat3 dLoss_dR){
     const float r = q.x;
     const float x = q.y;
     const float y = q.z;
@@ -52,13 +54,14 @@ void quat2mat_bwd(const vec4 q, const mat3 dLoss_dR, ___out vec4 dLoss_dq){
             -r, -2.0f*z, y,
             x, y, 0.0f));
 
+    vec4 dLoss_dq;
     dLoss_dq.x = 2.0f * mat3_sum(matrixCompMult(dLoss_dR, dR_dr));
     dLoss_dq.y = 2.0f * mat3_sum(matrixCompMult(dLoss_dR, dR_dx));
     dLoss_dq.z = 2.0f * mat3_sum(matrixCompMult(dLoss_dR, dR_dy));
     dLoss_dq.w = 2.0f * mat3_sum(matrixCompMult(dLoss_dR, dR_dz));
 
     // normalize jacobian, assuming length(q) == 1.
-    dLoss_dq = dLoss_dq - dot(q, dLoss_dq) * q;
+    return dLoss_dq - dot(q, dLoss_dq) * q;
 }
 
 mat3 computeCov3D(const vec3 scale, float mod, const vec4 q, const mat3 viewMat) {
@@ -73,9 +76,14 @@ mat3 computeCov3D(const vec3 scale, float mod, const vec4 q, const mat3 viewMat)
     return Sigma;
 }
 
+struct Cov3DGradients{
+    vec3 dLoss_dscale;
+    vec4 dLoss_drot;
+};
 
-void computeCov3D_bwd(const vec3 scale, const vec4 q, const mat3 viewMat,
-                      const float dLoss_dcov3D[6], ___out vec3 dLoss_dscale, ___out vec4 dLoss_drot) {
+// Backward of computeCov3D with mod = 1, dLoss_dcov3D holds the derivatives with respect to
+// the values [0][0], [0][1], [0][2], [1][1], [1][2] and [2][2] of cov3D.
+Cov3DGradients computeCov3D_bwd(const vec3 scale, const vec4 q, const mat3 viewMat, const float dLoss_dcov3D[6]) {
     mat3 S = mat3(1.0f);
     S[0][0] = scale.x;
     S[1][1] = scale.y;
@@ -85,7 +93,6 @@ void computeCov3D_bwd(const vec3 scale, const vec4 q, const mat3 viewMat,
 
     const mat3 Q = viewMat * transpose(R);
     const mat3 M = Q * S;
-    const mat3 Sigma = M * transpose(M);
 
     const float a = Q[0][0];
     const float b = Q[1][0];
@@ -97,7 +104,8 @@ void computeCov3D_bwd(const vec3 scale, const vec4 q, const mat3 viewMat,
     const float h = Q[1][2];
     const float i = Q[2][2];
 
-    dLoss_dscale =
+    Cov3DGradients grad;
+    grad.dLoss_dscale =
             2.0f * scale * (
         dLoss_dcov3D[0] * vec3(a*a, b*b, c*c) +
         dLoss_dcov3D[1] * vec3(a*d, e*b, c*f) +
@@ -106,12 +114,20 @@ void computeCov3D_bwd(const vec3 scale, const vec4 q, const mat3 viewMat,
         dLoss_dcov3D[4] * vec3(g*d, h*e, i*f) +
         dLoss_dcov3D[5] * vec3(g*g, h*h, i*i));
 
-    const mat3 MS = M*S;
-
-    mat3 dLoss_dR;
+    // dLoss_dcov3D holds the derivatives with respect to the 6 unique values of the symmetric matrix,
+    // each off-diagonal value appears twice in the full matrix.
+    const mat3 dLoss_dSigma = mat3(
+            dLoss_dcov3D[0], 0.5f * dLoss_dcov3D[1], 0.5f * dLoss_dcov3D[2],
+            0.5f * dLoss_dcov3D[1], dLoss_dcov3D[3], 0.5f * dLoss_dcov3D[4],
+            0.5f * dLoss_dcov3D[2], 0.5f * dLoss_dcov3D[4], dLoss_dcov3D[5]);
 
-    quat2mat_bwd(q, dLoss_dR, dLoss_drot);
+    // Sigma = Q * S * S * transpose(Q), with Q = viewMat * transpose(R)
+    const mat3 MS = M*S;
+    const mat3 dLoss_dQ = 2.0f * dLoss_dSigma * MS;
+    const mat3 dLoss_dR = transpose(dLoss_dQ) * viewMat;
 
+    grad.dLoss_drot = quat2mat_bwd(q, dLoss_dR);
+    return grad;
 }
 
 vec2 computeAABB(const vec3 conic, const float opacity, const float min_alpha) {
@@ -134,11 +150,13 @@ vec2 computeAABB(const vec3 conic, const float opacity, const float min_alpha) {
     return ceil(vec2(dx, dy));
 }
 
-vec2 computeOBB(const vec3 conic, const float opacity, const float min_alpha, ___inout vec2 eigen_vec) {
-    if(opacity < min_alpha){
-        return vec2(0);
-    }
+struct OBB{
+    vec2 half_extent; // along eigen_vec and along its perpendicular, in pixels
+    vec2 eigen_vec; // major axis of the ellipse
+};
 
+// Returned by value like the backward functions, the direction is computed even when the box is empty.
+OBB computeOBB(const vec3 conic, const float opacity, const float min_alpha) {
     const float a = conic.x;
     const float b = conic.y;
     const float c = conic.z;
@@ -146,17 +164,25 @@ vec2 computeOBB(const vec3 conic, const float opacity, const float min_alpha, __
     const float half_tr = (a+c) * 0.5f;
     const float det = a*c - b*b;
 
-    const float delta = sqrt(half_tr*half_tr - det);
+    // clamped, rounding makes the discriminant slightly negative for nearly isotropic gaussians
+    const float delta = sqrt(max(half_tr*half_tr - det, 0.0f));
     const float lambda1 = half_tr + delta;
     const float lambda2 = half_tr - delta;
 
-    eigen_vec = normalize(vec2(-b, a - lambda1));
+    OBB obb;
+    obb.eigen_vec = normalize(vec2(-b, a - lambda1));
+    obb.half_extent = vec2(0);
+    if(opacity < min_alpha){
+        return obb;
+    }
+
     const float e = -2.0f * log(min_alpha / opacity);
 
     const float dx = sqrt(e / lambda1);
     const float dy = sqrt(e / lambda2);
 
-    return vec2(dx, dy);
+    obb.half_extent = vec2(dx, dy);
+    return obb;
 }
 
 vec3 computeCov2D(const vec3 mean, float focal_x, float focal_y, const mat3 cov3D) {
@@ -196,10 +222,17 @@ vec3 computeCov2D_simple2(const vec3 mean, float focal, const mat3 cov3D) {
     return vec3( u, v, w) * (h*h);
 }
 
-void computeCov2D_bwd(const vec3 mean, float focal, const mat3 cov3D,
-                      const vec3 dLoss_dcov2d, ___out vec3 dLoss_dmean, ___out mat3 dLoss_dcov3D) {
+struct Cov2DGradients{
+    vec3 dLoss_dmean;
+    mat3 dLoss_dcov3D;
+};
+
+// Backward of computeCov2D, dLoss_dcov2d is the derivative with respect to vec3(cov[0][0], cov[0][1], cov[1][1]).
+// The off-diagonal values of dLoss_dcov3D are the derivatives with respect to a single value of the symmetric matrix.
+Cov2DGradients computeCov2D_bwd(const vec3 mean, float focal_x, float focal_y, const mat3 cov3D, const vec3 dLoss_dcov2d) {
     const float invz = 1.0f / mean.z;
-    const float h = focal * invz;
+    const float hx = focal_x * invz;
+    const float hy = focal_y * invz;
 
     const float x = -mean.x * invz;
     const float y = -mean.y * invz;
@@ -215,16 +248,17 @@ void computeCov2D_bwd(const vec3 mean, float focal, const mat3 cov3D,
     const float v = b + x * e + y * c + x * y * f;
     const float w = d + 2.0f * y * e  + y * y * f;
 
-    const vec3 cov2D = vec3( u, v, w) * (h*h);
-
-    const float dLoss_dh = dot(dLoss_dcov2d, vec3( u, v, w)) * h * 2.0f;
-    const vec3 dLoss_duvw = dLoss_dcov2d * (h*h);
+    // cov2D = vec3(hx * hx * u, hx * hy * v, hy * hy * w)
+    const float dLoss_dhx = dLoss_dcov2d.x * u * hx * 2.0f + dLoss_dcov2d.y * v * hy;
+    const float dLoss_dhy = dLoss_dcov2d.y * v * hx + dLoss_dcov2d.z * w * hy * 2.0f;
+    const vec3 dLoss_duvw = dLoss_dcov2d * vec3(hx * hx, hx * hy, hy * hy);
 
     const float dLoss_dx = dLoss_duvw.x * (c + x*f) * 2.0f + dLoss_duvw.y * (e + y*f);
     const float dLoss_dy = dLoss_duvw.y * (c + x*f)        + dLoss_duvw.z * (e + y*f) * 2.0f;
 
-    const float dLoss_dinvz = dLoss_dx * -mean.x + dLoss_dy * -mean.y + dLoss_dh * focal;
-    dLoss_dmean = vec3(dLoss_dx, dLoss_dy, dLoss_dinvz * invz) * -invz;
+    const float dLoss_dinvz = dLoss_dx * -mean.x + dLoss_dy * -mean.y + dLoss_dhx * focal_x + dLoss_dhy * focal_y;
+    Cov2DGradients grad;
+    grad.dLoss_dmean = vec3(dLoss_dx, dLoss_dy, dLoss_dinvz * invz) * -invz;
 
     const float dLoss_da = dLoss_duvw.x;
     const float dLoss_db = dLoss_duvw.y;
@@ -233,10 +267,10 @@ void computeCov2D_bwd(const vec3 mean, float focal, const mat3 cov3D,
     const float dLoss_de = dLoss_duvw.y * x + dLoss_duvw.z * y * 2.0f;
     const float dLoss_df = dot(dLoss_duvw, vec3(x*x, x*y, y*y));
 
-    dLoss_dcov3D = mat3(dLoss_da, dLoss_db, dLoss_dc,
-                        dLoss_db, dLoss_dd, dLoss_de,
-                        dLoss_dc, dLoss_de, dLoss_df);
-
+    grad.dLoss_dcov3D = mat3(dLoss_da, dLoss_db, dLoss_dc,
+                             dLoss_db, dLoss_dd, dLoss_de,
+                             dLoss_dc, dLoss_de, dLoss_df);
+    return grad;
 }
 
 //
@@ -0,0 +1,66 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_DENSIFICATION_H
+#define HARDWARERASTERIZED3DGS_DENSIFICATION_H
+
+#include "CommonTypes.h"
+
+// What happens to a gaussian during the densification
+const int DENSIFY_PRUNE = 0; // removed
+const int DENSIFY_KEEP = 1;
+const int DENSIFY_CLONE = 2; // kept, followed by a copy with empty moments
+const int DENSIFY_SPLIT = 3; // replaced by two smaller gaussians with empty moments
+const int DENSIFY_KINDS = 4;
+
+// Scale of the two gaussians replacing a split gaussian, same as 3DGS
+const float SPLIT_SCALE_DIVIDER = 1.6f;
+
+int getDensifyKind(const vec3 scale, const float opacity, const vec2 grad_stats, const float grad_threshold,
+                   const float split_scale, const float prune_opacity, const float prune_scale){
+    const float max_scale = max(scale.x, max(scale.y, scale.z));
+    if(opacity < prune_opacity || (prune_scale > 0.0f && max_scale > prune_scale)){
+        return DENSIFY_PRUNE;
+    }
+    // grad_stats = vec2(sum of the norms of dLoss_dmean2D, number of views where the gaussian was visible)
+    if(grad_stats.y > 0.0f && grad_stats.x >= grad_threshold * grad_stats.y){
+        return max_scale > split_scale ? DENSIFY_SPLIT : DENSIFY_CLONE;
+    }
+    return DENSIFY_KEEP;
+}
+
+int getDensifyCount(const int kind){
+    return kind == DENSIFY_PRUNE ? 0 : kind == DENSIFY_KEEP ? 1 : 2;
+}
+
+uint densifyHash(uint n){
+    n ^= n >> 16;
+    n *= 0x7feb352dU;
+    n ^= n >> 15;
+    n *= 0x846ca68bU;
+    n ^= n >> 16;
+    return n;
+}
+
+// Offset of the center of the child (0 or 1) of a split gaussian, sampled from the gaussian itself,
+// in the frame of the gaussian. The offset in world space is transpose(quat2mat(rotation)) * offset, see computeCov3D.
+vec3 getSplitOffset(const int GaussianID, const int child, const uint seed, const vec3 scale){
+    const uint h = densifyHash(uint(GaussianID * 2 + child) ^ densifyHash(seed));
+    const uint h1 = densifyHash(h);
+    const uint h2 = densifyHash(h1);
+    const uint h3 = densifyHash(h2);
+
+    // Box-Muller transform of 4 uniform numbers, u0 and u2 in (0, 1] for the logarithms
+    const float u0 = float((h >> 8) + 1u) * (1.0f / 16777216.0f);
+    const float u1 = float(h1 >> 8) * (1.0f / 16777216.0f);
+    const float u2 = float((h2 >> 8) + 1u) * (1.0f / 16777216.0f);
+    const float u3 = float(h3 >> 8) * (1.0f / 16777216.0f);
+    const float r0 = sqrt(-2.0f * log(u0));
+    const float r1 = sqrt(-2.0f * log(u2));
+    const float two_pi = 6.28318530718f;
+    const vec3 n = vec3(r0 * cos(two_pi * u1), r0 * sin(two_pi * u1), r1 * cos(two_pi * u3));
+    return scale * n;
+}
+
+#endif //HARDWARERASTERIZED3DGS_DENSIFICATION_H
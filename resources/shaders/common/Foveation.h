@@ -0,0 +1,30 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_FOVEATION_H
+#define HARDWARERASTERIZED3DGS_FOVEATION_H
+
+#include "Uniforms.h"
+
+// With the foveation, the fbo is shaded at full resolution within fovea_radius pixels of the gaze point,
+// and with coarser pixels further away: 2x2 pixels up to twice the radius, 4x4 pixels beyond, and so on
+// up to fovea_max_pixel_size.
+
+/**
+ * Size in pixels of the coarse pixels at the given position in the fbo, a power of 2, 1 without the foveation.
+ */
+float getFoveationPixelSize(const vec2 pixel){
+    if(uniforms.foveation == 0){
+        return 1.0f;
+    }
+    const float d = length(pixel - vec2(uniforms.gaze_x, uniforms.gaze_y)) / uniforms.fovea_radius;
+    return min(exp2(floor(d)), uniforms.fovea_max_pixel_size);
+}
+
+// Index in the palette of shading rates of GaussianCloud: 0 for 1x1 pixels, 1 for 2x2 and 2 for 4x4.
+uint getFoveationRateIndex(const vec2 pixel){
+    return uint(log2(getFoveationPixelSize(pixel)) + 0.5f);
+}
+
+#endif //HARDWARERASTERIZED3DGS_FOVEATION_H
@@ -145,6 +145,8 @@ f16vec2 unpackFloat2x16(uint32_t v);
 #define rgba8
 #define rgba16f
 #define rgba32f
+#define r16f
+#define r8ui
 #define uniform
 #define readonly
 #define writeonly
@@ -160,6 +162,7 @@ f16vec2 unpackFloat2x16(uint32_t v);
 
 static const uint gl_VertexID = 0;
 static const uint gl_InstanceID = 0;
+static const uint gl_BaseInstance = 0;
 static const uint gl_NumSubgroups = 0;
 static const uint gl_SubgroupSize = 0;
 static const uint gl_SubgroupID = 0;
@@ -449,10 +452,12 @@ ivec2 subgroupBroadcast(ivec2 value, int id);
 uvec4 subgroupBallot(bool);
 uint subgroupBallotExclusiveBitCount(uvec4);
 uint subgroupBallotInclusiveBitCount(uvec4);
+uint subgroupBallotBitCount(uvec4);
 uint subgroupBallotFindLSB(uvec4);
 uvec4 subgroupPartitionNV(int);
 vec3 subgroupPartitionedMinNV(vec3, uvec4);
 vec3 subgroupPartitionedMaxNV(vec3, uvec4);
+vec2 subgroupPartitionedAddNV(vec2, uvec4);
 vec3 subgroupPartitionedAddNV(vec3, uvec4);
 vec4 subgroupPartitionedAddNV(vec4, uvec4);
 
@@ -467,6 +472,7 @@ int subgroupClusteredOr(int, int);
 int subgroupClusteredAnd(int, int);
 
 int subgroupAdd(int v);
+float subgroupAdd(float v);
 vec2 subgroupAdd(vec2 v);
 vec3 subgroupAdd(vec3 v);
 vec4 subgroupAdd(vec4 v);
@@ -0,0 +1,103 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_SPHERICALHARMONICS_H
+#define HARDWARERASTERIZED3DGS_SPHERICALHARMONICS_H
+
+#include "GLSLDefines.h"
+
+// Spherical harmonics coefficients
+const float SH_C0 = 0.28209479177387814f;
+const float SH_C1 = 0.4886025119029199f;
+const float SH_C2[] = {
+        1.0925484305920792f,
+        -1.0925484305920792f,
+        0.31539156525252005f,
+        -1.0925484305920792f,
+        0.5462742152960396f
+};
+const float SH_C3[] = {
+        -0.5900435899266435f,
+        2.890611442640554f,
+        -0.4570457994644658f,
+        0.3731763325901154f,
+        -0.4570457994644658f,
+        1.445305721320277f,
+        -0.5900435899266435f
+};
+
+// Number of vec4 per gaussian in the interleaved layout: 16 coefficients * (r, g, b) = 48 floats.
+const int SH_INTERLEAVED_VEC4 = 12;
+
+/**
+ * Selects the degree of the spherical harmonics from the screen-space footprint of a gaussian,
+ * given as the largest half extent of its oriented bounding box, in pixels.
+ * thresholds contains the minimum footprint for degrees 1, 2 and 3.
+ */
+int selectSHDegree(const float footprint, const vec3 thresholds){
+    if(footprint >= thresholds.z) return 3;
+    if(footprint >= thresholds.y) return 2;
+    if(footprint >= thresholds.x) return 1;
+    return 0;
+}
+
+/**
+ * Evaluates the spherical harmonics of a single gaussian in the direction dir, up to the given degree.
+ * coeffs points to the 12 vec4 of the gaussian in the interleaved layout:
+ * c0.rgb c1.r | c1.gb c2.rg | c2.b c3.rgb | c4.rgb c5.r | ...
+ * so that every group of 4 coefficients is fetched with 3 aligned 128 bits loads,
+ * and only the vec4 holding the coefficients of the requested degrees are read.
+ */
+vec3 evalSphericalHarmonics(const vec4* coeffs, const vec3 dir, const int degree){
+    const float x = dir.x;
+    const float y = dir.y;
+    const float z = dir.z;
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, yz = y * z, xz = x * z;
+
+    const vec4 v0 = coeffs[0];
+    vec3 result = SH_C0 * vec3(v0.x, v0.y, v0.z);
+
+    if(degree > 0){
+        const vec4 v1 = coeffs[1];
+        const vec4 v2 = coeffs[2];
+
+        result += - SH_C1 * y * vec3(v0.w, v1.x, v1.y);
+        result += SH_C1 * z * vec3(v1.z, v1.w, v2.x);
+        result += - SH_C1 * x * vec3(v2.y, v2.z, v2.w);
+
+        if(degree > 1){
+            const vec4 v3 = coeffs[3];
+            const vec4 v4 = coeffs[4];
+            const vec4 v5 = coeffs[5];
+            const vec4 v6 = coeffs[6];
+
+            result += SH_C2[0] * xy * vec3(v3.x, v3.y, v3.z);
+            result += SH_C2[1] * yz * vec3(v3.w, v4.x, v4.y);
+            result += SH_C2[2] * (2.0f * zz - xx - yy) * vec3(v4.z, v4.w, v5.x);
+            result += SH_C2[3] * xz * vec3(v5.y, v5.z, v5.w);
+            result += SH_C2[4] * (xx - yy) * vec3(v6.x, v6.y, v6.z);
+
+            if(degree > 2){
+                const vec4 v7 = coeffs[7];
+                const vec4 v8 = coeffs[8];
+                const vec4 v9 = coeffs[9];
+                const vec4 v10 = coeffs[10];
+                const vec4 v11 = coeffs[11];
+
+                result += SH_C3[0] * y * (3.0f * xx - yy) * vec3(v6.w, v7.x, v7.y);
+                result += SH_C3[1] * xy * z * vec3(v7.z, v7.w, v8.x);
+                result += SH_C3[2] * y * (4.0f * zz - xx - yy) * vec3(v8.y, v8.z, v8.w);
+                result += SH_C3[3] * z * (2.0f * zz - 3.0f * xx - 3.0f * yy) * vec3(v9.x, v9.y, v9.z);
+                result += SH_C3[4] * x * (4.0f * zz - xx - yy) * vec3(v9.w, v10.x, v10.y);
+                result += SH_C3[5] * z * (xx - yy) * vec3(v10.z, v10.w, v11.x);
+                result += SH_C3[6] * x * (xx - 3.0f * yy) * vec3(v11.y, v11.z, v11.w);
+            }
+        }
+    }
+
+    return max(0.5f + result, 0.0f);
+}
+
+#endif //HARDWARERASTERIZED3DGS_SPHERICALHARMONICS_H
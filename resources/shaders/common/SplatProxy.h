@@ -0,0 +1,48 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_SPLATPROXY_H
+#define HARDWARERASTERIZED3DGS_SPLATPROXY_H
+
+#include "Uniforms.h"
+
+// Each splat is drawn as a regular polygon circumscribed to the unit circle, stretched along the axes of the
+// oriented bounding box. It is then circumscribed to the ellipse where the opacity reaches min_opacity.
+// The fraction of the polygon outside of the ellipse is 1 - pi / (N * tan(pi / N)):
+// 21.5% for the quad (N = 4), 9.3% for the hexagon and 5.2% for the octagon.
+
+const int MAX_PROXY_SIDES = 8;
+
+// Drawn with GL_TRIANGLES, the polygon is a fan of N - 2 triangles
+int getProxyVertices(const int sides){
+    return 3 * (sides - 2);
+}
+
+// Index of the corner of the polygon for the vertex in [0, getProxyVertices(sides)) of the fan
+int getFanCorner(const int vertex){
+    const int triangle = vertex / 3;
+    const int c = vertex % 3;
+    return c == 0 ? 0 : triangle + c;
+}
+
+// Drawn with an instanced GL_TRIANGLE_STRIP of N vertices, the corners alternate on both sides: 0, 1, N-1, 2, N-2, ...
+int getStripCorner(const int vertex, const int sides){
+    if(vertex == 0){
+        return 0;
+    }
+    return vertex % 2 == 1 ? (vertex + 1) / 2 : sides - vertex / 2;
+}
+
+/**
+ * Corner k of the polygon, in units of the half extents of the oriented bounding box.
+ * With 4 sides, the corners are (+-1, +-1).
+ */
+vec2 getProxyCorner(const int k, const int sides){
+    const float PI = 3.14159265358979f;
+    const float angle = float(2 * k + 1) * PI / float(sides);
+    const float radius = 1.0f / cos(PI / float(sides));
+    return radius * vec2(cos(angle), sin(angle));
+}
+
+#endif //HARDWARERASTERIZED3DGS_SPLATPROXY_H
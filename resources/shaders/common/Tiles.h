@@ -0,0 +1,56 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_TILES_H
+#define HARDWARERASTERIZED3DGS_TILES_H
+
+#include "GLSLDefines.h"
+
+// Size in pixels of the screen tiles of the tiled rasterizer, one workgroup of TILE_SIZE x TILE_SIZE threads per tile.
+const int TILE_SIZE = 16;
+
+// Below this transmittance, the remaining gaussians change the pixel by less than one step of an 8 bits color.
+const float MIN_TRANSMITTANCE = 1.0f / 255.0f;
+
+/**
+ * Tiles overlapped by the oriented bounding box of a gaussian, as ivec4(first tile, last tile + 1).
+ * Only the tiles containing the center of a pixel inside the axis aligned extent of the box are kept.
+ * The range is empty when the box is not finite or outside of the screen.
+ */
+ivec4 getTileRect(const vec4 bounding_box, const vec2 eigen_vec, const int width, const int height){
+    const vec2 center = vec2(bounding_box.x, bounding_box.y);
+    const vec2 h = vec2(bounding_box.z, bounding_box.w);
+    const vec2 d = abs(eigen_vec);
+    if(isnan(h.x) || isnan(h.y) || isnan(d.x) || isnan(d.y) || isinf(h.x) || isinf(h.y)){
+        return ivec4(0);
+    }
+
+    // axis aligned extent of the oriented bounding box
+    const vec2 extent = vec2(d.x * h.x + d.y * h.y, d.y * h.x + d.x * h.y);
+
+    // range of pixels whose center is inside the box
+    const ivec2 minPixel = max(ivec2(ceil(center - extent - 0.5f)), ivec2(0));
+    const ivec2 maxPixel = min(ivec2(floor(center + extent - 0.5f)), ivec2(width - 1, height - 1));
+    if(minPixel.x > maxPixel.x || minPixel.y > maxPixel.y){
+        return ivec4(0);
+    }
+
+    return ivec4(minPixel / TILE_SIZE, maxPixel / TILE_SIZE + 1);
+}
+
+// In the hybrid mode, the visible gaussians are split in slices of consecutive indices in the depth order.
+// The small splats of a slice are blended with the tiles, then its large splats are drawn as quads,
+// so the order is only approximate inside of a slice.
+const int MAX_DEPTH_SLICES = 32;
+
+int getDepthSlice(const int n, const int num_visible, const int slices){
+    return int((int64_t(n) * int64_t(slices)) / int64_t(num_visible));
+}
+
+// First index in the depth order of the slice, num_visible when slice == slices
+int getDepthSliceBegin(const int slice, const int num_visible, const int slices){
+    return int((int64_t(slice) * int64_t(num_visible) + int64_t(slices - 1)) / int64_t(slices));
+}
+
+#endif //HARDWARERASTERIZED3DGS_TILES_H
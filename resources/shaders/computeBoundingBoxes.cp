@@ -11,6 +11,7 @@
 #include "./common/GLSLDefines.h"
 #include "./common/Uniforms.h"
 #include "./common/Covariance.h"
+#include "./common/Tiles.h"
 
 void main(void){
     const int n = int(gl_GlobalInvocationID.x);
@@ -47,14 +48,26 @@ void main(void){
     const float det_cov_plus_h_cov = cov.x * cov.z - cov.y * cov.y;
     const float det = det_cov_plus_h_cov;
 
-    if (det == 0.0f)
+    if (det == 0.0f){
+        // an empty box, the other passes read the box of every visible gaussian
+        uniforms.bounding_boxes[n] = vec4(0.0f);
+        uniforms.conic_opacity[n] = vec4(0.0f);
+        uniforms.eigen_vecs[n] = vec2(1.0f, 0.0f);
+        if(uniforms.tiled_blending > 0){
+            uniforms.tiles_touched[n] = 0;
+        }
+        if(uniforms.hybrid_blending > 0){
+            uniforms.large_splats[n] = 0;
+        }
         return;
+    }
 
     const float det_inv = 1.0f / det;
     const vec3 conic = vec3( cov.z * det_inv, -cov.y * det_inv, cov.x * det_inv );
 
-    vec2 eigen_vec = vec2(1.0f, 0.0f);
-    const vec2 bbox_pixels = computeOBB(conic, opacity, uniforms.min_opacity, eigen_vec);
+    const OBB obb = computeOBB(conic, opacity, uniforms.min_opacity);
+    const vec2 bbox_pixels = obb.half_extent;
+    const vec2 eigen_vec = obb.eigen_vec;
 
     const vec2 proj_pixels = vec2(ndc * 0.5f + 0.5f) * vec2(width, height);
     const vec4 bounding_box = vec4(proj_pixels, bbox_pixels);
@@ -64,4 +77,18 @@ void main(void){
     uniforms.conic_opacity[n] = conic_opacity;
     uniforms.eigen_vecs[n] = eigen_vec;
 
+    if(uniforms.tiled_blending > 0){
+        const ivec4 rect = getTileRect(bounding_box, eigen_vec, int(width), int(height));
+        int touched = (rect.z - rect.x) * (rect.w - rect.y);
+        if(uniforms.hybrid_blending > 0){
+            // the large splats are drawn as quads instead
+            const bool large = 4.0f * bbox_pixels.x * bbox_pixels.y > uniforms.hybrid_max_area;
+            uniforms.large_splats[n] = int(large);
+            if(large){
+                touched = 0;
+            }
+        }
+        uniforms.tiles_touched[n] = touched;
+    }
+
 }
\ No newline at end of file
@@ -19,7 +19,10 @@ void main(void){
 
     const int GaussianID = uniforms.sorted_gaussian_indices[n];
 
-    const vec4 dLoss_dconic_opacity = vec4(uniforms.dLoss_dconic_opacity[n]);
+    const bool fp32 = uniforms.gradient_accumulation == GRADIENTS_FP32_ATOMIC || uniforms.gradient_accumulation == GRADIENTS_FP32_PARTITIONED;
+    const vec4 dLoss_dconic_opacity = fp32 ? vec4(uniforms.dLoss_dconic_opacity_fp32[n * 4 + 0], uniforms.dLoss_dconic_opacity_fp32[n * 4 + 1],
+                                                  uniforms.dLoss_dconic_opacity_fp32[n * 4 + 2], uniforms.dLoss_dconic_opacity_fp32[n * 4 + 3])
+                                           : vec4(uniforms.dLoss_dconic_opacity[n]);
 
     const float opacity = uniforms.opacities[GaussianID];
     const vec3 mean_world_space = vec3(uniforms.positions[GaussianID]);
@@ -55,6 +58,42 @@ void main(void){
 
     const vec3 dLoss_dconic = vec3(dLoss_dconic_opacity);
     const float dLoss_ddet_inv = dot(dLoss_dconic, vec3(cov.z, -cov.y, cov.x));
-
+    const float dLoss_ddet = -dLoss_ddet_inv * det_inv * det_inv;
+
+    // the low-pass filter h_var doesn't change the derivatives with respect to cov
+    const vec3 dLoss_dcov = vec3(
+            dLoss_dconic.z * det_inv + dLoss_ddet * cov.z,
+            -dLoss_dconic.y * det_inv - dLoss_ddet * 2.0f * cov.y,
+            dLoss_dconic.x * det_inv + dLoss_ddet * cov.x);
+
+    const Cov2DGradients cov2D_grad = computeCov2D_bwd(mean, focal_x, focal_y, cov3D, dLoss_dcov);
+    vec3 dLoss_dmean = cov2D_grad.dLoss_dmean;
+    const mat3 dLoss_dcov3D = cov2D_grad.dLoss_dcov3D;
+
+    const float dLoss_dcov3D_values[6] = {
+            dLoss_dcov3D[0][0], dLoss_dcov3D[0][1], dLoss_dcov3D[0][2],
+            dLoss_dcov3D[1][1], dLoss_dcov3D[1][2], dLoss_dcov3D[2][2]
+    };
+    const Cov3DGradients cov3D_grad = computeCov3D_bwd(scale, quaternion, mat3(uniforms.viewMat), dLoss_dcov3D_values);
+
+    // center of the bounding box: (ndc * 0.5 + 0.5) * (width, height)
+    const vec2 dLoss_dmean2D = fp32 ? vec2(uniforms.dLoss_dmean2D_fp32[n * 2 + 0], uniforms.dLoss_dmean2D_fp32[n * 2 + 1])
+                                    : vec2(uniforms.dLoss_dmean2D[n]);
+    const vec2 dLoss_dndc = dLoss_dmean2D * 0.5f * vec2(width, height);
+    const float w_inv = 1.0f / p_hom.w;
+    const vec4 dLoss_dp_hom = vec4(dLoss_dndc * w_inv, 0.0f, -dot(dLoss_dndc, ndc) * w_inv);
+    dLoss_dmean += vec3(transpose(uniforms.projMat) * dLoss_dp_hom);
+
+    // back to world space
+    const vec3 dLoss_dmean_world_space = transpose(mat3(uniforms.viewMat)) * dLoss_dmean;
+
+    // A gaussian is visible at most once per view, the gradients of several views add up.
+    uniforms.dLoss_dpositions[GaussianID] += vec4(dLoss_dmean_world_space, 0.0f);
+    uniforms.dLoss_dscales[GaussianID] += vec4(cov3D_grad.dLoss_dscale, 0.0f);
+    uniforms.dLoss_drotations[GaussianID] += cov3D_grad.dLoss_drot;
+    uniforms.dLoss_dopacities[GaussianID] += dLoss_dconic_opacity.w;
+
+    // the gaussians that keep moving on the screen are densified, kept until the next densification
+    uniforms.densification_stats[GaussianID] += vec2(length(dLoss_dmean2D), 1.0f);
 
 }
\ No newline at end of file
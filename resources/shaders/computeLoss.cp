@@ -0,0 +1,28 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+//-- #extension GL_KHR_shader_subgroup_arithmetic : enable
+//-- #extension GL_NV_shader_atomic_float : enable
+
+/*-- layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+
+// Training loss of the forward pass, same as quad_interlock_bwd.fs: sum of the squared errors over the pixels.
+void main(void){
+    const ivec2 uv = ivec2(gl_GlobalInvocationID.xy);
+    float error = 0.0f;
+    if(uv.x < int(uniforms.width) && uv.y < int(uniforms.height)){
+        const vec3 finalColor = vec3(imageLoad(/*--layout(rgba16f) restrict --*/ image2D(uniforms.accumulated_image_fwd), uv));
+        const vec3 gtColor = vec3(imageLoad(/*--layout(rgba8) restrict --*/ image2D(uniforms.ground_truth_image), uv));
+        error = dot(finalColor - gtColor, finalColor - gtColor);
+    }
+
+    error = subgroupAdd(error);
+    if(subgroupElect()){
+        atomicAdd(uniforms.loss, error);
+    }
+}
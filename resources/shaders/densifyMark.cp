@@ -0,0 +1,31 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+/*-- layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+#include "./common/Densification.h"
+
+//-- layout(std140, binding = 1) uniform DensifyUniformsBlock
+//-- {
+DensifyUniforms densify;
+//-- };
+
+// Decides what happens to each gaussian during the densification, one thread per gaussian.
+// The inclusive prefix sum of the counts gives the position of the gaussians in the output, see densifyScatter.cp.
+void main(void){
+    const int GaussianID = int(gl_GlobalInvocationID.x);
+    if(GaussianID >= densify.num_gaussians)
+        return;
+
+    const int kind = getDensifyKind(vec3(uniforms.scales[GaussianID]), uniforms.opacities[GaussianID],
+                                    uniforms.densification_stats[GaussianID], densify.grad_threshold,
+                                    densify.split_scale, densify.prune_opacity, densify.prune_scale);
+    densify.kinds[GaussianID] = kind;
+    densify.counts[GaussianID] = getDensifyCount(kind);
+    atomicAdd(densify.kind_counters[kind], 1);
+}
@@ -0,0 +1,76 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+/*-- layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+#include "./common/SphericalHarmonics.h"
+#include "./common/Covariance.h"
+#include "./common/Densification.h"
+
+//-- layout(std140, binding = 1) uniform DensifyUniformsBlock
+//-- {
+DensifyUniforms densify;
+//-- };
+
+// Copies the gaussian src to the slot dst of the output, with a new position and scale.
+// The moments of the new gaussians start at 0.
+void writeGaussian(const int src, const int dst, const vec4 position, const vec4 scale, const bool keep_moments){
+    densify.positions[dst] = position;
+    densify.scales[dst] = scale;
+    densify.rotations[dst] = uniforms.rotations[src];
+    densify.opacities[dst] = uniforms.opacities[src];
+    densify.baked_colors[dst] = uniforms.baked_colors[src];
+
+    for(int k=0; k<16; k++){
+        densify.sh_coeffs_red[dst * 16 + k] = uniforms.sh_coeffs_red[src * 16 + k];
+        densify.sh_coeffs_green[dst * 16 + k] = uniforms.sh_coeffs_green[src * 16 + k];
+        densify.sh_coeffs_blue[dst * 16 + k] = uniforms.sh_coeffs_blue[src * 16 + k];
+    }
+    for(int q=0; q<SH_INTERLEAVED_VEC4; q++){
+        densify.sh_coeffs_interleaved[dst * SH_INTERLEAVED_VEC4 + q] = uniforms.sh_coeffs_interleaved[src * SH_INTERLEAVED_VEC4 + q];
+    }
+
+    for(int i=0; i<2; i++){
+        densify.moments_positions[dst * 2 + i] = keep_moments ? uniforms.moments_positions[src * 2 + i] : vec4(0.0f);
+        densify.moments_scales[dst * 2 + i] = keep_moments ? uniforms.moments_scales[src * 2 + i] : vec4(0.0f);
+        densify.moments_rotations[dst * 2 + i] = keep_moments ? uniforms.moments_rotations[src * 2 + i] : vec4(0.0f);
+    }
+    densify.moments_opacities[dst] = keep_moments ? uniforms.moments_opacities[src] : vec2(0.0f);
+    for(int q=0; q<SH_INTERLEAVED_VEC4 * 2; q++){
+        densify.moments_sh[dst * SH_INTERLEAVED_VEC4 * 2 + q] = keep_moments ? uniforms.moments_sh[src * SH_INTERLEAVED_VEC4 * 2 + q] : vec4(0.0f);
+    }
+}
+
+// Stream compaction of the gaussians that are kept, followed by their copies, one thread per input gaussian.
+// The order of the gaussians is preserved. CpuDensification is the cpu reference.
+void main(void){
+    const int GaussianID = int(gl_GlobalInvocationID.x);
+    if(GaussianID >= densify.num_gaussians)
+        return;
+
+    const int kind = densify.kinds[GaussianID];
+    if(kind == DENSIFY_PRUNE)
+        return;
+
+    const int dst = densify.offsets[GaussianID] - getDensifyCount(kind);
+    const vec4 position = uniforms.positions[GaussianID];
+    const vec4 scale = uniforms.scales[GaussianID];
+
+    if(kind == DENSIFY_SPLIT){
+        const mat3 R = quat2mat(normalize(uniforms.rotations[GaussianID]));
+        for(int child=0; child<2; child++){
+            const vec3 offset = transpose(R) * getSplitOffset(GaussianID, child, densify.seed, vec3(scale));
+            writeGaussian(GaussianID, dst + child, position + vec4(offset, 0.0f), scale / SPLIT_SCALE_DIVIDER, false);
+        }
+    }else{
+        writeGaussian(GaussianID, dst, position, scale, true);
+        if(kind == DENSIFY_CLONE){
+            writeGaussian(GaussianID, dst + 1, position, scale, false);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+
+/*-- layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+#include "./common/Tiles.h"
+#include "./common/SplatProxy.h"
+
+// Writes one key per tile overlapped by each visible gaussian, at the offsets given by the prefix sum of tiles_touched.
+// The gaussians are already sorted by depth, so their index n is used as the depth part of the key.
+// In the hybrid mode, the tiles of each depth slice are separate, and the large splats are packed for the indirect draws.
+void main(void){
+    const int n = int(gl_GlobalInvocationID.x);
+    const int num_visible = *uniforms.visible_gaussians_counter;
+    if(n >= num_visible)
+        return;
+
+    const int width = int(uniforms.width);
+    const int height = int(uniforms.height);
+    const int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    const int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+    int slice = 0;
+    if(uniforms.hybrid_blending > 0){
+        slice = getDepthSlice(n, num_visible, uniforms.depth_slices);
+
+        // the first gaussian of each slice writes the draw command of the large splats of the slice
+        if(n == getDepthSliceBegin(slice, num_visible, uniforms.depth_slices)){
+            const int end = getDepthSliceBegin(slice + 1, num_visible, uniforms.depth_slices);
+            const int first = n == 0 ? 0 : uniforms.large_splat_offsets[n - 1];
+            const int count = uniforms.large_splat_offsets[end - 1] - first;
+            if(uniforms.instanced_strips > 0){
+                uniforms.hybrid_draws[slice] = uvec4(uint(uniforms.proxy_sides), uint(count), 0u, uint(first));
+            }else{
+                const int vertices = getProxyVertices(uniforms.proxy_sides);
+                uniforms.hybrid_draws[slice] = uvec4(uint(count * vertices), 1u, uint(first * vertices), 0u);
+            }
+        }
+
+        if(uniforms.large_splats[n] != 0){
+            uniforms.large_splat_indices[uniforms.large_splat_offsets[n] - 1] = n;
+            return; // no tile key
+        }
+    }
+
+    const ivec4 rect = getTileRect(uniforms.bounding_boxes[n], uniforms.eigen_vecs[n], width, height);
+
+    int offset = n == 0 ? 0 : uniforms.tile_offsets[n - 1];
+    // never more keys than counted by computeBoundingBoxes.cp, the range of the next gaussian starts there
+    const int end = uniforms.tile_offsets[n];
+    for(int ty = rect.y; ty < rect.w && offset < end; ty++){
+        for(int tx = rect.x; tx < rect.z && offset < end; tx++){
+            const uint64_t tile = uint64_t(slice * tiles_x * tiles_y + ty * tiles_x + tx);
+            uniforms.tile_keys[offset] = (tile << 32) | uint64_t(n);
+            offset++;
+        }
+    }
+
+}
@@ -0,0 +1,25 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+/*-- layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+#include "./common/Foveation.h"
+
+/*-- uniform layout(binding=0, r8ui) restrict writeonly --*/ uimage2D shading_rate_image;
+uniform ivec2 texel_size; // pixels covered by a texel of the shading rate image
+
+// Fills the shading rate image of GL_NV_shading_rate_image from the distance of each texel to the gaze point.
+void main(void){
+    const ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    if(texel.x >= imageSize(shading_rate_image).x || texel.y >= imageSize(shading_rate_image).y){
+        return;
+    }
+
+    const vec2 center = (vec2(texel) + 0.5f) * vec2(texel_size);
+    imageStore(shading_rate_image, texel, uvec4(getFoveationRateIndex(center)));
+}
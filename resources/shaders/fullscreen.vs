@@ -0,0 +1,17 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+
+#include "./common/Uniforms.h"
+
+// Fullscreen triangle on the near plane. In saturate.fs, the depth of 0 written in the saturated pixels
+// makes the depth test reject all the quads drawn afterwards.
+void main(void){
+
+    // vertices: (-1, -1), (3, -1), (-1, 3)
+    const float x = gl_VertexID == 1 ? 3.0f : -1.0f;
+    const float y = gl_VertexID == 2 ? 3.0f : -1.0f;
+    gl_Position = vec4(x, y, -1.0f, 1.0f);
+
+}
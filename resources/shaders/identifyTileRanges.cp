@@ -0,0 +1,32 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+
+/*-- layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+
+// The keys are sorted by tile, then by depth: each tile owns a contiguous range of keys,
+// whose bounds are found by comparing every key with its neighbours.
+// The ranges of the tiles without any gaussian are left to zero.
+void main(void){
+    const int i = int(gl_GlobalInvocationID.x);
+    const int num_visible = *uniforms.visible_gaussians_counter;
+    const int num_keys = num_visible > 0 ? uniforms.tile_offsets[num_visible - 1] : 0;
+    if(i >= num_keys)
+        return;
+
+    const int tile = int(uniforms.sorted_tile_keys[i] >> 32);
+
+    if(i == 0 || int(uniforms.sorted_tile_keys[i - 1] >> 32) != tile){
+        uniforms.tile_ranges[tile].x = i;
+    }
+    if(i == num_keys - 1 || int(uniforms.sorted_tile_keys[i + 1] >> 32) != tile){
+        uniforms.tile_ranges[tile].y = i + 1;
+    }
+
+}
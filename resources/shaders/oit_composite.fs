@@ -0,0 +1,28 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+#include "./common/Uniforms.h"
+
+___out vec4 out_Color;
+
+___in vec4 gl_FragCoord;
+
+/*-- uniform layout(binding=0, rgba32f) restrict readonly --*/ image2D accumulation_image;
+/*-- uniform layout(binding=1, r16f) restrict readonly --*/ image2D revealage_image;
+
+// Resolves the weighted blended transparency of quad_oit.fs into the fbo,
+// with the transmittance in alpha like the front to back blending.
+void main(void) {
+
+    const ivec2 uv = ivec2(gl_FragCoord.x, gl_FragCoord.y);
+    const vec4 accumulation = imageLoad(accumulation_image, uv);
+    const float revealage = imageLoad(revealage_image, uv).x;
+
+    // weighted average of the colors, times the total coverage
+    const vec3 average = vec3(accumulation) / max(accumulation.w, 1.0E-5f);
+    out_Color = vec4(average * (1.0f - revealage), revealage);
+
+}
@@ -0,0 +1,50 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+
+#include "./common/Uniforms.h"
+
+___out vec4 baseColor;
+
+// Maps the index of a gaussian to a pseudo-random number in [0, 1)
+float hashIndex(uint n){
+    n ^= n >> 16;
+    n *= 0x7feb352dU;
+    n ^= n >> 15;
+    n *= 0x846ca68bU;
+    n ^= n >> 16;
+    return float(n >> 8) * (1.0f / 16777216.0f);
+}
+
+void main(void){
+
+    vec4 P = uniforms.positions[gl_VertexID];
+    vec4 C = unpackUnorm4x8(uniforms.baked_colors[gl_VertexID]);
+    C.w = 1.0f;
+
+    // Beyond the decimation distance, the number of gaussians per pixel grows with the square of the distance,
+    // so keep each of them with a probability decreasing accordingly.
+    // The hash only depends on the index, so the kept points don't flicker when the camera moves.
+    if(uniforms.point_decimation_distance > 0.0f){
+        const float d = length(vec3(P - uniforms.camera_pos));
+        const float r = uniforms.point_decimation_distance / d;
+        if(hashIndex(uint(gl_VertexID)) >= r * r){
+            gl_Position = vec4(0, 0, 2, 1); // outside of the clip volume
+            gl_PointSize = 1.0f;
+            baseColor = C;
+            return;
+        }
+    }
+
+    if(gl_VertexID == uniforms.selected_gaussian){
+        C = vec4(1, 0, 1, 1);
+        gl_PointSize = 10.0f;
+    }else{
+        gl_PointSize = 1.0f;
+    }
+
+    baseColor = C;
+    gl_Position = uniforms.projMat * uniforms.viewMat * P;
+
+}
@@ -4,31 +4,14 @@
 //-- #extension GL_NV_shader_buffer_load : enable
 //-- #extension GL_ARB_bindless_texture : enable
 //-- #extension GL_KHR_shader_subgroup_clustered : enable
+//-- #extension GL_KHR_shader_subgroup_ballot : enable
 
 /*-- layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in; --*/
 
 #include "./common/GLSLDefines.h"
 #include "./common/Uniforms.h"
-
-// Spherical harmonics coefficients
-const float SH_C0 = 0.28209479177387814f;
-const float SH_C1 = 0.4886025119029199f;
-const float SH_C2[] = {
-        1.0925484305920792f,
-        -1.0925484305920792f,
-        0.31539156525252005f,
-        -1.0925484305920792f,
-        0.5462742152960396f
-};
-const float SH_C3[] = {
-        -0.5900435899266435f,
-        2.890611442640554f,
-        -0.4570457994644658f,
-        0.3731763325901154f,
-        -0.4570457994644658f,
-        1.445305721320277f,
-        -0.5900435899266435f
-};
+#include "./common/SphericalHarmonics.h"
+#include "./common/ColorCache.h"
 
 void main(void){
     const int n = int(gl_GlobalInvocationID.x) / 16;
@@ -41,17 +24,38 @@ void main(void){
     const vec4 P = uniforms.positions[GaussianID];
 
     const vec3 dir = normalize(vec3(P - uniforms.camera_pos));
+
+    int degree = 3;
+    if(uniforms.sh_lod > 0){
+        // the oriented bounding box of the gaussian has already been computed for this frame
+        const vec4 box = uniforms.bounding_boxes[n];
+        const vec3 thresholds = vec3(uniforms.sh_lod_degree1_pixels, uniforms.sh_lod_degree2_pixels, uniforms.sh_lod_degree3_pixels);
+        degree = selectSHDegree(max(box.z, box.w), thresholds);
+    }
+
+    vec4 cached_color;
+    const bool hit = colorCacheLookup(GaussianID, dir, degree, cached_color);
+    colorCacheCountHits(hit && k == 0);
+    if(hit){
+        if(k == 0){
+            uniforms.predicted_colors[n] = cached_color;
+        }
+        return;
+    }
+
     const float x = dir.x;
     const float y = dir.y;
     const float z = dir.z;
     const float xx = x * x, yy = y * y, zz = z * z;
     const float xy = x * y, yz = y * z, xz = x * z;
 
-    const vec3 sh_coeff = vec3(
+    // only read the coefficients up to the selected degree
+    const bool used = k < (degree + 1) * (degree + 1);
+    const vec3 sh_coeff = used ? vec3(
             uniforms.sh_coeffs_red[GaussianID * 16 + k],
             uniforms.sh_coeffs_green[GaussianID * 16 + k],
             uniforms.sh_coeffs_blue[GaussianID * 16 + k]
-    );
+    ) : vec3(0.0f);
 
     float weight = 0.0f;
     if(k== 0) weight = SH_C0;
@@ -75,5 +79,6 @@ void main(void){
 
     if(k == 0){
         uniforms.predicted_colors[n] = vec4(result, 1.0f);
+        colorCacheStore(GaussianID, dir, degree, vec4(result, 1.0f));
     }
 }
\ No newline at end of file
@@ -9,66 +9,75 @@
 
 #include "./common/GLSLDefines.h"
 #include "./common/Uniforms.h"
+#include "./common/SphericalHarmonics.h"
 
-// Spherical harmonics coefficients
-const float SH_C0 = 0.28209479177387814f;
-const float SH_C1 = 0.4886025119029199f;
-const float SH_C2[] = {
-        1.0925484305920792f,
-        -1.0925484305920792f,
-        0.31539156525252005f,
-        -1.0925484305920792f,
-        0.5462742152960396f
-};
-const float SH_C3[] = {
-        -0.5900435899266435f,
-        2.890611442640554f,
-        -0.4570457994644658f,
-        0.3731763325901154f,
-        -0.4570457994644658f,
-        1.445305721320277f,
-        -0.5900435899266435f
-};
-
+// Backward of predict_colors.cp with the full degree, 16 threads per gaussian.
 void main(void){
     const int n = int(gl_GlobalInvocationID.x) / 16;
     const int k = int(gl_GlobalInvocationID.x) % 16;
     if(n >= *uniforms.visible_gaussians_counter)
         return;
 
-    const vec4 dLoss_dpredicted_color = vec4(uniforms.dLoss_dpredicted_colors[n]);
+    const bool fp32 = uniforms.gradient_accumulation == GRADIENTS_FP32_ATOMIC || uniforms.gradient_accumulation == GRADIENTS_FP32_PARTITIONED;
+    const vec4 dLoss_dpredicted_color = fp32 ? vec4(uniforms.dLoss_dpredicted_colors_fp32[n * 4 + 0], uniforms.dLoss_dpredicted_colors_fp32[n * 4 + 1],
+                                                    uniforms.dLoss_dpredicted_colors_fp32[n * 4 + 2], 0.0f)
+                                             : vec4(uniforms.dLoss_dpredicted_colors[n]);
 
     const int GaussianID = uniforms.sorted_gaussian_indices[n];
 
     const vec4 P = uniforms.positions[GaussianID];
 
-    const vec3 dir = normalize(vec3(P - uniforms.camera_pos));
+    const vec3 view_dir = vec3(P - uniforms.camera_pos);
+    const vec3 dir = normalize(view_dir);
     const float x = dir.x;
     const float y = dir.y;
     const float z = dir.z;
     const float xx = x * x, yy = y * y, zz = z * z;
     const float xy = x * y, yz = y * z, xz = x * z;
 
+    // weight of the coefficient k and its derivative with respect to dir
     float weight = 0.0f;
-    if(k== 0) weight = SH_C0;
-    if(k== 1) weight = - SH_C1 * y;
-    if(k== 2) weight = SH_C1 * z;
-    if(k== 3) weight = - SH_C1 * x;
-    if(k== 4) weight = SH_C2[0] * xy;
-    if(k== 5) weight = SH_C2[1] * yz;
-    if(k== 6) weight = SH_C2[2] * (2.0f * zz - xx - yy);
-    if(k== 7) weight = SH_C2[3] * xz;
-    if(k== 8) weight = SH_C2[4] * (xx - yy);
-    if(k== 9) weight = SH_C3[0] * y * (3.0f * xx - yy);
-    if(k==10) weight = SH_C3[1] * xy * z;
-    if(k==11) weight = SH_C3[2] * y * (4.0f * zz - xx - yy);
-    if(k==12) weight = SH_C3[3] * z * (2.0f * zz - 3.0f * xx - 3.0f * yy);
-    if(k==13) weight = SH_C3[4] * x * (4.0f * zz - xx - yy);
-    if(k==14) weight = SH_C3[5] * z * (xx - yy);
-    if(k==15) weight = SH_C3[6] * x * (xx - 3.0f * yy);
+    vec3 dweight_ddir = vec3(0.0f);
+    if(k== 0) { weight = SH_C0; }
+    if(k== 1) { weight = - SH_C1 * y; dweight_ddir = vec3(0.0f, -SH_C1, 0.0f); }
+    if(k== 2) { weight = SH_C1 * z; dweight_ddir = vec3(0.0f, 0.0f, SH_C1); }
+    if(k== 3) { weight = - SH_C1 * x; dweight_ddir = vec3(-SH_C1, 0.0f, 0.0f); }
+    if(k== 4) { weight = SH_C2[0] * xy; dweight_ddir = SH_C2[0] * vec3(y, x, 0.0f); }
+    if(k== 5) { weight = SH_C2[1] * yz; dweight_ddir = SH_C2[1] * vec3(0.0f, z, y); }
+    if(k== 6) { weight = SH_C2[2] * (2.0f * zz - xx - yy); dweight_ddir = SH_C2[2] * vec3(-2.0f * x, -2.0f * y, 4.0f * z); }
+    if(k== 7) { weight = SH_C2[3] * xz; dweight_ddir = SH_C2[3] * vec3(z, 0.0f, x); }
+    if(k== 8) { weight = SH_C2[4] * (xx - yy); dweight_ddir = SH_C2[4] * vec3(2.0f * x, -2.0f * y, 0.0f); }
+    if(k== 9) { weight = SH_C3[0] * y * (3.0f * xx - yy); dweight_ddir = SH_C3[0] * vec3(6.0f * xy, 3.0f * (xx - yy), 0.0f); }
+    if(k==10) { weight = SH_C3[1] * xy * z; dweight_ddir = SH_C3[1] * vec3(yz, xz, xy); }
+    if(k==11) { weight = SH_C3[2] * y * (4.0f * zz - xx - yy); dweight_ddir = SH_C3[2] * vec3(-2.0f * xy, 4.0f * zz - xx - 3.0f * yy, 8.0f * yz); }
+    if(k==12) { weight = SH_C3[3] * z * (2.0f * zz - 3.0f * xx - 3.0f * yy); dweight_ddir = SH_C3[3] * vec3(-6.0f * xz, -6.0f * yz, 6.0f * zz - 3.0f * xx - 3.0f * yy); }
+    if(k==13) { weight = SH_C3[4] * x * (4.0f * zz - xx - yy); dweight_ddir = SH_C3[4] * vec3(4.0f * zz - 3.0f * xx - yy, -2.0f * xy, 8.0f * xz); }
+    if(k==14) { weight = SH_C3[5] * z * (xx - yy); dweight_ddir = SH_C3[5] * vec3(2.0f * xz, -2.0f * yz, xx - yy); }
+    if(k==15) { weight = SH_C3[6] * x * (xx - 3.0f * yy); dweight_ddir = SH_C3[6] * vec3(3.0f * (xx - yy), -6.0f * xy, 0.0f); }
+
+    const vec3 sh_coeff = vec3(
+            uniforms.sh_coeffs_red[GaussianID * 16 + k],
+            uniforms.sh_coeffs_green[GaussianID * 16 + k],
+            uniforms.sh_coeffs_blue[GaussianID * 16 + k]
+    );
+
+    // the color is clamped to 0 in the forward pass
+    const vec3 color = 0.5f + subgroupClusteredAdd(sh_coeff * weight, 16);
+    const vec3 dLoss_dcolor = vec3(
+            color.x < 0.0f ? 0.0f : dLoss_dpredicted_color.x,
+            color.y < 0.0f ? 0.0f : dLoss_dpredicted_color.y,
+            color.z < 0.0f ? 0.0f : dLoss_dpredicted_color.z);
+
+    // A gaussian is visible at most once per view, the gradients of several views add up.
+    uniforms.dLoss_dsh_coeffs_red[GaussianID * 16 + k] += dLoss_dcolor.x * weight;
+    uniforms.dLoss_dsh_coeffs_green[GaussianID * 16 + k] += dLoss_dcolor.y * weight;
+    uniforms.dLoss_dsh_coeffs_blue[GaussianID * 16 + k] += dLoss_dcolor.z * weight;
 
-    uniforms.dLoss_dsh_coeffs_red[GaussianID * 16 + k] = dLoss_dpredicted_color.x * weight;
-    uniforms.dLoss_dsh_coeffs_green[GaussianID * 16 + k] = dLoss_dpredicted_color.y * weight;
-    uniforms.dLoss_dsh_coeffs_blue[GaussianID * 16 + k] = dLoss_dpredicted_color.z * weight;
+    // the view direction depends on the position of the gaussian
+    const vec3 dLoss_ddir = subgroupClusteredAdd(dweight_ddir * dot(dLoss_dcolor, sh_coeff), 16);
+    if(k == 0){
+        const vec3 dLoss_dview_dir = (dLoss_ddir - dot(dLoss_ddir, dir) * dir) / length(view_dir);
+        uniforms.dLoss_dpositions[GaussianID] += vec4(dLoss_dview_dir, 0.0f);
+    }
 
-}
\ No newline at end of file
+}
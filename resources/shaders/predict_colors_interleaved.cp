@@ -0,0 +1,46 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+//-- #extension GL_KHR_shader_subgroup_ballot : enable
+
+/*-- layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in; --*/
+
+#include "./common/GLSLDefines.h"
+#include "./common/Uniforms.h"
+#include "./common/SphericalHarmonics.h"
+#include "./common/ColorCache.h"
+
+// One thread per gaussian, reading the 48 coefficients from the interleaved layout with 12 vec4 loads.
+void main(void){
+    const int n = int(gl_GlobalInvocationID.x);
+    if(n >= *uniforms.visible_gaussians_counter)
+        return;
+
+    const int GaussianID = uniforms.sorted_gaussian_indices[n];
+
+    const vec4 P = uniforms.positions[GaussianID];
+    const vec3 dir = normalize(vec3(P - uniforms.camera_pos));
+
+    int degree = 3;
+    if(uniforms.sh_lod > 0){
+        // the oriented bounding box of the gaussian has already been computed for this frame
+        const vec4 box = uniforms.bounding_boxes[n];
+        const vec3 thresholds = vec3(uniforms.sh_lod_degree1_pixels, uniforms.sh_lod_degree2_pixels, uniforms.sh_lod_degree3_pixels);
+        degree = selectSHDegree(max(box.z, box.w), thresholds);
+    }
+
+    vec4 cached_color;
+    const bool hit = colorCacheLookup(GaussianID, dir, degree, cached_color);
+    colorCacheCountHits(hit);
+    if(hit){
+        uniforms.predicted_colors[n] = cached_color;
+        return;
+    }
+
+    const vec3 result = evalSphericalHarmonics(uniforms.sh_coeffs_interleaved + GaussianID * SH_INTERLEAVED_VEC4, dir, degree);
+
+    uniforms.predicted_colors[n] = vec4(result, 1.0f);
+    colorCacheStore(GaussianID, dir, degree, vec4(result, 1.0f));
+}
\ No newline at end of file
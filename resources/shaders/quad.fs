@@ -6,6 +6,10 @@
 
 #include "./common/Uniforms.h"
 
+// Depth test before the fragment shader, so that the saturated pixels marked by saturate.fs cost no shading.
+// The quads never write the depth, so the discards below don't need to happen before the test.
+/*-- layout(early_fragment_tests) in; --*/
+
 ___out vec4 out_Color;
 
 ___flat ___in int InstanceID;
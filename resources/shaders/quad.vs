@@ -4,25 +4,30 @@
 //-- #extension GL_NV_shader_buffer_load : enable
 
 #include "./common/Uniforms.h"
+#include "./common/SplatProxy.h"
 
 ___flat ___out int InstanceID; // pass the index of the ellipse to the fragment shader
 ___out vec2 local_coord;
 
 void main(void){
 
-    InstanceID = gl_VertexID / 6;
-
-    // Corners:
-    // 2 3
-    // 0 1
-
-    // indices:  0  1  2  3  2  1
-    // x:       -1 +1 -1 +1 -1 +1
-    // y:       -1 -1 +1 +1 +1 -1
-
-    float x = (gl_VertexID % 2 == 0) ? -1.0f : +1.0f;
-    float y = (((gl_VertexID+1) % 6) < 3) ? -1.0f : + 1.0f;
-    const vec2 corner = vec2(x, y);
+    int corner_index;
+    if(uniforms.instanced_strips > 0){
+        // one instance per splat, gl_InstanceID doesn't include the base instance
+        InstanceID = int(gl_BaseInstance + gl_InstanceID);
+        corner_index = getStripCorner(int(gl_VertexID), uniforms.proxy_sides);
+    }else{
+        const int vertices = getProxyVertices(uniforms.proxy_sides);
+        InstanceID = int(gl_VertexID) / vertices;
+        corner_index = getFanCorner(int(gl_VertexID) % vertices);
+    }
+    if(uniforms.hybrid_blending > 0){
+        // only the large splats are drawn, see emitTileKeys.cp
+        InstanceID = uniforms.large_splat_indices[InstanceID];
+    }
+
+    // corner of the polygon circumscribed to the ellipse
+    const vec2 corner = getProxyCorner(corner_index, uniforms.proxy_sides);
 
     const float width = uniforms.width;
     const float height = uniforms.height;
@@ -37,11 +42,18 @@ void main(void){
     // ellipse rotation matrix in 2D
     const mat2 rotation = mat2(dir.x, dir.y, -dir.y, dir.x);
 
-    // offset of the corner of the oriented bounding box from the center of the 2D ellipse, in pixels
+    // offset of the corner of the polygon from the center of the 2D ellipse, in pixels
     local_coord = rotation * (half_extent * corner);
 
     // normalized coordinates
     const vec2 ndc = (center + local_coord) / vec2(width, height) * 2.0f - 1.0f;
-    gl_Position = vec4(ndc, 0.0f, 1.0f);
+    float z = 0.0f;
+    if(uniforms.stochastic_transparency > 0){
+        // linear view space depth, for the depth test
+        const float d = uniforms.sorted_depths[InstanceID];
+        const float w = uniforms.front_to_back > 0 ? d : 1.0f / d;
+        z = clamp((w - uniforms.near_plane) / (uniforms.far_plane - uniforms.near_plane), 0.0f, 1.0f) * 2.0f - 1.0f;
+    }
+    gl_Position = vec4(ndc, z, 1.0f);
 
 }
\ No newline at end of file
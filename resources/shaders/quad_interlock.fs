@@ -16,6 +16,15 @@ ___in vec4 gl_FragCoord;
 
 void main(void) {
 
+    const ivec2 uv = ivec2(gl_FragCoord.x, gl_FragCoord.y);
+    if(uniforms.early_termination > 0){
+        // Read outside of the critical section: the transmittance only decreases,
+        // so a stale value can only keep a fragment that could have been skipped.
+        if(imageLoad(accumulated_image, uv).w < uniforms.termination_transmittance){
+            ___discard;
+        }
+    }
+
     const vec4 color = uniforms.predicted_colors[InstanceID];
     const vec4 conic_opacity = uniforms.conic_opacity[InstanceID];
 
@@ -33,7 +42,6 @@ void main(void) {
     }
 
     const vec3 c = vec3(color);
-    const ivec2 uv = ivec2(gl_FragCoord.x, gl_FragCoord.y);
 
     // critical section, manual alpha-blending
     beginInvocationInterlockARB();
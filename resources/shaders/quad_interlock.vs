@@ -4,6 +4,7 @@
 //-- #extension GL_NV_shader_buffer_load : enable
 
 #include "./common/Uniforms.h"
+#include "./common/SplatProxy.h"
 
 ___flat ___out int InstanceID; // pass the index of the ellipse to the fragment shader
 ___out vec2 local_coord;
@@ -11,19 +12,19 @@ ___out vec2 local_coord;
 void main(void){
 
 //    InstanceID = gl_InstanceID;
-    InstanceID = gl_VertexID / 6;
-
-    // Corners:
-    // 2 3
-    // 0 1
-
-    // indices:  0  1  2  3  2  1
-    // x:       -1 +1 -1 +1 -1 +1
-    // y:       -1 -1 +1 +1 +1 -1
-
-    float x = (gl_VertexID % 2 == 0) ? -1.0f : +1.0f;
-    float y = (((gl_VertexID+1) % 6) < 3) ? -1.0f : + 1.0f;
-    const vec2 corner = vec2(x, y);
+    int corner_index;
+    if(uniforms.instanced_strips > 0){
+        // one instance per splat, gl_InstanceID doesn't include the base instance
+        InstanceID = int(gl_BaseInstance + gl_InstanceID);
+        corner_index = getStripCorner(int(gl_VertexID), uniforms.proxy_sides);
+    }else{
+        const int vertices = getProxyVertices(uniforms.proxy_sides);
+        InstanceID = int(gl_VertexID) / vertices;
+        corner_index = getFanCorner(int(gl_VertexID) % vertices);
+    }
+
+    // corner of the polygon circumscribed to the ellipse
+    const vec2 corner = getProxyCorner(corner_index, uniforms.proxy_sides);
 
     const float width = uniforms.width;
     const float height = uniforms.height;
@@ -38,7 +39,7 @@ void main(void){
     // ellipse rotation matrix in 2D
     const mat2 rotation = mat2(dir.x, dir.y, -dir.y, dir.x);
 
-    // offset of the corner of the oriented bounding box from the center of the 2D ellipse, in pixels
+    // offset of the corner of the polygon from the center of the 2D ellipse, in pixels
     local_coord = rotation * (half_extent * corner);
 
     // normalized coordinates
@@ -68,19 +68,42 @@ void main(void) {
     const float dLoss_dopacity = dLoss_dalpha * expPower;
     const float dLoss_dpower = dLoss_dalpha * alpha;
     const vec3 dLoss_dconic = -0.5f * dLoss_dpower * vec3(local_coord.x*local_coord.x, 2.0f*local_coord.x*local_coord.y, local_coord.y*local_coord.y);
+    // local_coord = pixel - center
+    const vec2 dLoss_dcenter = dLoss_dpower * (cov2D * local_coord);
 
     vec4 dLoss_dconic_opacity = alpha < 0.99f ? vec4(dLoss_dconic, dLoss_dopacity) : vec4(0.0f);
+    vec2 dLoss_dmean2D = alpha < 0.99f ? dLoss_dcenter : vec2(0.0f);
 
-    const int GaussianID = uniforms.sorted_gaussian_indices[InstanceID];
-    const uvec4 ballot = subgroupPartitionNV(InstanceID);
-    const bool firstInPartition = subgroupBallotFindLSB(ballot) == gl_SubgroupInvocationID;
+    const int mode = uniforms.gradient_accumulation;
+    if(mode == GRADIENTS_FP16_PARTITIONED || mode == GRADIENTS_FP32_PARTITIONED){
+        // one atomic per splat in the subgroup instead of one per fragment
+        const uvec4 ballot = subgroupPartitionNV(InstanceID);
+        const bool firstInPartition = subgroupBallotFindLSB(ballot) == gl_SubgroupInvocationID;
 
-    dLoss_dcolor = subgroupPartitionedAddNV(dLoss_dcolor, ballot);
-    dLoss_dconic_opacity = subgroupPartitionedAddNV(dLoss_dconic_opacity, ballot);
+        dLoss_dcolor = subgroupPartitionedAddNV(dLoss_dcolor, ballot);
+        dLoss_dconic_opacity = subgroupPartitionedAddNV(dLoss_dconic_opacity, ballot);
+        dLoss_dmean2D = subgroupPartitionedAddNV(dLoss_dmean2D, ballot);
 
-    if(firstInPartition){
+        if(!firstInPartition){
+            return;
+        }
+    }
+
+    if(mode == GRADIENTS_FP16_PARTITIONED || mode == GRADIENTS_FP16_ATOMIC){
         atomicAdd(uniforms.dLoss_dpredicted_colors+InstanceID, f16vec4(vec4(dLoss_dcolor, 0.0f)));
         atomicAdd(uniforms.dLoss_dconic_opacity+InstanceID, f16vec4(dLoss_dconic_opacity));
+        atomicAdd(uniforms.dLoss_dmean2D+InstanceID, f16vec2(dLoss_dmean2D));
+    }else{
+        // no vector atomics in fp32
+        for(int k=0; k<3; k++){
+            atomicAdd(uniforms.dLoss_dpredicted_colors_fp32 + InstanceID * 4 + k, dLoss_dcolor[k]);
+        }
+        for(int k=0; k<4; k++){
+            atomicAdd(uniforms.dLoss_dconic_opacity_fp32 + InstanceID * 4 + k, dLoss_dconic_opacity[k]);
+        }
+        for(int k=0; k<2; k++){
+            atomicAdd(uniforms.dLoss_dmean2D_fp32 + InstanceID * 2 + k, dLoss_dmean2D[k]);
+        }
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+#include "./common/Uniforms.h"
+
+/*-- layout(location = 0) --*/ ___out vec4 out_Accumulation;
+/*-- layout(location = 1) --*/ ___out float out_Revealage;
+
+___flat ___in int InstanceID;
+___in vec2 local_coord; // offset of the corner of the polygon from the center of the 2D ellipse, in pixels
+
+// Weighted blended order-independent transparency (McGuire and Bavoil 2013), the gaussians are not sorted.
+// The accumulation target sums the premultiplied colors and alphas scaled by a weight that decreases with the depth,
+// the revealage target multiplies the (1 - alpha), see oit_composite.fs.
+void main(void) {
+
+    const vec4 color = uniforms.predicted_colors[InstanceID];
+    const vec4 conic_opacity = uniforms.conic_opacity[InstanceID];
+
+    const mat2 cov2D = mat2(conic_opacity.x, conic_opacity.y, conic_opacity.y, conic_opacity.z);
+    const float opacity = conic_opacity.w;
+
+    const float power = -0.5f * dot(local_coord, cov2D * local_coord);
+    if (power > 0.0f){
+        ___discard;
+    }
+
+    const float alpha = min(0.99f, opacity * exp(power));
+    if (alpha < uniforms.min_opacity){
+        ___discard;
+    }
+
+    // view space depth, see testVisibility.cp
+    const float d = uniforms.sorted_depths[InstanceID];
+    const float z = uniforms.front_to_back > 0 ? d : 1.0f / d;
+
+    // equation (7) of the paper
+    const float z5 = z / 5.0f;
+    const float z200 = z / 200.0f;
+    const float weight = alpha * clamp(10.0f / (1.0E-5f + z5 * z5 + z200 * z200 * z200 * z200 * z200 * z200), 1.0E-2f, 3.0E3f);
+
+    out_Accumulation = vec4(vec3(color) * alpha, alpha) * weight;
+    out_Revealage = alpha;
+}
@@ -0,0 +1,57 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+#include "./common/Uniforms.h"
+
+___out vec4 out_Color;
+
+___flat ___in int InstanceID;
+___in vec2 local_coord; // offset of the corner of the polygon from the center of the 2D ellipse, in pixels
+
+___in vec4 gl_FragCoord;
+
+uint hash(uint n){
+    n ^= n >> 16;
+    n *= 0x7feb352dU;
+    n ^= n >> 15;
+    n *= 0x846ca68bU;
+    n ^= n >> 16;
+    return n;
+}
+
+// Stochastic transparency: each fragment is kept as opaque with a probability equal to its alpha, and the depth test
+// keeps the nearest one. The expected color is the same as the front to back blending,
+// and the average over the frames converges to it, see accumulateFrames.cp.
+void main(void) {
+
+    const vec4 color = uniforms.predicted_colors[InstanceID];
+    const vec4 conic_opacity = uniforms.conic_opacity[InstanceID];
+
+    const mat2 cov2D = mat2(conic_opacity.x, conic_opacity.y, conic_opacity.y, conic_opacity.z);
+    const float opacity = conic_opacity.w;
+
+    const float power = -0.5f * dot(local_coord, cov2D * local_coord);
+    if (power > 0.0f){
+        ___discard;
+    }
+
+    const float alpha = min(0.99f, opacity * exp(power));
+    if (alpha < uniforms.min_opacity){
+        ___discard;
+    }
+
+    // hashed alpha test, with a different pattern for every pixel, gaussian and frame
+    const uint x = uint(gl_FragCoord.x);
+    const uint y = uint(gl_FragCoord.y);
+    const uint h = hash(x ^ hash(y ^ hash(uint(InstanceID) ^ hash(uint(uniforms.stochastic_frame)))));
+    const float u = float(h >> 8) * (1.0f / 16777216.0f); // uniform in [0, 1)
+    if(u >= alpha){
+        ___discard;
+    }
+
+    // opaque, the transmittance of the pixel becomes 0
+    out_Color = vec4(vec3(color), 0.0f);
+}
@@ -0,0 +1,23 @@
+//-- #version 460 core
+//-- #extension GL_ARB_shading_language_include :   require
+//-- #extension GL_NV_gpu_shader5 : enable
+//-- #extension GL_NV_shader_buffer_load : enable
+//-- #extension GL_ARB_bindless_texture : enable
+
+#include "./common/Uniforms.h"
+
+___in vec4 gl_FragCoord;
+
+/*-- uniform layout(binding=0, rgba16f) restrict readonly --*/ image2D accumulated_image;
+
+// Marks the pixels whose transmittance is below the threshold, the color writes are disabled
+// and only the depth of the fullscreen triangle is written.
+void main(void) {
+
+    const ivec2 uv = ivec2(gl_FragCoord.x, gl_FragCoord.y);
+    const float transmittance = imageLoad(accumulated_image, uv).w;
+    if(transmittance >= uniforms.termination_transmittance){
+        ___discard;
+    }
+
+}
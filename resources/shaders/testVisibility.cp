@@ -12,6 +12,7 @@ const int NUM_WARPS = 128/32;
 #include "./common/GLSLDefines.h"
 #include "./common/Uniforms.h"
 #include "./common/Covariance.h"
+#include "./common/Foveation.h"
 
 shared int warp_totals[NUM_WARPS];
 shared int global_offset;
@@ -107,6 +108,12 @@ void main(void){
             const vec2 maxCorner = proj_pixels + bbox_pixels;
 
             inSquare = maxCorner.x > 0.0f && minCorner.x < width && maxCorner.y > 0.0f && minCorner.y < height;
+
+            // skip the gaussians smaller than the coarse pixels of the periphery
+            const float pixel_size = getFoveationPixelSize(proj_pixels);
+            if(pixel_size > 1.0f && 2.0f * max(bbox_pixels.x, bbox_pixels.y) < uniforms.fovea_cull_size * pixel_size){
+                inSquare = false;
+            }
         }
 
         ok = depth_ok && inSquare && selected && opacity_ok;
@@ -0,0 +1,384 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "Benchmark.h"
+#include "GaussianCloud.h"
+#include "PointCloudLoader.h"
+#include "PlyGaussians.h"
+#include "RenderingBase/Profiler.h"
+
+#include "GLFW/glfw3.h"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+
+// same order as GaussianCloud::OPERATIONS
+static const char* stageNames[] = {
+        "predict_colors_all", "draw_as_points", "test_visibility", "sort", "compute_bounding_boxes",
+        "predict_colors_visible", "draw_as_quads", "bin_tiles", "blend_tiles", "blit_fbo"
+};
+
+static int parseInt(const std::string& arg, const char* value){
+    try{
+        return std::stoi(value);
+    }catch(const std::exception&){
+        throw std::string("Invalid value for ") + arg + ": " + value;
+    }
+}
+
+static double parseDouble(const std::string& arg, const char* value){
+    try{
+        return std::stod(value);
+    }catch(const std::exception&){
+        throw std::string("Invalid value for ") + arg + ": " + value;
+    }
+}
+
+Benchmark::Options Benchmark::parse(int argc, char **argv) {
+    Options o;
+    for(int i=1; i<argc; i++){
+        const std::string arg = argv[i];
+        if(arg == "--benchmark"){
+            o.enabled = true;
+            continue;
+        }else if(arg == "--sh-sweep"){
+            o.shSweep = true;
+            o.enabled = true;
+            continue;
+        }
+        if(i + 1 >= argc){
+            throw std::string("Missing value for ") + arg;
+        }
+        const char* value = argv[++i];
+        if(arg == "--scene"){
+            o.scene = value;
+            o.enabled = true;
+        }else if(arg == "--camera-path"){
+            o.cameraPath = value;
+        }else if(arg == "--frames"){
+            o.frames = parseInt(arg, value);
+        }else if(arg == "--warmup"){
+            o.warmup = parseInt(arg, value);
+        }else if(arg == "--fps"){
+            o.fps = parseDouble(arg, value);
+        }else if(arg == "--mode"){
+            o.mode = value;
+            if(o.mode != "quads" && o.mode != "interlock" && o.mode != "points"){
+                throw std::string("Unknown mode ") + o.mode + ", expected quads, interlock or points";
+            }
+        }else if(arg == "--size"){
+            if(std::sscanf(value, "%dx%d", &o.size.x, &o.size.y) != 2 || o.size.x <= 0 || o.size.y <= 0){
+                throw std::string("Invalid size ") + value + ", expected WIDTHxHEIGHT";
+            }
+        }else if(arg == "--output"){
+            o.output = value;
+        }else if(arg == "--trace"){
+            o.trace = value;
+        }else if(arg == "--synthetic"){
+            o.synthetic = parseInt(arg, value);
+            o.enabled = true;
+        }else if(arg == "--sh-layout"){
+            o.shLayout = value;
+            if(o.shLayout != "planar" && o.shLayout != "interleaved"){
+                throw std::string("Unknown sh layout ") + o.shLayout + ", expected planar or interleaved";
+            }
+        }else{
+            throw std::string("Unknown argument ") + arg;
+        }
+    }
+    if(o.enabled && o.scene.empty() && o.synthetic == 0 && !o.shSweep){
+        throw std::string("The benchmark needs a --scene or --synthetic");
+    }
+    if(o.frames <= 0 || o.warmup < 0 || o.fps <= 0.0 || o.synthetic < 0){
+        throw std::string("The number of frames, of synthetic gaussians and the fps must be positive");
+    }
+    return o;
+}
+
+bool Benchmark::isRequested(int argc, char **argv) {
+    for(int i=1; i<argc; i++){
+        const std::string arg = argv[i];
+        if(arg == "--benchmark" || arg == "--scene" || arg == "--synthetic" || arg == "--sh-sweep"){
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string Benchmark::sceneName() const {
+    return options.synthetic > 0 ? "synthetic " + std::to_string(options.synthetic) : options.scene;
+}
+
+bool Benchmark::jsonOutput() const {
+    return options.output.size() >= 5 && options.output.compare(options.output.size() - 5, 5, ".json") == 0;
+}
+
+void Benchmark::load(GaussianCloud &cloud) const {
+    if(options.synthetic > 0){
+        PointCloudLoader::upload(cloud, PlyGaussians::synthetic(options.synthetic, 1.0f), true);
+    }else{
+        PointCloudLoader::load(cloud, options.scene, true);
+    }
+    if(!cloud.initialized){
+        throw std::string("Couldn't load the scene ") + sceneName();
+    }
+}
+
+glm::ivec2 Benchmark::setupWindow(GLFWwindow *window, Camera &camera) const {
+    // the frames aren't capped by the refresh rate
+    glfwSwapInterval(0);
+    if(options.size.x > 0){
+        // the hidden window is only the target of the blit
+        glfwSetWindowSize(window, options.size.x, options.size.y);
+    }
+    glm::ivec2 windowSize;
+    glfwGetFramebufferSize(window, &windowSize.x, &windowSize.y);
+    // same aspect ratio as the rendering
+    camera.setFramebufferSize(options.size.x > 0 ? options.size : windowSize);
+    return windowSize;
+}
+
+bool Benchmark::run(GLFWwindow *window, GaussianCloud &cloud, Camera &camera) {
+    static_assert(sizeof(stageNames) / sizeof(stageNames[0]) == GaussianCloud::OPERATIONS::NUM_OPS);
+
+    if(options.shSweep){
+        return runSHSweep(window, cloud, camera);
+    }
+
+    load(cloud);
+
+    cloud.renderAsPoints = options.mode == "points";
+    cloud.renderAsQuads = !cloud.renderAsPoints;
+    cloud.blending = options.mode == "interlock" ? GaussianCloud::INTERLOCK_BLENDING : GaussianCloud::HARDWARE_BLENDING;
+    cloud.dynamicResolution = false;
+    cloud.renderSize = options.size;
+    cloud.interleavedSH = options.shLayout == "interleaved";
+
+    const CameraPath path = options.cameraPath.empty()
+            ? CameraPath::orbit(camera.getPose(), options.frames, 1.0 / options.fps)
+            : CameraPath::load(options.cameraPath);
+
+    const glm::ivec2 windowSize = setupWindow(window, camera);
+
+    // the path loops, with one timestep between the last keyframe and the first one
+    const double timestep = 1.0 / options.fps;
+    const double period = path.getDuration() + timestep;
+
+    Profiler* profiler = options.trace.empty() ? nullptr : Profiler::instance;
+
+    std::vector<Frame> frames;
+    frames.reserve(options.frames);
+    auto last = std::chrono::steady_clock::now();
+    for(int f=0; f<options.warmup + options.frames && !glfwWindowShouldClose(window); f++){
+        if(profiler){
+            profiler->setEnabled(f >= options.warmup);
+            profiler->newFrame();
+        }
+        // fixed timestep, the poses don't depend on the frame rate
+        camera.setPose(path.sample(path.keyframes.front().time + std::fmod(f * timestep, period)));
+
+        glViewport(0, 0, windowSize.x, windowSize.y);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        {
+            Profiler::CpuScope scope("render");
+            cloud.render(camera);
+        }
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+        glFinish();
+
+        const auto now = std::chrono::steady_clock::now();
+        const double frame_ms = std::chrono::duration<double, std::milli>(now - last).count();
+        last = now;
+
+        // After glFinish, every query of the frame is resolved. They are all consumed, also during the warmup,
+        // a stage may run several times per frame.
+        Frame frame{frame_ms, std::vector<double>(GaussianCloud::OPERATIONS::NUM_OPS, 0.0)};
+        for(int i=0; i<GaussianCloud::OPERATIONS::NUM_OPS; i++){
+            int64_t ns = 0;
+            while(cloud.timers[i].getResultAndPopFrontIfAvailable(ns)){
+                frame.stage_ms[i] += double(ns) * 1.0E-6;
+            }
+        }
+        if(f >= options.warmup){
+            frames.push_back(std::move(frame));
+        }
+    }
+
+    // summary
+    std::vector<double> mean(GaussianCloud::OPERATIONS::NUM_OPS, 0.0);
+    double mean_frame = 0.0;
+    for(const Frame& frame : frames){
+        mean_frame += frame.frame_ms;
+        for(int i=0; i<GaussianCloud::OPERATIONS::NUM_OPS; i++){
+            mean[i] += frame.stage_ms[i];
+        }
+    }
+    const double n = std::max(size_t(1), frames.size());
+    std::cout << "Benchmark of " << sceneName() << " (" << options.mode << ", " << options.shLayout << " sh), " << frames.size() << " frames:" << std::endl;
+    std::cout << "frame: " << mean_frame / n << "ms" << std::endl;
+    for(int i=0; i<GaussianCloud::OPERATIONS::NUM_OPS; i++){
+        if(mean[i] > 0.0){
+            std::cout << stageNames[i] << ": " << mean[i] / n << "ms" << std::endl;
+        }
+    }
+
+    if(profiler){
+        profiler->newFrame(); // collects the last frame
+        if(profiler->exportChromeTrace(options.trace)){
+            std::cout << "Trace written to " << options.trace << std::endl;
+        }else{
+            std::cout << "Couldn't write " << options.trace << std::endl;
+        }
+    }
+
+    const bool written = jsonOutput() ? writeJSON(frames) : writeCSV(frames);
+    if(written){
+        std::cout << "Timings written to " << options.output << std::endl;
+    }else{
+        std::cout << "Couldn't write " << options.output << std::endl;
+    }
+    return written;
+}
+
+bool Benchmark::runSHSweep(GLFWwindow *window, GaussianCloud &cloud, Camera &camera) {
+    const int counts[] = {1000000, 2000000, 4000000, 6000000, 8000000, 10000000};
+
+    cloud.renderAsPoints = false;
+    cloud.renderAsQuads = true;
+    cloud.blending = GaussianCloud::HARDWARE_BLENDING;
+    cloud.dynamicResolution = false;
+    cloud.renderSize = options.size;
+    // every visible gaussian evaluates all the sh bands
+    cloud.colorCache = false;
+    cloud.shLod = false;
+
+    // the default camera sees the whole unit ball, every gaussian is visible
+    const glm::ivec2 windowSize = setupWindow(window, camera);
+
+    std::vector<SweepPoint> points;
+    for(int count : counts){
+        if(glfwWindowShouldClose(window)){
+            break;
+        }
+        PointCloudLoader::upload(cloud, PlyGaussians::synthetic(count, 1.0f), true);
+        if(!cloud.initialized){
+            throw std::string("Couldn't upload ") + std::to_string(count) + " synthetic gaussians";
+        }
+
+        // one frame for the visible gaussians and the inputs of the color kernels
+        glViewport(0, 0, windowSize.x, windowSize.y);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        cloud.render(camera);
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+        glFinish();
+        for(int i=0; i<GaussianCloud::OPERATIONS::NUM_OPS; i++){
+            int64_t ns = 0;
+            while(cloud.timers[i].getResultAndPopFrontIfAvailable(ns)){}
+        }
+
+        // both kernels write the same predicted colors, they are timed back to back on the same visible set
+        const SweepPoint p{count, cloud.num_visible_gaussians, cloud.timeColorKernel(false, 20), cloud.timeColorKernel(true, 20)};
+        std::cout << p.visible_gaussians << " visible gaussians: planar " << p.planar_ms << "ms, interleaved "
+                  << p.interleaved_ms << "ms" << std::endl;
+        points.push_back(p);
+    }
+
+    const bool written = jsonOutput() ? writeSweepJSON(points) : writeSweepCSV(points);
+    if(written){
+        std::cout << "Timings written to " << options.output << std::endl;
+    }else{
+        std::cout << "Couldn't write " << options.output << std::endl;
+    }
+    return written;
+}
+
+bool Benchmark::writeCSV(const std::vector<Frame> &frames) const {
+    std::ofstream file(options.output);
+    if(!file){
+        return false;
+    }
+    file << "frame,frame_ms";
+    for(const char* name : stageNames){
+        file << "," << name << "_ms";
+    }
+    file << "\n";
+    for(size_t f=0; f<frames.size(); f++){
+        file << f << "," << frames[f].frame_ms;
+        for(double ms : frames[f].stage_ms){
+            file << "," << ms;
+        }
+        file << "\n";
+    }
+    return bool(file);
+}
+
+static std::string escape(const std::string& s){
+    std::string e;
+    for(char c : s){
+        if(c == '"' || c == '\\'){
+            e += '\\';
+        }
+        e += c;
+    }
+    return e;
+}
+
+bool Benchmark::writeJSON(const std::vector<Frame> &frames) const {
+    std::ofstream file(options.output);
+    if(!file){
+        return false;
+    }
+    file << "{\n";
+    file << "  \"scene\": \"" << escape(sceneName()) << "\",\n";
+    file << "  \"camera_path\": \"" << escape(options.cameraPath) << "\",\n";
+    file << "  \"mode\": \"" << options.mode << "\",\n";
+    file << "  \"sh_layout\": \"" << options.shLayout << "\",\n";
+    file << "  \"warmup\": " << options.warmup << ",\n";
+    file << "  \"frames\": [\n";
+    for(size_t f=0; f<frames.size(); f++){
+        file << "    {\"frame\": " << f << ", \"frame_ms\": " << frames[f].frame_ms;
+        for(int i=0; i<GaussianCloud::OPERATIONS::NUM_OPS; i++){
+            file << ", \"" << stageNames[i] << "_ms\": " << frames[f].stage_ms[i];
+        }
+        file << (f + 1 < frames.size() ? "},\n" : "}\n");
+    }
+    file << "  ]\n}\n";
+    return bool(file);
+}
+
+bool Benchmark::writeSweepCSV(const std::vector<SweepPoint> &points) const {
+    std::ofstream file(options.output);
+    if(!file){
+        return false;
+    }
+    file << "gaussians,visible_gaussians,planar_ms,interleaved_ms\n";
+    for(const SweepPoint& p : points){
+        file << p.gaussians << "," << p.visible_gaussians << "," << p.planar_ms << "," << p.interleaved_ms << "\n";
+    }
+    return bool(file);
+}
+
+bool Benchmark::writeSweepJSON(const std::vector<SweepPoint> &points) const {
+    std::ofstream file(options.output);
+    if(!file){
+        return false;
+    }
+    file << "{\n";
+    file << "  \"sweep\": [\n";
+    for(size_t i=0; i<points.size(); i++){
+        const SweepPoint& p = points[i];
+        file << "    {\"gaussians\": " << p.gaussians << ", \"visible_gaussians\": " << p.visible_gaussians
+             << ", \"planar_ms\": " << p.planar_ms << ", \"interleaved_ms\": " << p.interleaved_ms;
+        file << (i + 1 < points.size() ? "},\n" : "}\n");
+    }
+    file << "  ]\n}\n";
+    return bool(file);
+}
@@ -0,0 +1,91 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_BENCHMARK_H
+#define HARDWARERASTERIZED3DGS_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+#include "glm/vec2.hpp"
+
+#include "CameraPath.h"
+
+class GaussianCloud;
+class Camera;
+struct GLFWwindow;
+
+/**
+ * Renders a scene along a camera path without the GUI, and writes the gpu time of each stage of the rendering
+ * for every frame, for the performance regression tracking:
+ * HardwareRasterized3DGS --benchmark --scene bicycle.ply [--camera-path path.txt] [--frames 300] [--warmup 30]
+ *                        [--fps 60] [--mode quads|interlock|points] [--size 1920x1080] [--output timings.csv|timings.json]
+ *                        [--trace trace.json]
+ * The camera path is sampled with a fixed timestep of 1/fps seconds per frame, looping over the path, so that the same
+ * poses are rendered on every run. Without a camera path, the camera orbits once around the origin over the frames.
+ * The window is hidden and the vsync is disabled. Each frame waits for the gpu, so that the timings of all the runs of
+ * its stages are read in the same frame.
+ * With --trace, the timeline of the recorded frames is also exported in the Chrome trace format (see Profiler).
+ * --synthetic N replaces the scene by N random gaussians in the unit ball (see PlyGaussians::synthetic), which are all
+ * visible from the default camera, and --sh-layout selects the color kernel (see GaussianCloud::interleavedSH).
+ * --sh-sweep times both color kernels on synthetic clouds of 1M to 10M visible gaussians instead of the camera path:
+ * HardwareRasterized3DGS --sh-sweep [--size 1920x1080] [--output sweep.csv|sweep.json]
+ */
+class Benchmark {
+public:
+    struct Options{
+        bool enabled = false;
+        std::string scene;
+        std::string cameraPath; // the default orbit when empty
+        int frames = 300; // recorded frames
+        int warmup = 30; // frames rendered before the recording
+        double fps = 60.0; // frames per second of the camera path
+        std::string mode = "quads";
+        glm::ivec2 size = glm::ivec2(0); // size of the rendering, the size of the window when 0
+        std::string output = "benchmark.csv"; // csv, or json when the extension is .json
+        std::string trace; // no trace when empty
+        int synthetic = 0; // number of synthetic gaussians instead of the scene when > 0
+        std::string shLayout = "planar"; // planar or interleaved
+        bool shSweep = false;
+    };
+
+    // Throws a std::string on invalid arguments. The benchmark is enabled by --benchmark, --scene, --synthetic or --sh-sweep.
+    static Options parse(int argc, char** argv);
+    // Whether the arguments enable the benchmark, without validating them. Before the creation of the window.
+    static bool isRequested(int argc, char** argv);
+
+    explicit Benchmark(Options options) : options(std::move(options)) {}
+
+    // Returns false when the output can't be written, throws a std::string when the scene can't be loaded.
+    bool run(GLFWwindow* window, GaussianCloud& cloud, Camera& camera);
+
+private:
+    struct Frame{
+        double frame_ms; // cpu time between two frames
+        std::vector<double> stage_ms; // gpu time of each stage of GaussianCloud, summed over its runs, 0 when it didn't run
+    };
+
+    struct SweepPoint{
+        int gaussians;
+        int visible_gaussians;
+        double planar_ms; // 16 threads per gaussian
+        double interleaved_ms; // 1 thread per gaussian
+    };
+
+    void load(GaussianCloud& cloud) const;
+    glm::ivec2 setupWindow(GLFWwindow* window, Camera& camera) const;
+    bool runSHSweep(GLFWwindow* window, GaussianCloud& cloud, Camera& camera);
+
+    bool writeCSV(const std::vector<Frame>& frames) const;
+    bool writeJSON(const std::vector<Frame>& frames) const;
+    bool writeSweepCSV(const std::vector<SweepPoint>& points) const;
+    bool writeSweepJSON(const std::vector<SweepPoint>& points) const;
+    bool jsonOutput() const;
+    std::string sceneName() const;
+
+    Options options;
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_BENCHMARK_H
@@ -0,0 +1,213 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "CameraPath.h"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numbers>
+#include <cmath>
+
+#include "GLFW/glfw3.h"
+#include "glm/glm.hpp"
+#include "imgui/imgui.h"
+#include "RenderingBase/ImGuiHelpers.h"
+
+using namespace glm;
+
+CameraPath CameraPath::load(const std::string &path) {
+    std::ifstream file(path);
+    if(!file){
+        throw std::string("Couldn't open the camera path ") + path;
+    }
+
+    CameraPath cameraPath;
+    std::string line;
+    int line_number = 0;
+    while(std::getline(file, line)){
+        line_number++;
+        if(line.empty() || line[0] == '#'){
+            continue;
+        }
+        std::istringstream ss(line);
+        Keyframe k{};
+        int freeCam = 0;
+        ss >> k.time >> freeCam >> k.pose.theta >> k.pose.phi >> k.pose.dist2lookPos
+           >> k.pose.lookPos.x >> k.pose.lookPos.y >> k.pose.lookPos.z
+           >> k.pose.camPos.x >> k.pose.camPos.y >> k.pose.camPos.z;
+        if(!ss){
+            throw std::string("Invalid keyframe at line ") + std::to_string(line_number) + " of " + path;
+        }
+        k.pose.freeCam = freeCam != 0;
+        cameraPath.keyframes.push_back(k);
+    }
+    if(cameraPath.keyframes.empty()){
+        throw std::string("The camera path ") + path + " has no keyframes";
+    }
+
+    std::stable_sort(cameraPath.keyframes.begin(), cameraPath.keyframes.end(), [](const Keyframe& a, const Keyframe& b){
+        return a.time < b.time;
+    });
+    return cameraPath;
+}
+
+void CameraPath::save(const std::string &path) const {
+    std::ofstream file(path);
+    if(!file){
+        throw std::string("Couldn't write the camera path ") + path;
+    }
+    file << "# time freeCam theta phi dist2lookPos lookPos.x lookPos.y lookPos.z camPos.x camPos.y camPos.z\n";
+    file << std::setprecision(9);
+    for(const Keyframe& k : keyframes){
+        const Camera::Pose& p = k.pose;
+        file << k.time << " " << int(p.freeCam) << " " << p.theta << " " << p.phi << " " << p.dist2lookPos << " "
+             << p.lookPos.x << " " << p.lookPos.y << " " << p.lookPos.z << " "
+             << p.camPos.x << " " << p.camPos.y << " " << p.camPos.z << "\n";
+    }
+    if(!file){
+        throw std::string("Couldn't write the camera path ") + path;
+    }
+}
+
+CameraPath CameraPath::orbit(const Camera::Pose &pose, int count, double timestep) {
+    CameraPath cameraPath;
+    for(int i=0; i<count; i++){
+        Keyframe k{double(i) * timestep, pose};
+        k.pose.freeCam = false;
+        k.pose.theta += 2.0f * float(std::numbers::pi) * float(i) / float(count);
+        cameraPath.keyframes.push_back(k);
+    }
+    return cameraPath;
+}
+
+double CameraPath::getDuration() const {
+    return keyframes.empty() ? 0.0 : keyframes.back().time - keyframes.front().time;
+}
+
+Camera::Pose CameraPath::sample(double time) const {
+    if(time <= keyframes.front().time){
+        return keyframes.front().pose;
+    }
+    if(time >= keyframes.back().time){
+        return keyframes.back().pose;
+    }
+    // first keyframe after the time
+    const auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time, [](double t, const Keyframe& k){
+        return t < k.time;
+    });
+    const Keyframe& a = *(next - 1);
+    const Keyframe& b = *next;
+    const double span = b.time - a.time;
+    const float t = span > 0.0 ? float((time - a.time) / span) : 0.0f;
+
+    Camera::Pose p = a.pose;
+    p.theta = mix(a.pose.theta, b.pose.theta, t);
+    p.phi = mix(a.pose.phi, b.pose.phi, t);
+    if(a.pose.dist2lookPos > 0.0f && b.pose.dist2lookPos > 0.0f){
+        p.dist2lookPos = a.pose.dist2lookPos * std::pow(b.pose.dist2lookPos / a.pose.dist2lookPos, t);
+    }else{
+        // the free camera keyframes may have no distance
+        p.dist2lookPos = mix(a.pose.dist2lookPos, b.pose.dist2lookPos, t);
+    }
+    p.lookPos = mix(a.pose.lookPos, b.pose.lookPos, t);
+    p.camPos = mix(a.pose.camPos, b.pose.camPos, t);
+    return p;
+}
+
+void CameraPathPlayer::update(Camera &camera) {
+    if(recording){
+        const double now = glfwGetTime();
+        if(path.keyframes.empty()){
+            recordStart = now;
+        }
+        path.keyframes.push_back({now - recordStart, camera.getPose()});
+        return;
+    }
+    if(!playing){
+        return;
+    }
+    if(path.keyframes.empty()){
+        playing = false;
+        return;
+    }
+
+    if(!fixedTimestep){
+        playbackTime = glfwGetTime() - playbackStart;
+    }
+    const double duration = path.getDuration();
+    if(playbackTime > duration){
+        if(loop && duration > 0.0){
+            playbackTime = std::fmod(playbackTime, duration);
+        }else{
+            playbackTime = duration;
+            playing = false;
+        }
+    }
+    camera.setPose(path.sample(path.keyframes.front().time + playbackTime));
+    if(fixedTimestep){
+        // the next frame is one timestep later, however long this one takes
+        playbackTime += timestep;
+    }
+}
+
+void CameraPathPlayer::GUI() {
+    if(!ImGui::TreeNode("Camera path")){
+        return;
+    }
+
+    ImGui::InputText("File", filePath, sizeof(filePath));
+    if(ImGui::Button("Load")){
+        try{
+            path = CameraPath::load(filePath);
+            recording = playing = false;
+        }catch(const std::string& e){
+            std::cout << e << std::endl;
+        }
+    }
+    ImGui::SameLine();
+    if(ImGui::Button("Save") && !path.keyframes.empty()){
+        try{
+            path.save(filePath);
+        }catch(const std::string& e){
+            std::cout << e << std::endl;
+        }
+    }
+    HelpMarker("One keyframe per line: time freeCam theta phi dist2lookPos lookPos camPos. "
+               "The same files are played by the command line benchmark (--camera-path).");
+
+    if(ImGui::Button(recording ? "Stop recording" : "Record")){
+        recording = !recording;
+        playing = false;
+        if(recording){
+            path.keyframes.clear();
+        }
+    }
+    HelpMarker("Records the pose of the camera at each frame, with the time since the first frame.");
+    ImGui::SameLine();
+    if(ImGui::Button(playing ? "Stop" : "Play") && !path.keyframes.empty()){
+        playing = !playing;
+        recording = false;
+        playbackStart = glfwGetTime();
+        playbackTime = 0.0;
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Loop", &loop);
+
+    ImGui::Checkbox("Fixed timestep", &fixedTimestep);
+    HelpMarker("Each frame advances the path by the timestep instead of the elapsed time, "
+               "so that the same poses are rendered whatever the frame rate.");
+    if(fixedTimestep){
+        ImGui::SliderFloat("Timestep", &timestep, 1.0f / 240.0f, 0.1f, "%.4fs", ImGuiSliderFlags_Logarithmic);
+    }
+
+    ImGui::Text("%d keyframes, %.2fs", int(path.keyframes.size()), path.getDuration());
+    if(playing){
+        ImGui::Text("Playing: %.2fs", playbackTime);
+    }
+
+    ImGui::TreePop();
+}
@@ -0,0 +1,77 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_CAMERAPATH_H
+#define HARDWARERASTERIZED3DGS_CAMERAPATH_H
+
+#include <string>
+#include <vector>
+
+#include "RenderingBase/Camera.h"
+
+/**
+ * A sequence of camera poses with their timestamps, read from a text file with one keyframe per line:
+ * time freeCam theta phi dist2lookPos lookPos.x lookPos.y lookPos.z camPos.x camPos.y camPos.z
+ * The time is in seconds, the lines starting with # are comments.
+ */
+class CameraPath {
+public:
+    struct Keyframe{
+        double time;
+        Camera::Pose pose;
+    };
+    std::vector<Keyframe> keyframes; // sorted by time
+
+    // Throws a std::string on error.
+    static CameraPath load(const std::string& path);
+    // Throws a std::string on error.
+    void save(const std::string& path) const;
+
+    // The orbit of count views around the look-at point of the pose, timestep seconds apart
+    static CameraPath orbit(const Camera::Pose& pose, int count, double timestep);
+
+    // time of the last keyframe minus time of the first one
+    double getDuration() const;
+
+    /**
+     * The pose at the given time, interpolated between the two keyframes around it: linearly for the angles and
+     * positions, geometrically for the distance to the look-at point
+     * (linearly when one of the distances isn't positive). The camera mode is the one of the keyframe before.
+     * Clamped to the first and last keyframes.
+     */
+    Camera::Pose sample(double time) const;
+};
+
+/**
+ * Records the poses of the camera at each frame, and plays a path back, either in real time or with a fixed timestep
+ * per frame, so that the same frames are rendered whatever the frame rate.
+ */
+class CameraPathPlayer {
+public:
+    void GUI();
+
+    // Called once per frame after the inputs: records the pose of the camera, or overrides it during the playback.
+    void update(Camera& camera);
+
+    bool isPlaying() const{
+        return playing;
+    }
+
+private:
+    CameraPath path;
+    char filePath[256] = "camera_path.txt";
+
+    bool recording = false;
+    double recordStart = 0.0; // glfwGetTime at the first recorded frame
+
+    bool playing = false;
+    bool loop = false;
+    bool fixedTimestep = true;
+    float timestep = 1.0f / 60.0f; // seconds of the path per frame
+    double playbackStart = 0.0; // glfwGetTime at the first played frame, in real time
+    double playbackTime = 0.0; // since the first keyframe
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_CAMERAPATH_H
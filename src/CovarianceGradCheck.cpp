@@ -0,0 +1,276 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+// Checks the backward functions of Covariance.h (quat2mat_bwd, computeCov3D_bwd, computeCov2D_bwd) against
+// central finite differences of the forward functions on random inputs, then measures their throughput.
+// Each check uses a scalar loss made of random weights applied to the outputs of the forward function.
+// Usage: Covariance_gradcheck [num_samples] [min_time_seconds]
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+#include "../resources/shaders/common/Covariance.h"
+
+using namespace glm;
+
+struct Sample{
+    vec3 scale;
+    vec4 q;
+    mat3 viewMat;
+    mat3 cov3D; // view space covariance of the gaussian
+    vec3 mean; // view space, in front of the camera
+    float focal_x;
+    float focal_y;
+
+    // weights of the scalar losses
+    mat3 dLoss_dR;
+    float dLoss_dcov3D[6];
+    vec3 dLoss_dcov2D;
+};
+
+// Random gaussians with the same activations as the ply files, seen by a camera with the focal of a 1080p screen.
+static Sample makeSample(std::mt19937& rng){
+    std::uniform_real_distribution<float> U(-1.0f, 1.0f);
+    std::normal_distribution<float> N(0.0f, 1.0f);
+
+    Sample s;
+    s.scale = vec3(exp(N(rng) - 3.0f), exp(N(rng) - 3.0f), exp(N(rng) - 3.0f));
+    s.q = normalize(vec4(N(rng), N(rng), N(rng), N(rng)));
+    s.viewMat = quat2mat(normalize(vec4(N(rng), N(rng), N(rng), N(rng))));
+    s.cov3D = computeCov3D(s.scale, 1.0f, s.q, s.viewMat);
+    const float z = 0.5f + 9.5f * (U(rng) * 0.5f + 0.5f);
+    s.mean = vec3(U(rng) * z * 0.8f, U(rng) * z * 0.45f, z);
+    s.focal_y = 1080.0f / (2.0f * tan(radians(45.0f) / 2.0f)) * (1.0f + 0.2f * U(rng));
+    s.focal_x = s.focal_y * (1.0f + 0.1f * U(rng));
+
+    s.dLoss_dR = mat3(U(rng), U(rng), U(rng), U(rng), U(rng), U(rng), U(rng), U(rng), U(rng));
+    for(float& w : s.dLoss_dcov3D){
+        w = U(rng);
+    }
+    s.dLoss_dcov2D = vec3(U(rng), U(rng), U(rng));
+    return s;
+}
+
+// Unique values of a symmetric matrix, in the order of dLoss_dcov3D.
+static const int sym_i[6] = {0, 0, 0, 1, 1, 2};
+static const int sym_j[6] = {0, 1, 2, 1, 2, 2};
+
+static double weightedSum(const mat3& m, const float w[6]){
+    double sum = 0.0;
+    for(int k=0; k<6; k++){
+        sum += double(w[k]) * double(m[sym_i[k]][sym_j[k]]);
+    }
+    return sum;
+}
+
+static double weightedSum(const mat3& m, const mat3& w){
+    double sum = 0.0;
+    for(int i=0; i<3; i++){
+        for(int j=0; j<3; j++){
+            sum += double(w[i][j]) * double(m[i][j]);
+        }
+    }
+    return sum;
+}
+
+// Central difference of the loss with respect to x, with a step relative to the magnitude of x.
+// The forward functions are evaluated in single precision, which requires a large step to keep the rounding
+// errors small, so the truncation error is cancelled with a Richardson extrapolation of two steps.
+static double finiteDifference(const std::function<double(float)>& loss, float x, float scale){
+    const auto centralDifference = [&](float h){
+        const float xp = x + h;
+        const float xm = x - h;
+        return (loss(xp) - loss(xm)) / double(xp - xm);
+    };
+    const float h = 1.0E-2f * std::max(std::abs(x), scale);
+    return (4.0 * centralDifference(0.5f * h) - centralDifference(h)) / 3.0;
+}
+
+// Largest error among the derivatives of a sample, relative to the largest derivative so that the components
+// close to zero don't blow up the ratio.
+struct ErrorStats{
+    double max_error = 0.0;
+    double sum_error = 0.0;
+    int samples = 0;
+
+    void add(const double* analytical, const double* numerical, int count){
+        double scale = 0.0;
+        for(int k=0; k<count; k++){
+            scale = std::max({scale, std::abs(analytical[k]), std::abs(numerical[k])});
+        }
+        double error = 0.0;
+        for(int k=0; k<count; k++){
+            const double e = std::abs(analytical[k] - numerical[k]) / std::max(scale, 1.0E-30);
+            error = std::isnan(e) ? INFINITY : std::max(error, e);
+        }
+        max_error = std::max(max_error, error);
+        sum_error += error;
+        samples++;
+    }
+};
+
+static void checkQuat2mat(const Sample& s, ErrorStats& stats){
+    const vec4 dLoss_dq = quat2mat_bwd(s.q, s.dLoss_dR);
+
+    // quat2mat_bwd projects the derivative on the tangent plane of the unit sphere,
+    // which is the derivative of quat2mat(normalize(q))
+    double analytical[4], numerical[4];
+    for(int k=0; k<4; k++){
+        analytical[k] = dLoss_dq[k];
+        numerical[k] = finiteDifference([&](float x){
+            vec4 q = s.q;
+            q[k] = x;
+            return weightedSum(quat2mat(normalize(q)), s.dLoss_dR);
+        }, s.q[k], 1.0f);
+    }
+    stats.add(analytical, numerical, 4);
+}
+
+static void checkCov3D(const Sample& s, ErrorStats& stats_scale, ErrorStats& stats_rot){
+    const Cov3DGradients grad = computeCov3D_bwd(s.scale, s.q, s.viewMat, s.dLoss_dcov3D);
+
+    double analytical[4], numerical[4];
+    for(int k=0; k<3; k++){
+        analytical[k] = grad.dLoss_dscale[k];
+        numerical[k] = finiteDifference([&](float x){
+            vec3 scale = s.scale;
+            scale[k] = x;
+            return weightedSum(computeCov3D(scale, 1.0f, s.q, s.viewMat), s.dLoss_dcov3D);
+        }, s.scale[k], 0.0f);
+    }
+    stats_scale.add(analytical, numerical, 3);
+
+    for(int k=0; k<4; k++){
+        analytical[k] = grad.dLoss_drot[k];
+        numerical[k] = finiteDifference([&](float x){
+            vec4 q = s.q;
+            q[k] = x;
+            return weightedSum(computeCov3D(s.scale, 1.0f, normalize(q), s.viewMat), s.dLoss_dcov3D);
+        }, s.q[k], 1.0f);
+    }
+    stats_rot.add(analytical, numerical, 4);
+}
+
+static void checkCov2D(const Sample& s, ErrorStats& stats_mean, ErrorStats& stats_cov3D){
+    const mat3 cov3D = s.cov3D;
+    const Cov2DGradients grad = computeCov2D_bwd(s.mean, s.focal_x, s.focal_y, cov3D, s.dLoss_dcov2D);
+
+    const auto loss = [&](const vec3& mean, const mat3& cov){
+        const vec3 cov2D = computeCov2D(mean, s.focal_x, s.focal_y, cov);
+        return dot(dvec3(s.dLoss_dcov2D), dvec3(cov2D));
+    };
+
+    double analytical[6], numerical[6];
+    for(int k=0; k<3; k++){
+        analytical[k] = grad.dLoss_dmean[k];
+        numerical[k] = finiteDifference([&](float x){
+            vec3 mean = s.mean;
+            mean[k] = x;
+            return loss(mean, cov3D);
+        }, s.mean[k], s.mean.z);
+    }
+    stats_mean.add(analytical, numerical, 3);
+
+    // the off-diagonal derivatives are with respect to a single value of the symmetric matrix,
+    // so both copies are perturbed together
+    const float cov_scale = std::max({cov3D[0][0], cov3D[1][1], cov3D[2][2]});
+    for(int k=0; k<6; k++){
+        const int i = sym_i[k], j = sym_j[k];
+        analytical[k] = grad.dLoss_dcov3D[i][j];
+        numerical[k] = finiteDifference([&](float x){
+            mat3 cov = cov3D;
+            cov[i][j] = x;
+            cov[j][i] = x;
+            return loss(s.mean, cov);
+        }, cov3D[i][j], cov_scale);
+    }
+    stats_cov3D.add(analytical, numerical, 6);
+}
+
+template<typename F>
+static void runBenchmark(const char* name, const std::vector<Sample>& samples, double min_time, F f){
+    float sink = 0.0f;
+    for(const Sample& s : samples){
+        sink += f(s); // warmup
+    }
+
+    long long iterations = 0;
+    double elapsed = 0.0;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    while(elapsed < min_time){
+        for(const Sample& s : samples){
+            sink += f(s);
+        }
+        iterations++;
+        elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+
+    const double calls = double(iterations) * double(samples.size());
+    printf("%-32s %14.2f ns %12lld %16.3fM items/s%s\n", name, elapsed * 1.0E9 / calls, iterations,
+           calls / elapsed * 1.0E-6, std::isnan(sink) ? " (nan)" : "");
+}
+
+int main(int argc, char* argv[]){
+    const int num_samples = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const double min_time = argc > 2 ? std::atof(argv[2]) : 0.5;
+
+    std::mt19937 rng(42);
+    std::vector<Sample> samples;
+    samples.reserve(num_samples);
+    for(int n=0; n<num_samples; n++){
+        samples.push_back(makeSample(rng));
+    }
+
+    ErrorStats quat2mat_dq, cov3D_dscale, cov3D_drot, cov2D_dmean, cov2D_dcov3D;
+    for(const Sample& s : samples){
+        checkQuat2mat(s, quat2mat_dq);
+        checkCov3D(s, cov3D_dscale, cov3D_drot);
+        checkCov2D(s, cov2D_dmean, cov2D_dcov3D);
+    }
+
+    // The rounding errors of the forward functions limit the accuracy of the finite differences:
+    // for needle-like gaussians, the derivatives with respect to the small axes are a few orders of magnitude
+    // below the covariance, and the error of a few samples reaches 1e-2. A wrong derivative fails on most samples.
+    const double max_tolerance = 5.0E-2;
+    const double mean_tolerance = 1.0E-3;
+    const std::pair<const char*, const ErrorStats*> checks[] = {
+            {"quat2mat_bwd dLoss_dq", &quat2mat_dq},
+            {"computeCov3D_bwd dLoss_dscale", &cov3D_dscale},
+            {"computeCov3D_bwd dLoss_drot", &cov3D_drot},
+            {"computeCov2D_bwd dLoss_dmean", &cov2D_dmean},
+            {"computeCov2D_bwd dLoss_dcov3D", &cov2D_dcov3D},
+    };
+
+    bool ok = true;
+    printf("Finite differences against the backward functions of Covariance.h, %d samples\n", num_samples);
+    for(const auto& [name, stats] : checks){
+        const double mean_error = stats->sum_error / std::max(stats->samples, 1);
+        const bool pass = stats->max_error <= max_tolerance && mean_error <= mean_tolerance;
+        ok = ok && pass;
+        printf("    %-30s max relative error %.3e (tolerance %.0e), mean %.3e (tolerance %.0e) %s\n", name,
+               stats->max_error, max_tolerance, mean_error, mean_tolerance, pass ? "ok" : "FAILED");
+    }
+    printf("\n");
+
+    printf("%-32s %17s %12s %25s\n", "Benchmark", "Time", "Iterations", "Throughput");
+    printf("------------------------------------------------------------------------------------------\n");
+    runBenchmark("quat2mat_bwd", samples, min_time, [](const Sample& s){
+        return quat2mat_bwd(s.q, s.dLoss_dR).x;
+    });
+    runBenchmark("computeCov3D_bwd", samples, min_time, [](const Sample& s){
+        return computeCov3D_bwd(s.scale, s.q, s.viewMat, s.dLoss_dcov3D).dLoss_drot.x;
+    });
+    runBenchmark("computeCov2D_bwd", samples, min_time, [](const Sample& s){
+        return computeCov2D_bwd(s.mean, s.focal_x, s.focal_y, s.cov3D, s.dLoss_dcov2D).dLoss_dmean.x;
+    });
+
+    return ok ? 0 : 1;
+}
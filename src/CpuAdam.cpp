@@ -0,0 +1,133 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "CpuAdam.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "glm/glm.hpp"
+
+using namespace glm;
+
+namespace {
+
+    struct AdamStep{
+        double beta1, beta2, epsilon;
+        double bias_correction1, bias_correction2;
+
+        // updates the moments in place and returns the step to subtract from the parameter
+        double operator()(double grad, float& m, float& v, double lr) const{
+            const double new_m = beta1 * double(m) + (1.0 - beta1) * grad;
+            const double new_v = beta2 * double(v) + (1.0 - beta2) * grad * grad;
+            m = float(new_m);
+            v = float(new_v);
+            return lr * (new_m / bias_correction1) / (std::sqrt(new_v / bias_correction2) + epsilon);
+        }
+    };
+
+    // largest component of the difference between a and b, and largest component of reference
+    template<typename V>
+    void maxDifference(const V& a, const V& b, const V& reference, double& diff, double& scale){
+        for(int k=0; k<V::length(); k++){
+            diff = std::max(diff, std::abs(double(a[k]) - double(b[k])));
+            scale = std::max(scale, std::abs(double(reference[k])));
+        }
+    }
+
+    template<typename V>
+    float compareUpdates(const std::vector<V>& before, const std::vector<V>& a, const std::vector<V>& b){
+        double diff = 0.0;
+        double scale = 0.0;
+        for(size_t i=0; i<before.size(); i++){
+            maxDifference(V(a[i] - before[i]), V(b[i] - before[i]), V(b[i] - before[i]), diff, scale);
+        }
+        return float(diff / std::max(scale, 1.0E-30));
+    }
+
+    template<typename V>
+    float compareMoments(const std::vector<V>& a, const std::vector<V>& b){
+        double diff = 0.0;
+        double scale = 0.0;
+        for(size_t i=0; i<a.size(); i++){
+            maxDifference(a[i], b[i], b[i], diff, scale);
+        }
+        return float(diff / std::max(scale, 1.0E-30));
+    }
+
+}
+
+void CpuAdam::step(const AdamSettings &settings, int t, CpuAdam::Parameters &params,
+                   const CpuAdam::Gradients &grads, CpuAdam::Moments &moments) {
+    const AdamStep adam = {
+            settings.beta1, settings.beta2, settings.epsilon,
+            1.0 - std::pow(double(settings.beta1), t), 1.0 - std::pow(double(settings.beta2), t)
+    };
+
+    const int count = int(params.positions.size());
+    for(int n=0; n<count; n++){
+        for(int k=0; k<3; k++){
+            vec4& m = moments.positions[n * 2 + 0];
+            vec4& v = moments.positions[n * 2 + 1];
+            params.positions[n][k] -= float(adam(grads.positions[n][k], m[k], v[k], settings.lr_positions));
+        }
+
+        for(int k=0; k<3; k++){
+            vec4& m = moments.scales[n * 2 + 0];
+            vec4& v = moments.scales[n * 2 + 1];
+            const double scale = params.scales[n][k];
+            const double dLoss_dlog_scale = double(grads.scales[n][k]) * scale;
+            params.scales[n][k] = float(scale * std::exp(-adam(dLoss_dlog_scale, m[k], v[k], settings.lr_scales)));
+        }
+
+        dvec4 rotation = params.rotations[n];
+        for(int k=0; k<4; k++){
+            vec4& m = moments.rotations[n * 2 + 0];
+            vec4& v = moments.rotations[n * 2 + 1];
+            rotation[k] -= adam(grads.rotations[n][k], m[k], v[k], settings.lr_rotations);
+        }
+        params.rotations[n] = vec4(normalize(rotation));
+
+        {
+            vec2& mv = moments.opacities[n];
+            const double opacity = std::clamp(double(params.opacities[n]), 1.0E-6, 1.0 - 1.0E-6);
+            const double dLoss_dlogit = double(grads.opacities[n]) * opacity * (1.0 - opacity);
+            const double logit = std::log(opacity / (1.0 - opacity)) - adam(dLoss_dlogit, mv.x, mv.y, settings.lr_opacities);
+            params.opacities[n] = float(1.0 / (1.0 + std::exp(-logit)));
+        }
+
+        // the coefficient j of the interleaved layout is the color channel j % 3 of the coefficient j / 3
+        for(int j=0; j<SH_VEC4 * 4; j++){
+            vec4& m = moments.sh[n * SH_VEC4 * 2 + j / 4];
+            vec4& v = moments.sh[n * SH_VEC4 * 2 + SH_VEC4 + j / 4];
+            const double grad = grads.sh_coeffs[j % 3][n * 16 + j / 3];
+            const double lr = j < 3 ? settings.lr_sh_dc : settings.lr_sh_rest;
+            params.sh_coeffs_interleaved[n * SH_VEC4 + j / 4][j % 4] -= float(adam(grad, m[j % 4], v[j % 4], lr));
+        }
+    }
+}
+
+CpuAdam::Difference CpuAdam::compare(const CpuAdam::Parameters &before, const CpuAdam::Parameters &a,
+                                     const CpuAdam::Parameters &b, const CpuAdam::Moments &moments_a,
+                                     const CpuAdam::Moments &moments_b) {
+    Difference d;
+    d.positions = compareUpdates(before.positions, a.positions, b.positions);
+    d.scales = compareUpdates(before.scales, a.scales, b.scales);
+    d.rotations = compareUpdates(before.rotations, a.rotations, b.rotations);
+    d.sh = compareUpdates(before.sh_coeffs_interleaved, a.sh_coeffs_interleaved, b.sh_coeffs_interleaved);
+
+    std::vector<vec1> opacities_before(before.opacities.begin(), before.opacities.end());
+    std::vector<vec1> opacities_a(a.opacities.begin(), a.opacities.end());
+    std::vector<vec1> opacities_b(b.opacities.begin(), b.opacities.end());
+    d.opacities = compareUpdates(opacities_before, opacities_a, opacities_b);
+
+    d.moments = std::max({
+        compareMoments(moments_a.positions, moments_b.positions),
+        compareMoments(moments_a.scales, moments_b.scales),
+        compareMoments(moments_a.rotations, moments_b.rotations),
+        compareMoments(moments_a.opacities, moments_b.opacities),
+        compareMoments(moments_a.sh, moments_b.sh)
+    });
+    return d;
+}
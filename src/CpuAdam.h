@@ -0,0 +1,82 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_CPUADAM_H
+#define HARDWARERASTERIZED3DGS_CPUADAM_H
+
+#include <vector>
+
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+
+// Hyperparameters of the Adam optimizer, the learning rates are per group of parameters.
+// The default values are the ones of the 3DGS paper.
+struct AdamSettings{
+    float lr_positions = 1.6E-4f;
+    float lr_scales = 5.0E-3f; // step on log(scale)
+    float lr_rotations = 1.0E-3f;
+    float lr_opacities = 5.0E-2f; // step on logit(opacity)
+    float lr_sh_dc = 2.5E-3f;
+    float lr_sh_rest = 1.25E-4f;
+    float beta1 = 0.9f;
+    float beta2 = 0.999f;
+    float epsilon = 1.0E-15f;
+};
+
+/**
+ * Cpu reference of adamStep.cp, in double precision, used to validate the optimizer on the gpu.
+ * The buffers have the same content and layout as the buffers of GaussianCloud.
+ */
+class CpuAdam {
+public:
+    static const int SH_VEC4 = 12; // SH_INTERLEAVED_VEC4 of SphericalHarmonics.h
+
+    struct Parameters{
+        std::vector<glm::vec4> positions;
+        std::vector<glm::vec4> scales; // after the activation
+        std::vector<glm::vec4> rotations;
+        std::vector<float> opacities; // after the activation
+        std::vector<glm::vec4> sh_coeffs_interleaved; // SH_VEC4 per gaussian
+    };
+
+    struct Gradients{
+        std::vector<glm::vec4> positions;
+        std::vector<glm::vec4> scales; // with respect to the scales after the activation
+        std::vector<glm::vec4> rotations;
+        std::vector<float> opacities; // with respect to the opacities after the activation
+        std::vector<float> sh_coeffs[3]; // planar layout, 16 per gaussian for each color channel
+    };
+
+    struct Moments{
+        std::vector<glm::vec4> positions; // (first, second) for each gaussian
+        std::vector<glm::vec4> scales;
+        std::vector<glm::vec4> rotations;
+        std::vector<glm::vec2> opacities;
+        std::vector<glm::vec4> sh; // SH_VEC4 first moments then SH_VEC4 second moments for each gaussian
+    };
+
+    // largest difference between the updates of two optimizers, relative to the largest update of each group
+    struct Difference{
+        float positions = 0.0f;
+        float scales = 0.0f;
+        float rotations = 0.0f;
+        float opacities = 0.0f;
+        float sh = 0.0f;
+        float moments = 0.0f; // largest difference between the moments, relative to the largest moment of each buffer
+    };
+
+    /**
+     * Same step as adamStep.cp on all the gaussians, t is the index of the step, starting at 1.
+     */
+    static void step(const AdamSettings& settings, int t, Parameters& params, const Gradients& grads, Moments& moments);
+
+    /**
+     * Compares the updates from before to a and from before to b, and the moments after the updates.
+     */
+    static Difference compare(const Parameters& before, const Parameters& a, const Parameters& b,
+                              const Moments& moments_a, const Moments& moments_b);
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_CPUADAM_H
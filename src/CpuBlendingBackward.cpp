@@ -0,0 +1,127 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "CpuBlendingBackward.h"
+
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+
+#include "glm/glm.hpp"
+
+using namespace glm;
+
+CpuBlendingBackward::Gradients CpuBlendingBackward::compute(const Splats &splats, const std::vector<vec4> &final_image,
+                                                            const std::vector<vec4> &target, int width, int height,
+                                                            int proxy_sides, float min_opacity) {
+    const int count = int(splats.bounding_boxes.size());
+    Gradients g;
+    g.dLoss_dpredicted_colors.assign(count, dvec4(0.0));
+    g.dLoss_dconic_opacity.assign(count, dvec4(0.0));
+    g.dLoss_dmean2D.assign(count, dvec2(0.0));
+
+    // state of the blending of each pixel: accumulated color and transmittance, same as the backward image
+    std::vector<dvec4> state(size_t(width) * size_t(height), dvec4(0.0, 0.0, 0.0, 1.0));
+
+    // normals of the sides of the proxy polygon, see SplatProxy.h
+    const double PI = std::numbers::pi;
+    const double circumradius = 1.0 / std::cos(PI / proxy_sides);
+    std::vector<dvec2> normals(proxy_sides);
+    for(int k=0; k<proxy_sides; k++){
+        normals[k] = dvec2(std::cos(2.0 * PI * k / proxy_sides), std::sin(2.0 * PI * k / proxy_sides));
+    }
+
+    for(int i=0; i<count; i++){
+        const dvec2 center = dvec2(vec2(splats.bounding_boxes[i]));
+        const dvec2 half_extent = dvec2(splats.bounding_boxes[i].z, splats.bounding_boxes[i].w);
+        const dvec2 dir = dvec2(splats.eigen_vecs[i]);
+        const dvec2 dir_minor = dvec2(-dir.y, dir.x);
+        const dvec4 conic_opacity = dvec4(splats.conic_opacity[i]);
+        const dvec3 color = dvec3(splats.predicted_colors[i]);
+        const dmat2 cov2D = dmat2(conic_opacity.x, conic_opacity.y, conic_opacity.y, conic_opacity.z);
+        const double opacity = conic_opacity.w;
+
+        // pixels overlapped by the polygon
+        const dvec2 extent = circumradius * dvec2(half_extent.x * std::abs(dir.x) + half_extent.y * std::abs(dir.y),
+                                                  half_extent.x * std::abs(dir.y) + half_extent.y * std::abs(dir.x));
+        const int x0 = std::max(0, int(std::floor(center.x - extent.x)));
+        const int y0 = std::max(0, int(std::floor(center.y - extent.y)));
+        const int x1 = std::min(width - 1, int(std::ceil(center.x + extent.x)));
+        const int y1 = std::min(height - 1, int(std::ceil(center.y + extent.y)));
+
+        for(int y=y0; y<=y1; y++){
+            for(int x=x0; x<=x1; x++){
+                const dvec2 local_coord = dvec2(x + 0.5, y + 0.5) - center;
+
+                // rasterized when the center of the pixel is inside the polygon
+                const dvec2 corner = dvec2(dot(local_coord, dir) / half_extent.x, dot(local_coord, dir_minor) / half_extent.y);
+                bool inside = true;
+                for(const dvec2& n : normals){
+                    inside = inside && dot(corner, n) <= 1.0;
+                }
+                if(!inside){
+                    continue;
+                }
+
+                // same as quad_interlock_bwd.fs
+                const double power = -0.5 * dot(local_coord, cov2D * local_coord);
+                if(power > 0.0){
+                    continue;
+                }
+                const double expPower = std::exp(power);
+                const double alpha = std::min(0.99, opacity * expPower);
+                if(alpha < min_opacity){
+                    continue;
+                }
+
+                const size_t p = size_t(y) * width + x;
+                const dvec3 finalColor = dvec3(vec3(final_image[p]));
+                const dvec3 gtColor = dvec3(vec3(target[p]));
+                const dvec3 dLoss_dFinalColor = 2.0 * (finalColor - gtColor);
+
+                const double partial_transmittance = state[p].w;
+                const dvec3 partial_color = dvec3(state[p]) + color * partial_transmittance * alpha;
+                state[p] = dvec4(partial_color, partial_transmittance * (1.0 - alpha));
+
+                const double dLoss_dalpha = dot(dLoss_dFinalColor, color) * partial_transmittance
+                        - dot(dLoss_dFinalColor, finalColor - partial_color) / (1.0 - alpha);
+                g.dLoss_dpredicted_colors[i] += dvec4(dLoss_dFinalColor * partial_transmittance * alpha, 0.0);
+
+                if(alpha < 0.99){
+                    const double dLoss_dopacity = dLoss_dalpha * expPower;
+                    const double dLoss_dpower = dLoss_dalpha * alpha;
+                    const dvec3 dLoss_dconic = -0.5 * dLoss_dpower * dvec3(local_coord.x * local_coord.x,
+                                                                           2.0 * local_coord.x * local_coord.y,
+                                                                           local_coord.y * local_coord.y);
+                    g.dLoss_dconic_opacity[i] += dvec4(dLoss_dconic, dLoss_dopacity);
+                    g.dLoss_dmean2D[i] += dLoss_dpower * (cov2D * local_coord);
+                }
+            }
+        }
+    }
+    return g;
+}
+
+template<typename R, typename V>
+static double relativeError(const std::vector<R>& reference, const std::vector<V>& values, int components){
+    double error = 0.0, norm = 0.0;
+    for(size_t i=0; i<reference.size(); i++){
+        for(int k=0; k<components; k++){
+            const double d = double(values[i][k]) - reference[i][k];
+            error += d * d;
+            norm += reference[i][k] * reference[i][k];
+        }
+    }
+    return norm > 0.0 ? std::sqrt(error / norm) : std::sqrt(error);
+}
+
+CpuBlendingBackward::Error CpuBlendingBackward::compare(const Gradients &reference, const std::vector<vec4> &dLoss_dpredicted_colors,
+                                                        const std::vector<vec4> &dLoss_dconic_opacity,
+                                                        const std::vector<vec2> &dLoss_dmean2D) {
+    Error e;
+    e.colors = relativeError(reference.dLoss_dpredicted_colors, dLoss_dpredicted_colors, 3);
+    e.conic_opacity = relativeError(reference.dLoss_dconic_opacity, dLoss_dconic_opacity, 4);
+    e.mean2D = relativeError(reference.dLoss_dmean2D, dLoss_dmean2D, 2);
+    return e;
+}
@@ -0,0 +1,53 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_CPUBLENDINGBACKWARD_H
+#define HARDWARERASTERIZED3DGS_CPUBLENDINGBACKWARD_H
+
+#include <vector>
+
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+
+/**
+ * Double precision reference of quad_interlock_bwd.fs: derivatives of the loss with respect to the 2D splats of a view,
+ * from the same inputs as the gpu. Used to measure the error of the accumulation modes of the gradients (GRADIENTS_*).
+ * The splats are blended front to back, each one covers the pixels whose center is inside its proxy polygon.
+ */
+class CpuBlendingBackward {
+public:
+    // the visible gaussians in the depth order, same content as the buffers of GaussianCloud
+    struct Splats{
+        std::vector<glm::vec4> bounding_boxes;
+        std::vector<glm::vec2> eigen_vecs;
+        std::vector<glm::vec4> conic_opacity;
+        std::vector<glm::vec4> predicted_colors;
+    };
+
+    // same layout as dLoss_dpredicted_colors, dLoss_dconic_opacity and dLoss_dmean2D
+    struct Gradients{
+        std::vector<glm::dvec4> dLoss_dpredicted_colors;
+        std::vector<glm::dvec4> dLoss_dconic_opacity;
+        std::vector<glm::dvec2> dLoss_dmean2D;
+    };
+
+    /**
+     * final_image is the output of the forward pass and target the ground truth, width x height pixels each,
+     * with the first row at the bottom.
+     */
+    static Gradients compute(const Splats& splats, const std::vector<glm::vec4>& final_image, const std::vector<glm::vec4>& target,
+                             int width, int height, int proxy_sides, float min_opacity);
+
+    // Relative L2 error of each gradient over all the splats: |gpu - reference| / |reference|
+    struct Error{
+        double colors = 0.0;
+        double conic_opacity = 0.0;
+        double mean2D = 0.0;
+    };
+    static Error compare(const Gradients& reference, const std::vector<glm::vec4>& dLoss_dpredicted_colors,
+                         const std::vector<glm::vec4>& dLoss_dconic_opacity, const std::vector<glm::vec2>& dLoss_dmean2D);
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_CPUBLENDINGBACKWARD_H
@@ -0,0 +1,122 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "CpuDensification.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "../resources/shaders/common/Densification.h"
+
+using namespace glm;
+
+CpuDensification::Result CpuDensification::mark(const DensificationSettings &settings,
+                                                const CpuAdam::Parameters &params, const std::vector<vec2> &stats) {
+    const int count = int(params.positions.size());
+    Result result;
+    result.kinds.resize(count);
+    for(int n=0; n<count; n++){
+        const int kind = getDensifyKind(vec3(params.scales[n]), params.opacities[n], stats[n], settings.grad_threshold,
+                                        settings.split_scale, settings.prune_opacity, settings.prune_scale);
+        result.kinds[n] = kind;
+        result.kind_counts[kind]++;
+        for(int child=0; child<getDensifyCount(kind); child++){
+            result.sources.emplace_back(n, child);
+        }
+    }
+    return result;
+}
+
+void CpuDensification::scatter(const DensificationSettings &settings, const CpuDensification::Result &result,
+                               const CpuAdam::Parameters &params, const CpuAdam::Moments &moments,
+                               CpuAdam::Parameters &out_params, CpuAdam::Moments &out_moments) {
+    const size_t count = result.sources.size();
+    const int SH_VEC4 = CpuAdam::SH_VEC4;
+    out_params.positions.resize(count);
+    out_params.scales.resize(count);
+    out_params.rotations.resize(count);
+    out_params.opacities.resize(count);
+    out_params.sh_coeffs_interleaved.resize(count * SH_VEC4);
+    out_moments.positions.resize(count * 2);
+    out_moments.scales.resize(count * 2);
+    out_moments.rotations.resize(count * 2);
+    out_moments.opacities.resize(count);
+    out_moments.sh.resize(count * SH_VEC4 * 2);
+
+    for(size_t dst=0; dst<count; dst++){
+        const int src = result.sources[dst].x;
+        const int child = result.sources[dst].y;
+        const int kind = result.kinds[src];
+
+        vec4 position = params.positions[src];
+        vec4 scale = params.scales[src];
+        if(kind == DENSIFY_SPLIT){
+            // quat2mat of Covariance.h is the transpose of the rotation matrix of the quaternion (r, x, y, z)
+            const vec4 q = normalize(params.rotations[src]);
+            const vec3 offset = mat3_cast(quat(q.x, q.y, q.z, q.w)) * getSplitOffset(src, child, settings.seed, vec3(scale));
+            position += vec4(offset, 0.0f);
+            scale = scale / SPLIT_SCALE_DIVIDER;
+        }
+        const bool keep_moments = kind == DENSIFY_KEEP || (kind == DENSIFY_CLONE && child == 0);
+
+        out_params.positions[dst] = position;
+        out_params.scales[dst] = scale;
+        out_params.rotations[dst] = params.rotations[src];
+        out_params.opacities[dst] = params.opacities[src];
+        std::copy_n(params.sh_coeffs_interleaved.begin() + src * SH_VEC4, SH_VEC4, out_params.sh_coeffs_interleaved.begin() + dst * SH_VEC4);
+
+        for(int i=0; i<2; i++){
+            out_moments.positions[dst * 2 + i] = keep_moments ? moments.positions[src * 2 + i] : vec4(0.0f);
+            out_moments.scales[dst * 2 + i] = keep_moments ? moments.scales[src * 2 + i] : vec4(0.0f);
+            out_moments.rotations[dst * 2 + i] = keep_moments ? moments.rotations[src * 2 + i] : vec4(0.0f);
+        }
+        out_moments.opacities[dst] = keep_moments ? moments.opacities[src] : vec2(0.0f);
+        for(int q=0; q<SH_VEC4 * 2; q++){
+            out_moments.sh[dst * SH_VEC4 * 2 + q] = keep_moments ? moments.sh[src * SH_VEC4 * 2 + q] : vec4(0.0f);
+        }
+    }
+}
+
+int CpuDensification::countMismatches(const CpuAdam::Parameters &a, const CpuAdam::Parameters &b,
+                                      const CpuAdam::Moments &moments_a, const CpuAdam::Moments &moments_b, float tolerance) {
+    if(a.positions.size() != b.positions.size()){
+        return int(std::max(a.positions.size(), b.positions.size()));
+    }
+
+    const auto differs = [tolerance](const auto& x, const auto& y, float reference){
+        for(int k=0; k<x.length(); k++){
+            if(!(std::abs(x[k] - y[k]) <= tolerance * std::max(std::abs(y[k]), reference))){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const int SH_VEC4 = CpuAdam::SH_VEC4;
+    int mismatches = 0;
+    for(size_t n=0; n<b.positions.size(); n++){
+        const vec4 s = b.scales[n];
+        bool d = differs(a.positions[n], b.positions[n], std::max(s.x, std::max(s.y, s.z)));
+        d = d || differs(a.scales[n], b.scales[n], 0.0f);
+        d = d || differs(a.rotations[n], b.rotations[n], 0.0f);
+        d = d || differs(vec1(a.opacities[n]), vec1(b.opacities[n]), 0.0f);
+        for(int q=0; q<SH_VEC4; q++){
+            d = d || differs(a.sh_coeffs_interleaved[n * SH_VEC4 + q], b.sh_coeffs_interleaved[n * SH_VEC4 + q], 0.0f);
+        }
+        for(int i=0; i<2; i++){
+            d = d || differs(moments_a.positions[n * 2 + i], moments_b.positions[n * 2 + i], 0.0f);
+            d = d || differs(moments_a.scales[n * 2 + i], moments_b.scales[n * 2 + i], 0.0f);
+            d = d || differs(moments_a.rotations[n * 2 + i], moments_b.rotations[n * 2 + i], 0.0f);
+        }
+        d = d || differs(moments_a.opacities[n], moments_b.opacities[n], 0.0f);
+        for(int q=0; q<SH_VEC4 * 2; q++){
+            d = d || differs(moments_a.sh[n * SH_VEC4 * 2 + q], moments_b.sh[n * SH_VEC4 * 2 + q], 0.0f);
+        }
+        mismatches += d ? 1 : 0;
+    }
+    return mismatches;
+}
@@ -0,0 +1,59 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_CPUDENSIFICATION_H
+#define HARDWARERASTERIZED3DGS_CPUDENSIFICATION_H
+
+#include <vector>
+#include <cstdint>
+
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+
+#include "CpuAdam.h"
+
+// Thresholds of the densification, see Densification.h
+struct DensificationSettings{
+    float grad_threshold = 5.0E-2f; // mean norm of dLoss_dmean2D, in pixels
+    float split_scale = 0.05f; // the gaussians with a larger scale are split, the smaller ones are cloned
+    float prune_opacity = 0.005f;
+    float prune_scale = 0.0f; // disabled when <= 0
+    uint32_t seed = 0;
+};
+
+/**
+ * Cpu reference of densifyMark.cp and densifyScatter.cp, used to validate the permutation of the gaussians on the gpu.
+ * The buffers have the same content and layout as the buffers of GaussianCloud.
+ */
+class CpuDensification {
+public:
+    struct Result{
+        std::vector<int> kinds; // DENSIFY_* for each input gaussian
+        std::vector<glm::ivec2> sources; // (input gaussian, child) for each output gaussian, child is 0 or 1
+        int kind_counts[4] = {0}; // number of gaussians of each kind
+    };
+
+    /**
+     * Same decisions as densifyMark.cp and same order of the output as densifyScatter.cp.
+     */
+    static Result mark(const DensificationSettings& settings, const CpuAdam::Parameters& params, const std::vector<glm::vec2>& stats);
+
+    /**
+     * Same output as densifyScatter.cp, the baked colors and planar SH coefficients are omitted.
+     */
+    static void scatter(const DensificationSettings& settings, const Result& result,
+                        const CpuAdam::Parameters& params, const CpuAdam::Moments& moments,
+                        CpuAdam::Parameters& out_params, CpuAdam::Moments& out_moments);
+
+    /**
+     * Number of output gaussians whose attributes or moments differ between a and b.
+     * The positions of the split gaussians are compared relative to their scale,
+     * the other values relative to their magnitude.
+     */
+    static int countMismatches(const CpuAdam::Parameters& a, const CpuAdam::Parameters& b,
+                               const CpuAdam::Moments& moments_a, const CpuAdam::Moments& moments_b, float tolerance = 1.0E-4f);
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_CPUDENSIFICATION_H
@@ -0,0 +1,269 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "CpuProjection.h"
+#include "CpuProjectionKernel.h"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "../resources/shaders/common/CommonTypes.h"
+#include "../resources/shaders/common/Covariance.h"
+
+using namespace glm;
+
+static int padToLanes(int n){
+    return (n + CpuProjection::MAX_LANES - 1) / CpuProjection::MAX_LANES * CpuProjection::MAX_LANES;
+}
+
+void GaussiansSoA::build(const std::vector<glm::vec4> &positions, const std::vector<glm::vec4> &scales,
+                         const std::vector<glm::vec4> &rotations, const std::vector<float> &opacities) {
+    count = int(positions.size());
+    const int padded = padToLanes(count);
+
+    // the padding gaussians have a zero opacity, so they are never visible
+    for(auto* v : {&px, &py, &pz, &sx, &sy, &sz, &qr, &qx, &qy, &qz, &opacity}){
+        v->assign(padded, 0.0f);
+    }
+    for(int n=0; n<count; n++){
+        px[n] = positions[n].x;
+        py[n] = positions[n].y;
+        pz[n] = positions[n].z;
+        sx[n] = scales[n].x;
+        sy[n] = scales[n].y;
+        sz[n] = scales[n].z;
+        qr[n] = rotations[n].x;
+        qx[n] = rotations[n].y;
+        qy[n] = rotations[n].z;
+        qz[n] = rotations[n].w;
+        opacity[n] = opacities[n];
+    }
+}
+
+void ProjectedGaussiansSoA::resize(int padded_count) {
+    visible.resize(padded_count);
+    for(auto* v : {&depth, &center_x, &center_y, &conic_a, &conic_b, &conic_c, &obb_x, &obb_y, &eigen_x, &eigen_y}){
+        v->resize(padded_count);
+    }
+}
+
+// Support of the instruction set by both the cpu and the OS.
+static bool cpuSupports(SimdISA isa){
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7){
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if(!osxsave){
+        return false;
+    }
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    const bool avx512f = (info[1] & (1 << 16)) != 0;
+    switch(isa){
+        case SimdISA::AVX2: return avx2 && fma && (xcr0 & 0x6) == 0x6;
+        case SimdISA::AVX512: return avx512f && (xcr0 & 0xE6) == 0xE6;
+        default: return true;
+    }
+#else
+    switch(isa){
+        case SimdISA::AVX2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case SimdISA::AVX512: return __builtin_cpu_supports("avx512f");
+        default: return true;
+    }
+#endif
+}
+
+bool CpuProjection::isSupported(SimdISA isa) {
+    static const bool supported[3] = {
+            true,
+            cpuSupports(SimdISA::AVX2),
+            cpuSupports(SimdISA::AVX512)
+    };
+    return supported[int(isa)];
+}
+
+SimdISA CpuProjection::detectISA() {
+    if(isSupported(SimdISA::AVX512)){
+        return SimdISA::AVX512;
+    }
+    if(isSupported(SimdISA::AVX2)){
+        return SimdISA::AVX2;
+    }
+    return SimdISA::SCALAR;
+}
+
+const char *CpuProjection::getName(SimdISA isa) {
+    switch(isa){
+        case SimdISA::AVX2: return "avx2";
+        case SimdISA::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+void CpuProjection::project(SimdISA isa, const Uniforms &uniforms, const GaussiansSoA &gaussians,
+                            ProjectedGaussiansSoA &out, int begin, int end) {
+    assert(begin % MAX_LANES == 0);
+    assert(isSupported(isa));
+    end = std::min(padToLanes(end), gaussians.paddedCount());
+    assert(int(out.visible.size()) >= end);
+
+    ProjectionParams p = {};
+    for(int k=0; k<16; k++){
+        p.view[k] = uniforms.viewMat[k / 4][k % 4];
+        p.proj[k] = uniforms.projMat[k / 4][k % 4];
+    }
+    p.width = uniforms.width;
+    p.height = uniforms.height;
+    p.focal_x = uniforms.focal_x;
+    p.focal_y = uniforms.focal_y;
+    p.near_plane = uniforms.near_plane;
+    p.far_plane = uniforms.far_plane;
+    p.scale_modifier = uniforms.scale_modifier;
+    p.min_opacity = uniforms.min_opacity;
+    p.antialiasing = uniforms.antialiasing;
+    p.front_to_back = uniforms.front_to_back;
+
+    const SoAGaussiansPtrs g = {
+            gaussians.px.data(), gaussians.py.data(), gaussians.pz.data(),
+            gaussians.sx.data(), gaussians.sy.data(), gaussians.sz.data(),
+            gaussians.qr.data(), gaussians.qx.data(), gaussians.qy.data(), gaussians.qz.data(),
+            gaussians.opacity.data()
+    };
+    const SoAProjectedPtrs o = {
+            out.visible.data(), out.depth.data(),
+            out.center_x.data(), out.center_y.data(),
+            out.conic_a.data(), out.conic_b.data(), out.conic_c.data(),
+            out.obb_x.data(), out.obb_y.data(),
+            out.eigen_x.data(), out.eigen_y.data()
+    };
+
+    switch(isa){
+        case SimdISA::AVX512:
+            projectGaussiansAVX512(p, g, o, begin, end);
+            break;
+        case SimdISA::AVX2:
+            projectGaussiansAVX2(p, g, o, begin, end);
+            break;
+        default:
+            projectGaussiansScalar(p, g, o, begin, end);
+            break;
+    }
+
+    if(uniforms.selected_gaussian != -1){
+        for(int n=begin; n<end; n++){
+            if(n != uniforms.selected_gaussian){
+                out.visible[n] = 0;
+            }
+        }
+    }
+}
+
+bool CpuProjection::testVisibility(const Uniforms& uniforms, const int n, float& depth){
+    const vec3 mean_world_space = vec3(uniforms.positions[n]);
+    const vec3 scale = vec3(uniforms.scales[n]);
+    const float opacity = uniforms.opacities[n];
+    const vec4 quaternion = uniforms.rotations[n];
+
+    const float width = uniforms.width;
+    const float height = uniforms.height;
+
+    // transform to view space
+    const vec3 mean = vec3(uniforms.viewMat * vec4(mean_world_space, 1.0f));
+
+    const vec4 p_hom = uniforms.projMat * vec4(mean, 1.0f);
+    const vec2 ndc = vec2(p_hom) / p_hom.w;
+    const float w = p_hom.w;
+
+    const bool depth_ok = w >= uniforms.near_plane && w <= uniforms.far_plane;
+    const bool selected = n == uniforms.selected_gaussian || uniforms.selected_gaussian == -1;
+    const bool opacity_ok = opacity > uniforms.min_opacity;
+    const bool inSquare = ndc.x > -2.0f && ndc.x < +2.0f && ndc.y > -2.0f && ndc.y < +2.0f;
+
+    if(!depth_ok || !selected || !opacity_ok || !inSquare){
+        return false;
+    }
+
+    const mat3 cov3D = computeCov3D(scale, uniforms.scale_modifier, quaternion, mat3(uniforms.viewMat));
+    vec3 cov = computeCov2D(mean, uniforms.focal_x, uniforms.focal_y, cov3D);
+
+    const float h_var = 0.3f;
+    const float det_cov = cov.x * cov.z - cov.y * cov.y;
+    cov.x += h_var;
+    cov.z += h_var;
+    const float det_cov_plus_h_cov = cov.x * cov.z - cov.y * cov.y;
+    float h_convolution_scaling = 1.0f;
+
+    if(uniforms.antialiasing > 0)
+        h_convolution_scaling = sqrt(max(0.000025f, det_cov / det_cov_plus_h_cov)); // max for numerical stability
+
+    const float det = det_cov_plus_h_cov;
+    if (det == 0.0f)
+        return false;
+
+    const float det_inv = 1.0f / det;
+    const vec3 conic = vec3( cov.z * det_inv, -cov.y * det_inv, cov.x * det_inv );
+
+    const vec2 bbox_pixels = computeAABB(conic, opacity * h_convolution_scaling, uniforms.min_opacity);
+    const vec2 proj_pixels = vec2(ndc * 0.5f + 0.5f) * vec2(width, height);
+
+    const vec2 minCorner = proj_pixels - bbox_pixels;
+    const vec2 maxCorner = proj_pixels + bbox_pixels;
+
+    if(!(maxCorner.x > 0.0f && minCorner.x < width && maxCorner.y > 0.0f && minCorner.y < height)){
+        return false;
+    }
+
+    depth = uniforms.front_to_back > 0 ? w : 1.0f / w;
+    return true;
+}
+
+bool CpuProjection::computeBoundingBox(const Uniforms& uniforms, const int GaussianID,
+                                       vec4& bounding_box, vec4& conic_opacity, vec2& eigen_vec){
+    const float opacity = uniforms.opacities[GaussianID];
+    const vec3 mean_world_space = vec3(uniforms.positions[GaussianID]);
+    const vec3 scale = vec3(uniforms.scales[GaussianID]);
+    const vec4 quaternion = uniforms.rotations[GaussianID];
+
+    // transform to view space
+    const vec3 mean = vec3(uniforms.viewMat * vec4(mean_world_space, 1.0f));
+    const mat3 cov3D = computeCov3D(scale, uniforms.scale_modifier, quaternion, mat3(uniforms.viewMat));
+
+    const vec4 p_hom = uniforms.projMat * vec4(mean, 1.0f);
+    const vec2 ndc = vec2(p_hom) / p_hom.w;
+
+    // Compute 2D screen-space covariance matrix
+    vec3 cov = computeCov2D(mean, uniforms.focal_x, uniforms.focal_y, cov3D);
+
+    const float h_var = 0.3f;
+    cov.x += h_var;
+    cov.z += h_var;
+    const float det = cov.x * cov.z - cov.y * cov.y;
+
+    if (det == 0.0f)
+        return false;
+
+    const float det_inv = 1.0f / det;
+    const vec3 conic = vec3( cov.z * det_inv, -cov.y * det_inv, cov.x * det_inv );
+
+    const OBB obb = computeOBB(conic, opacity, uniforms.min_opacity);
+    const vec2 bbox_pixels = obb.half_extent;
+    eigen_vec = obb.eigen_vec;
+
+    const vec2 proj_pixels = vec2(ndc * 0.5f + 0.5f) * vec2(uniforms.width, uniforms.height);
+    bounding_box = vec4(proj_pixels, bbox_pixels);
+    conic_opacity = vec4( conic.x, conic.y, conic.z, opacity);
+
+    return std::isfinite(bbox_pixels.x) && std::isfinite(bbox_pixels.y) && std::isfinite(eigen_vec.x);
+}
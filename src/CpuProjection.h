@@ -0,0 +1,90 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_CPUPROJECTION_H
+#define HARDWARERASTERIZED3DGS_CPUPROJECTION_H
+
+#include <vector>
+#include <cstdint>
+
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+
+struct Uniforms;
+
+enum class SimdISA{
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+/**
+ * Attributes of the gaussians in structure of arrays layout,
+ * padded with transparent gaussians to a multiple of CpuProjection::MAX_LANES.
+ */
+struct GaussiansSoA{
+    int count = 0; // number of gaussians, without the padding
+    std::vector<float> px, py, pz;
+    std::vector<float> sx, sy, sz;
+    std::vector<float> qr, qx, qy, qz;
+    std::vector<float> opacity;
+
+    void build(const std::vector<glm::vec4>& positions, const std::vector<glm::vec4>& scales,
+               const std::vector<glm::vec4>& rotations, const std::vector<float>& opacities);
+    int paddedCount() const{
+        return int(opacity.size());
+    }
+};
+
+/**
+ * Output of the projection, with the same padding as GaussiansSoA.
+ * Everything but visible is undefined for the gaussians that are not visible.
+ */
+struct ProjectedGaussiansSoA{
+    std::vector<int32_t> visible; // 1 if the gaussian passes the same test as testVisibility.cp
+    std::vector<float> depth; // sort key, same as gaussians_depth
+    std::vector<float> center_x, center_y; // in pixels
+    std::vector<float> conic_a, conic_b, conic_c;
+    std::vector<float> obb_x, obb_y; // half extents of the oriented bounding box, in pixels
+    std::vector<float> eigen_x, eigen_y; // direction of the major axis of the 2D ellipse
+
+    void resize(int padded_count);
+};
+
+/**
+ * Projection of the gaussians on the cpu: culling, 2D covariance, conic and bounding boxes,
+ * as in testVisibility.cp and computeBoundingBoxes.cp.
+ * The batched kernels process 1, 8 or 16 gaussians per instruction and are selected at runtime.
+ */
+class CpuProjection {
+public:
+    static const int MAX_LANES = 16;
+
+    // Best instruction set supported by the cpu
+    static SimdISA detectISA();
+    static bool isSupported(SimdISA isa);
+    static const char* getName(SimdISA isa);
+
+    /**
+     * Projects the gaussians [begin, end) with the kernel of the given instruction set.
+     * begin must be a multiple of MAX_LANES, end is rounded up to the next multiple.
+     */
+    static void project(SimdISA isa, const Uniforms& uniforms, const GaussiansSoA& gaussians, ProjectedGaussiansSoA& out, int begin, int end);
+
+    /**
+     * Scalar reference with the functions of Covariance.h, mirrors testVisibility.cp.
+     * Returns the sort key in depth.
+     */
+    static bool testVisibility(const Uniforms& uniforms, int n, float& depth);
+
+    /**
+     * Scalar reference with the functions of Covariance.h, mirrors computeBoundingBoxes.cp.
+     * Returns false when the gaussian must be skipped.
+     */
+    static bool computeBoundingBox(const Uniforms& uniforms, int GaussianID,
+                                   glm::vec4& bounding_box, glm::vec4& conic_opacity, glm::vec2& eigen_vec);
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_CPUPROJECTION_H
@@ -0,0 +1,229 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+// Validates the batched projection kernels against the scalar functions of Covariance.h,
+// then measures their throughput on the instruction sets supported by the cpu.
+// Usage: CpuProjection_benchmark [num_gaussians] [min_time_seconds]
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <cmath>
+
+#include "CpuProjection.h"
+#include "glm/ext/matrix_transform.hpp"
+#include "glm/ext/matrix_clip_space.hpp"
+#include "../resources/shaders/common/CommonTypes.h"
+
+using namespace glm;
+
+struct Scene{
+    std::vector<vec4> positions;
+    std::vector<vec4> scales;
+    std::vector<vec4> rotations;
+    std::vector<float> opacities;
+};
+
+// Random gaussians in a cube around the origin, with the same activations as the ply files.
+static Scene makeScene(int count, unsigned seed){
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> U(-1.0f, 1.0f);
+    std::normal_distribution<float> N(0.0f, 1.0f);
+
+    Scene s;
+    s.positions.resize(count);
+    s.scales.resize(count);
+    s.rotations.resize(count);
+    s.opacities.resize(count);
+    for(int n=0; n<count; n++){
+        s.positions[n] = vec4(U(rng) * 2.0f, U(rng) * 2.0f, U(rng) * 2.0f, 1.0f);
+        s.scales[n] = vec4(exp(N(rng) - 4.0f), exp(N(rng) - 4.0f), exp(N(rng) - 4.0f), 0.0f);
+        s.rotations[n] = normalize(vec4(N(rng), N(rng), N(rng), N(rng)));
+        s.opacities[n] = 1.0f / (1.0f + exp(-N(rng) * 2.0f));
+    }
+    return s;
+}
+
+static Uniforms makeUniforms(const Scene& s, bool antialiasing){
+    const float width = 1920.0f;
+    const float height = 1080.0f;
+    const float fovY = radians(45.0f);
+
+    Uniforms u = {};
+    u.viewMat = lookAt(vec3(0.5f, 0.3f, 4.0f), vec3(0.0f), vec3(0.0f, 1.0f, 0.0f));
+    u.projMat = perspective(fovY, width / height, 0.01f, 100.0f);
+    u.camera_pos = vec4(0.5f, 0.3f, 4.0f, 1.0f);
+    u.num_gaussians = int(s.positions.size());
+    u.near_plane = 0.01f;
+    u.far_plane = 100.0f;
+    u.scale_modifier = 1.0f;
+    u.selected_gaussian = -1;
+    u.min_opacity = 0.02f;
+    u.width = width;
+    u.height = height;
+    u.focal_y = height / (2.0f * tan(fovY / 2.0f));
+    u.focal_x = u.focal_y;
+    u.antialiasing = int(antialiasing);
+    u.front_to_back = 1;
+
+    u.positions = const_cast<vec4*>(s.positions.data());
+    u.scales = const_cast<vec4*>(s.scales.data());
+    u.rotations = const_cast<vec4*>(s.rotations.data());
+    u.opacities = const_cast<float*>(s.opacities.data());
+    return u;
+}
+
+// Error of a relative to b, measured against the given scale.
+static float scaledError(float a, float b, float scale){
+    if(a == b || (std::isnan(a) && std::isnan(b))){
+        return 0.0f;
+    }
+    return std::abs(a - b) / std::max(scale, 1.0E-20f);
+}
+
+// Returns true if the kernel matches the scalar reference within the tolerance.
+static bool validate(SimdISA isa, const Uniforms& u, const GaussiansSoA& soa){
+    ProjectedGaussiansSoA out;
+    out.resize(soa.paddedCount());
+    CpuProjection::project(isa, u, soa, out, 0, soa.count);
+
+    int visibility_mismatches = 0;
+    int num_visible = 0;
+    int ill_conditioned = 0;
+    float max_error[6] = {0.0f};
+    const char* names[6] = {"depth", "center", "conic", "obb", "eigen_vec", "aabb culling"};
+
+    for(int n=0; n<soa.count; n++){
+        float depth;
+        const bool visible = CpuProjection::testVisibility(u, n, depth);
+        if(visible != (out.visible[n] != 0)){
+            visibility_mismatches++;
+            continue;
+        }
+        if(!visible){
+            continue;
+        }
+        num_visible++;
+
+        vec4 box, conic_opacity;
+        vec2 eigen_vec;
+        // the gaussians with an invalid bounding box are skipped by the rasterizers, so they count as culled
+        const bool valid = CpuProjection::computeBoundingBox(u, n, box, conic_opacity, eigen_vec);
+        const bool out_valid = std::isfinite(out.obb_x[n]) && std::isfinite(out.obb_y[n]) && std::isfinite(out.eigen_x[n]);
+        if(valid != out_valid){
+            visibility_mismatches++;
+            continue;
+        }
+        if(!valid){
+            continue;
+        }
+
+        // The determinant of the 2D covariance suffers from cancellation for needle-like gaussians,
+        // so the errors of the conic and of the bounding box are divided by its condition number.
+        const float a = conic_opacity.x, b = conic_opacity.y, c = conic_opacity.z;
+        const float condition = std::max(a * c / (a * c - b * b), 1.0f);
+        const float conic_scale = std::max(std::abs(a), std::abs(c)) * condition;
+        const float obb_scale = std::max(box.z, box.w) * condition;
+
+        // depth relative to itself, pixels relative to the size of the screen
+        max_error[0] = std::max(max_error[0], scaledError(out.depth[n], depth, std::abs(depth)));
+        max_error[1] = std::max({max_error[1], scaledError(out.center_x[n], box.x, u.width),
+                                 scaledError(out.center_y[n], box.y, u.height)});
+        max_error[2] = std::max({max_error[2], scaledError(out.conic_a[n], a, conic_scale),
+                                 scaledError(out.conic_b[n], b, conic_scale), scaledError(out.conic_c[n], c, conic_scale)});
+        max_error[3] = std::max({max_error[3], scaledError(out.obb_x[n], box.z, obb_scale), scaledError(out.obb_y[n], box.w, obb_scale)});
+
+        // computeOBB takes the direction of (-b, a - lambda1), which suffers from cancellation when the ellipse
+        // is almost axis aligned, so the direction is only compared when it is well conditioned.
+        const float half_tr = (a + c) * 0.5f;
+        const float lambda1 = half_tr + std::sqrt(std::max(half_tr * half_tr - (a * c - b * b), 0.0f));
+        if(std::sqrt(b * b + (a - lambda1) * (a - lambda1)) > 1.0E-2f * (a + c)){
+            // compared by the angle between the vectors
+            const float cos_angle = out.eigen_x[n] * eigen_vec.x + out.eigen_y[n] * eigen_vec.y;
+            max_error[4] = std::max(max_error[4], 1.0f - std::abs(cos_angle));
+        }else{
+            ill_conditioned++;
+        }
+    }
+    max_error[5] = float(visibility_mismatches) / float(std::max(soa.count, 1));
+
+    // Borderline gaussians can be culled differently because of rounding, which is allowed for a few of them.
+    // The conic and the bounding box are computed in a different order than glm, and the remaining cancellations
+    // (in the 3D covariance and in the eigen values) amplify the rounding errors a bit more than the condition number.
+    const float tolerance[6] = {1.0E-5f, 1.0E-5f, 1.0E-3f, 1.0E-3f, 1.0E-4f, 1.0E-4f};
+    bool ok = true;
+    printf("%-8s %d visible, %d visibility mismatches, %d ill-conditioned directions skipped\n",
+           CpuProjection::getName(isa), num_visible, visibility_mismatches, ill_conditioned);
+    for(int k=0; k<6; k++){
+        const bool pass = max_error[k] <= tolerance[k];
+        ok = ok && pass;
+        printf("    %-14s max error %.3e (tolerance %.0e) %s\n", names[k], max_error[k], tolerance[k], pass ? "ok" : "FAILED");
+    }
+    return ok;
+}
+
+static void runBenchmark(SimdISA isa, const Uniforms& u, const GaussiansSoA& soa, int count, double min_time){
+    ProjectedGaussiansSoA out;
+    out.resize(soa.paddedCount());
+
+    CpuProjection::project(isa, u, soa, out, 0, count); // warmup
+
+    long long iterations = 0;
+    double elapsed = 0.0;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    while(elapsed < min_time){
+        CpuProjection::project(isa, u, soa, out, 0, count);
+        iterations++;
+        elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t0).count();
+    }
+
+    const double ns = elapsed * 1.0E9 / double(iterations);
+    const std::string name = std::string("project/") + CpuProjection::getName(isa) + "/" + std::to_string(count);
+    printf("%-32s %14.0f ns %12lld %16.3fM items/s\n", name.c_str(), ns, iterations, double(count) * iterations / elapsed * 1.0E-6);
+}
+
+int main(int argc, char* argv[]){
+    const int num_gaussians = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+    const double min_time = argc > 2 ? std::atof(argv[2]) : 0.5;
+
+    const Scene scene = makeScene(num_gaussians, 42);
+    GaussiansSoA soa;
+    soa.build(scene.positions, scene.scales, scene.rotations, scene.opacities);
+
+    const SimdISA isas[] = {SimdISA::SCALAR, SimdISA::AVX2, SimdISA::AVX512};
+
+    bool ok = true;
+    for(bool antialiasing : {false, true}){
+        printf("Validation against Covariance.h, %d gaussians, antialiasing %s\n", num_gaussians, antialiasing ? "on" : "off");
+        const Uniforms u = makeUniforms(scene, antialiasing);
+        for(SimdISA isa : isas){
+            if(CpuProjection::isSupported(isa)){
+                ok = validate(isa, u, soa) && ok;
+            }else{
+                printf("%-8s not supported by this cpu\n", CpuProjection::getName(isa));
+            }
+        }
+        printf("\n");
+    }
+
+    const Uniforms u = makeUniforms(scene, false);
+    printf("%-32s %17s %12s %25s\n", "Benchmark", "Time", "Iterations", "Throughput");
+    printf("------------------------------------------------------------------------------------------\n");
+    for(SimdISA isa : isas){
+        if(!CpuProjection::isSupported(isa)){
+            continue;
+        }
+        int count = std::min(1 << 10, num_gaussians);
+        for(; count < num_gaussians; count *= 16){
+            runBenchmark(isa, u, soa, count, min_time);
+        }
+        runBenchmark(isa, u, soa, num_gaussians, min_time);
+    }
+
+    return ok ? 0 : 1;
+}
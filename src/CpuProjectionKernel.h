@@ -0,0 +1,254 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_CPUPROJECTIONKERNEL_H
+#define HARDWARERASTERIZED3DGS_CPUPROJECTIONKERNEL_H
+
+// The kernels are compiled once per instruction set, in translation units with different compiler flags.
+// To avoid sharing inline functions between them (the linker could pick the AVX-512 version for the scalar path),
+// this header and the kernels only use plain structs, intrinsics and templates instantiated with local types.
+
+#include <cstdint>
+
+struct ProjectionParams{
+    float view[16]; // column major
+    float proj[16]; // column major
+    float width;
+    float height;
+    float focal_x;
+    float focal_y;
+    float near_plane;
+    float far_plane;
+    float scale_modifier;
+    float min_opacity;
+    int antialiasing;
+    int front_to_back;
+};
+
+struct SoAGaussiansPtrs{
+    const float* px;
+    const float* py;
+    const float* pz;
+    const float* sx;
+    const float* sy;
+    const float* sz;
+    const float* qr;
+    const float* qx;
+    const float* qy;
+    const float* qz;
+    const float* opacity;
+};
+
+struct SoAProjectedPtrs{
+    int32_t* visible;
+    float* depth;
+    float* center_x;
+    float* center_y;
+    float* conic_a;
+    float* conic_b;
+    float* conic_c;
+    float* obb_x;
+    float* obb_y;
+    float* eigen_x;
+    float* eigen_y;
+};
+
+// Entry points, [begin, end) must be multiples of the number of lanes.
+void projectGaussiansScalar(const ProjectionParams& p, const SoAGaussiansPtrs& g, const SoAProjectedPtrs& o, int begin, int end);
+void projectGaussiansAVX2(const ProjectionParams& p, const SoAGaussiansPtrs& g, const SoAProjectedPtrs& o, int begin, int end);
+void projectGaussiansAVX512(const ProjectionParams& p, const SoAGaussiansPtrs& g, const SoAProjectedPtrs& o, int begin, int end);
+
+/**
+ * Natural logarithm for x > 0, from the mantissa and exponent of x: log(x) = e * log(2) + 2 * atanh((m-1)/(m+1)).
+ * S provides the lanes, see projectGaussians.
+ */
+template<class S>
+static inline typename S::F logLanes(const typename S::F x){
+    using F = typename S::F;
+    F e;
+    F m = S::frexp(x, e); // x = m * 2^e, with m in [1, 2)
+
+    // center the mantissa around 1
+    const auto big = m > S::set(1.41421356f);
+    m = S::select(big, m * S::set(0.5f), m);
+    e = S::select(big, e + S::set(1.0f), e);
+
+    const F s = (m - S::set(1.0f)) / (m + S::set(1.0f));
+    const F s2 = s * s;
+    const F p = S::set(2.0f) + s2 * (S::set(2.0f / 3.0f) + s2 * (S::set(2.0f / 5.0f) + s2 * (S::set(2.0f / 7.0f) + s2 * S::set(2.0f / 9.0f))));
+
+    // log(2) split in two parts so that e * ln2_hi is exact
+    const F ln2_hi = S::set(0.693359375f);
+    const F ln2_lo = S::set(-2.12194440e-4f);
+    return e * ln2_hi + (e * ln2_lo + s * p);
+}
+
+/**
+ * Same computations as testVisibility.cp and computeBoundingBoxes.cp, on S::W gaussians at once.
+ * S is a struct with the lane types F (floats) and M (masks), the number of lanes W,
+ * and the static functions set, load, store, storeMask, sqrt, min, max, ceil, select and frexp.
+ * The arithmetic and comparison operators are found by argument dependent lookup.
+ */
+template<class S>
+static void projectGaussians(const ProjectionParams& p, const SoAGaussiansPtrs& g, const SoAProjectedPtrs& o, int begin, int end){
+    using F = typename S::F;
+    using M = typename S::M;
+
+    F V[16];
+    F P[16];
+    for(int k=0; k<16; k++){
+        V[k] = S::set(p.view[k]);
+        P[k] = S::set(p.proj[k]);
+    }
+
+    const F zero = S::set(0.0f);
+    const F half = S::set(0.5f);
+    const F one = S::set(1.0f);
+    const F two = S::set(2.0f);
+    const F width = S::set(p.width);
+    const F height = S::set(p.height);
+    const F focal_x = S::set(p.focal_x);
+    const F focal_y = S::set(p.focal_y);
+    const F near_plane = S::set(p.near_plane);
+    const F far_plane = S::set(p.far_plane);
+    const F scale_modifier = S::set(p.scale_modifier);
+    const F min_opacity = S::set(p.min_opacity);
+    const F h_var = S::set(0.3f);
+
+    for(int i=begin; i<end; i+=S::W){
+        const F px = S::load(g.px + i);
+        const F py = S::load(g.py + i);
+        const F pz = S::load(g.pz + i);
+        const F opacity = S::load(g.opacity + i);
+
+        // transform to view space
+        const F mx = V[0] * px + V[4] * py + V[8] * pz + V[12];
+        const F my = V[1] * px + V[5] * py + V[9] * pz + V[13];
+        const F mz = V[2] * px + V[6] * py + V[10] * pz + V[14];
+
+        const F hx = P[0] * mx + P[4] * my + P[8] * mz + P[12];
+        const F hy = P[1] * mx + P[5] * my + P[9] * mz + P[13];
+        const F hw = P[3] * mx + P[7] * my + P[11] * mz + P[15];
+        const F inv_w = one / hw;
+        const F ndc_x = hx * inv_w;
+        const F ndc_y = hy * inv_w;
+
+        M ok = (hw >= near_plane) & (hw <= far_plane) & (opacity > min_opacity);
+        ok = ok & (ndc_x > -two) & (ndc_x < two) & (ndc_y > -two) & (ndc_y < two);
+
+        // rotation matrix, see quat2mat. R[c][r] is stored in Rcr.
+        const F r = S::load(g.qr + i);
+        const F x = S::load(g.qx + i);
+        const F y = S::load(g.qy + i);
+        const F z = S::load(g.qz + i);
+        const F R00 = one - two * (y * y + z * z);
+        const F R01 = two * (x * y - r * z);
+        const F R02 = two * (x * z + r * y);
+        const F R10 = two * (x * y + r * z);
+        const F R11 = one - two * (x * x + z * z);
+        const F R12 = two * (y * z - r * x);
+        const F R20 = two * (x * z - r * y);
+        const F R21 = two * (y * z + r * x);
+        const F R22 = one - two * (x * x + y * y);
+
+        // M = mat3(viewMat) * transpose(R) * S, row r column c in Mrc
+        const F s0 = scale_modifier * S::load(g.sx + i);
+        const F s1 = scale_modifier * S::load(g.sy + i);
+        const F s2 = scale_modifier * S::load(g.sz + i);
+        const F M00 = (V[0] * R00 + V[4] * R10 + V[8] * R20) * s0;
+        const F M01 = (V[0] * R01 + V[4] * R11 + V[8] * R21) * s1;
+        const F M02 = (V[0] * R02 + V[4] * R12 + V[8] * R22) * s2;
+        const F M10 = (V[1] * R00 + V[5] * R10 + V[9] * R20) * s0;
+        const F M11 = (V[1] * R01 + V[5] * R11 + V[9] * R21) * s1;
+        const F M12 = (V[1] * R02 + V[5] * R12 + V[9] * R22) * s2;
+        const F M20 = (V[2] * R00 + V[6] * R10 + V[10] * R20) * s0;
+        const F M21 = (V[2] * R01 + V[6] * R11 + V[10] * R21) * s1;
+        const F M22 = (V[2] * R02 + V[6] * R12 + V[10] * R22) * s2;
+
+        // cov3D = M * transpose(M)
+        const F S00 = M00 * M00 + M01 * M01 + M02 * M02;
+        const F S01 = M00 * M10 + M01 * M11 + M02 * M12;
+        const F S02 = M00 * M20 + M01 * M21 + M02 * M22;
+        const F S11 = M10 * M10 + M11 * M11 + M12 * M12;
+        const F S12 = M10 * M20 + M11 * M21 + M12 * M22;
+        const F S22 = M20 * M20 + M21 * M21 + M22 * M22;
+
+        // cov2D = transpose(J) * cov3D * J, see computeCov2D
+        const F inv_z = one / mz;
+        const F a0 = focal_x * inv_z;
+        const F c0 = -(focal_x * mx) * (inv_z * inv_z);
+        const F b1 = focal_y * inv_z;
+        const F c1 = -(focal_y * my) * (inv_z * inv_z);
+
+        const F t0 = S00 * a0 + S02 * c0;
+        const F t1 = S01 * a0 + S12 * c0;
+        const F t2 = S02 * a0 + S22 * c0;
+        const F u1 = S11 * b1 + S12 * c1;
+        const F u2 = S12 * b1 + S22 * c1;
+
+        F cov_x = a0 * t0 + c0 * t2;
+        const F cov_y = b1 * t1 + c1 * t2;
+        F cov_z = b1 * u1 + c1 * u2;
+
+        const F det_cov = cov_x * cov_z - cov_y * cov_y;
+        cov_x = cov_x + h_var;
+        cov_z = cov_z + h_var;
+        const F det = cov_x * cov_z - cov_y * cov_y;
+        ok = ok & (det != zero);
+
+        F h_convolution_scaling = one;
+        if(p.antialiasing > 0){
+            h_convolution_scaling = S::sqrt(S::max(S::set(0.000025f), det_cov / det));
+        }
+
+        const F det_inv = one / det;
+        const F a = cov_z * det_inv;
+        const F b = -cov_y * det_inv;
+        const F c = cov_x * det_inv;
+
+        // axis aligned bounding box used for culling, see computeAABB
+        const F scaled_opacity = opacity * h_convolution_scaling;
+        const F e_aabb = -two * logLanes<S>(min_opacity / scaled_opacity);
+        const F vx = -b / c;
+        const F vy = -b / a;
+        const F dx = S::ceil(S::sqrt(e_aabb / (a + two * vx * b + vx * vx * c)));
+        const F dy = S::ceil(S::sqrt(e_aabb / (vy * vy * a + two * vy * b + c)));
+        const M aabb_ok = scaled_opacity >= min_opacity;
+        const F aabb_x = S::select(aabb_ok, dx, zero);
+        const F aabb_y = S::select(aabb_ok, dy, zero);
+
+        const F center_x = (ndc_x * half + half) * width;
+        const F center_y = (ndc_y * half + half) * height;
+        ok = ok & (center_x + aabb_x > zero) & (center_x - aabb_x < width);
+        ok = ok & (center_y + aabb_y > zero) & (center_y - aabb_y < height);
+
+        // oriented bounding box, see computeOBB
+        const F half_tr = (a + c) * half;
+        const F conic_det = a * c - b * b;
+        const F delta = S::sqrt(S::max(half_tr * half_tr - conic_det, zero));
+        const F lambda1 = half_tr + delta;
+        const F lambda2 = half_tr - delta;
+
+        const F ex = -b;
+        const F ey = a - lambda1;
+        const F inv_len = one / S::sqrt(ex * ex + ey * ey);
+
+        const F e_obb = -two * logLanes<S>(min_opacity / opacity);
+        const M obb_ok = opacity >= min_opacity;
+
+        S::storeMask(o.visible + i, ok);
+        S::store(o.depth + i, p.front_to_back > 0 ? hw : inv_w);
+        S::store(o.center_x + i, center_x);
+        S::store(o.center_y + i, center_y);
+        S::store(o.conic_a + i, a);
+        S::store(o.conic_b + i, b);
+        S::store(o.conic_c + i, c);
+        S::store(o.obb_x + i, S::select(obb_ok, S::sqrt(e_obb / lambda1), zero));
+        S::store(o.obb_y + i, S::select(obb_ok, S::sqrt(e_obb / lambda2), zero));
+        S::store(o.eigen_x + i, ex * inv_len);
+        S::store(o.eigen_y + i, ey * inv_len);
+    }
+}
+
+#endif //HARDWARERASTERIZED3DGS_CPUPROJECTIONKERNEL_H
@@ -0,0 +1,62 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+// Compiled with AVX2 and FMA enabled, only called when the cpu supports them.
+
+#include "CpuProjectionKernel.h"
+
+#include <immintrin.h>
+
+namespace {
+
+    struct F8{
+        __m256 v;
+    };
+    struct M8{
+        __m256 v; // all bits set in the lanes where the condition holds
+    };
+
+    inline F8 operator+(F8 a, F8 b){ return {_mm256_add_ps(a.v, b.v)}; }
+    inline F8 operator-(F8 a, F8 b){ return {_mm256_sub_ps(a.v, b.v)}; }
+    inline F8 operator*(F8 a, F8 b){ return {_mm256_mul_ps(a.v, b.v)}; }
+    inline F8 operator/(F8 a, F8 b){ return {_mm256_div_ps(a.v, b.v)}; }
+    inline F8 operator-(F8 a){ return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+
+    inline M8 operator<(F8 a, F8 b){ return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+    inline M8 operator>(F8 a, F8 b){ return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+    inline M8 operator<=(F8 a, F8 b){ return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+    inline M8 operator>=(F8 a, F8 b){ return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+    inline M8 operator!=(F8 a, F8 b){ return {_mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ)}; }
+    inline M8 operator&(M8 a, M8 b){ return {_mm256_and_ps(a.v, b.v)}; }
+
+    struct AVX2Lanes{
+        using F = F8;
+        using M = M8;
+        static constexpr int W = 8;
+
+        static F set(float v){ return {_mm256_set1_ps(v)}; }
+        static F load(const float* p){ return {_mm256_loadu_ps(p)}; }
+        static void store(float* p, F v){ _mm256_storeu_ps(p, v.v); }
+        static void storeMask(int32_t* p, M m){
+            _mm256_storeu_si256((__m256i*)p, _mm256_srli_epi32(_mm256_castps_si256(m.v), 31));
+        }
+        static F sqrt(F v){ return {_mm256_sqrt_ps(v.v)}; }
+        static F min(F a, F b){ return {_mm256_min_ps(a.v, b.v)}; }
+        static F max(F a, F b){ return {_mm256_max_ps(a.v, b.v)}; }
+        static F ceil(F v){ return {_mm256_ceil_ps(v.v)}; }
+        static F select(M m, F a, F b){ return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+        static F frexp(F v, F& e){
+            const __m256i bits = _mm256_castps_si256(v.v);
+            const __m256i exponent = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xFF)), _mm256_set1_epi32(127));
+            e = {_mm256_cvtepi32_ps(exponent)};
+            const __m256i mantissa = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000));
+            return {_mm256_castsi256_ps(mantissa)};
+        }
+    };
+
+}
+
+void projectGaussiansAVX2(const ProjectionParams& p, const SoAGaussiansPtrs& g, const SoAProjectedPtrs& o, int begin, int end){
+    projectGaussians<AVX2Lanes>(p, g, o, begin, end);
+}
@@ -0,0 +1,61 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+// Compiled with AVX-512F enabled, only called when the cpu supports it.
+
+#include "CpuProjectionKernel.h"
+
+#include <immintrin.h>
+
+namespace {
+
+    struct F16{
+        __m512 v;
+    };
+    struct M16{
+        __mmask16 m; // one bit per lane
+    };
+
+    inline F16 operator+(F16 a, F16 b){ return {_mm512_add_ps(a.v, b.v)}; }
+    inline F16 operator-(F16 a, F16 b){ return {_mm512_sub_ps(a.v, b.v)}; }
+    inline F16 operator*(F16 a, F16 b){ return {_mm512_mul_ps(a.v, b.v)}; }
+    inline F16 operator/(F16 a, F16 b){ return {_mm512_div_ps(a.v, b.v)}; }
+    inline F16 operator-(F16 a){
+        return {_mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(a.v), _mm512_set1_epi32(int(0x80000000))))};
+    }
+
+    inline M16 operator<(F16 a, F16 b){ return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)}; }
+    inline M16 operator>(F16 a, F16 b){ return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)}; }
+    inline M16 operator<=(F16 a, F16 b){ return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)}; }
+    inline M16 operator>=(F16 a, F16 b){ return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)}; }
+    inline M16 operator!=(F16 a, F16 b){ return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_NEQ_UQ)}; }
+    inline M16 operator&(M16 a, M16 b){ return {__mmask16(a.m & b.m)}; }
+
+    struct AVX512Lanes{
+        using F = F16;
+        using M = M16;
+        static constexpr int W = 16;
+
+        static F set(float v){ return {_mm512_set1_ps(v)}; }
+        static F load(const float* p){ return {_mm512_loadu_ps(p)}; }
+        static void store(float* p, F v){ _mm512_storeu_ps(p, v.v); }
+        static void storeMask(int32_t* p, M m){
+            _mm512_storeu_si512(p, _mm512_maskz_mov_epi32(m.m, _mm512_set1_epi32(1)));
+        }
+        static F sqrt(F v){ return {_mm512_sqrt_ps(v.v)}; }
+        static F min(F a, F b){ return {_mm512_min_ps(a.v, b.v)}; }
+        static F max(F a, F b){ return {_mm512_max_ps(a.v, b.v)}; }
+        static F ceil(F v){ return {_mm512_roundscale_ps(v.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)}; }
+        static F select(M m, F a, F b){ return {_mm512_mask_blend_ps(m.m, b.v, a.v)}; }
+        static F frexp(F v, F& e){
+            e = {_mm512_getexp_ps(v.v)};
+            return {_mm512_getmant_ps(v.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero)};
+        }
+    };
+
+}
+
+void projectGaussiansAVX512(const ProjectionParams& p, const SoAGaussiansPtrs& g, const SoAProjectedPtrs& o, int begin, int end){
+    projectGaussians<AVX512Lanes>(p, g, o, begin, end);
+}
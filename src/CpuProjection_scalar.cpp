@@ -0,0 +1,37 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "CpuProjectionKernel.h"
+
+#include <cmath>
+
+namespace {
+
+    struct ScalarLanes{
+        using F = float;
+        using M = bool;
+        static constexpr int W = 1;
+
+        static F set(float v){ return v; }
+        static F load(const float* p){ return *p; }
+        static void store(float* p, F v){ *p = v; }
+        static void storeMask(int32_t* p, M m){ *p = m ? 1 : 0; }
+        static F sqrt(F v){ return std::sqrt(v); }
+        static F min(F a, F b){ return b < a ? b : a; }
+        static F max(F a, F b){ return a < b ? b : a; }
+        static F ceil(F v){ return std::ceil(v); }
+        static F select(M m, F a, F b){ return m ? a : b; }
+        static F frexp(F v, F& e){
+            int exponent;
+            const float m = std::frexp(v, &exponent); // in [0.5, 1)
+            e = float(exponent - 1);
+            return m * 2.0f;
+        }
+    };
+
+}
+
+void projectGaussiansScalar(const ProjectionParams& p, const SoAGaussiansPtrs& g, const SoAProjectedPtrs& o, int begin, int end){
+    projectGaussians<ScalarLanes>(p, g, o, begin, end);
+}
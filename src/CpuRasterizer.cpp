@@ -0,0 +1,233 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "CpuRasterizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "RenderingBase/AsyncWorkers.h"
+#include "CpuProjection.h"
+#include "stb/stb_image_write.h"
+
+// The shader headers are valid c++, the functions below mirror predict_colors_interleaved.cp and quad.fs,
+// the projection is done by CpuProjection.
+#include "../resources/shaders/common/CommonTypes.h"
+#include "../resources/shaders/common/SphericalHarmonics.h"
+#include "../resources/shaders/common/Tiles.h"
+
+using namespace glm;
+
+// Same as predict_colors_interleaved.cp, without the color cache.
+static vec4 predictColor(const Uniforms& uniforms, const int GaussianID, const vec4 bounding_box){
+    const vec4 P = uniforms.positions[GaussianID];
+    const vec3 dir = normalize(vec3(P - uniforms.camera_pos));
+
+    int degree = 3;
+    if(uniforms.sh_lod > 0){
+        const vec3 thresholds = vec3(uniforms.sh_lod_degree1_pixels, uniforms.sh_lod_degree2_pixels, uniforms.sh_lod_degree3_pixels);
+        degree = selectSHDegree(max(bounding_box.z, bounding_box.w), thresholds);
+    }
+
+    const vec3 result = evalSphericalHarmonics(uniforms.sh_coeffs_interleaved + GaussianID * SH_INTERLEAVED_VEC4, dir, degree);
+    return vec4(result, 1.0f);
+}
+
+static float elapsedMs(const std::chrono::high_resolution_clock::time_point& t0){
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<float, std::milli>(t1 - t0).count();
+}
+
+CpuRasterizer::CpuRasterizer(int threads) : workers(std::make_unique<AsyncWorkers>(threads)), num_threads(std::max(threads, 1)) {
+
+}
+
+CpuRasterizer::~CpuRasterizer() {
+
+}
+
+void CpuRasterizer::parallelFor(int count, const std::function<void(int begin, int end)> &f) {
+    // a few chunks per thread to balance the load
+    const int num_chunks = std::min(count, num_threads * 4);
+    if(num_chunks <= 1){
+        f(0, count);
+        return;
+    }
+
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(num_chunks);
+    for(int c=0; c<num_chunks; c++){
+        const int begin = int(int64_t(count) * c / num_chunks);
+        const int end = int(int64_t(count) * (c+1) / num_chunks);
+        tasks.emplace_back([&f, begin, end](){
+            f(begin, end);
+        });
+    }
+    workers->execAll(tasks);
+}
+
+std::vector<glm::vec4> CpuRasterizer::render(const Uniforms &uniforms, const GaussiansSoA* soa) {
+    const auto t_start = std::chrono::high_resolution_clock::now();
+
+    const int width = int(uniforms.width);
+    const int height = int(uniforms.height);
+    const int num_gaussians = uniforms.num_gaussians;
+
+    // visibility test
+    auto t0 = std::chrono::high_resolution_clock::now();
+    const int* visible_ptr = nullptr;
+    const float* depths_ptr = nullptr;
+    if(soa){
+        // the batched kernels work on blocks of MAX_LANES gaussians
+        const int lanes = CpuProjection::MAX_LANES;
+        const SimdISA isa = CpuProjection::detectISA();
+        projected.resize(soa->paddedCount());
+        parallelFor(soa->paddedCount() / lanes, [&](int begin, int end){
+            CpuProjection::project(isa, uniforms, *soa, projected, begin * lanes, end * lanes);
+        });
+        visible_ptr = projected.visible.data();
+        depths_ptr = projected.depth.data();
+    }else{
+        visible.resize(num_gaussians);
+        depths.resize(num_gaussians);
+        parallelFor(num_gaussians, [&](int begin, int end){
+            for(int n=begin; n<end; n++){
+                visible[n] = int(CpuProjection::testVisibility(uniforms, n, depths[n]));
+            }
+        });
+        visible_ptr = visible.data();
+        depths_ptr = depths.data();
+    }
+
+    sorted_indices.clear();
+    for(int n=0; n<num_gaussians; n++){
+        if(visible_ptr[n]){
+            sorted_indices.push_back(n);
+        }
+    }
+    num_visible_gaussians = int(sorted_indices.size());
+    timings.project_ms = elapsedMs(t0);
+
+    // sort by depth, the ties are kept in the order of the gaussians
+    t0 = std::chrono::high_resolution_clock::now();
+    std::stable_sort(sorted_indices.begin(), sorted_indices.end(), [depths_ptr](int a, int b){
+        return depths_ptr[a] < depths_ptr[b];
+    });
+    timings.sort_ms = elapsedMs(t0);
+
+    // bounding boxes and colors of the sorted gaussians
+    t0 = std::chrono::high_resolution_clock::now();
+    splats.resize(num_visible_gaussians);
+    std::vector<int> valid(num_visible_gaussians);
+    parallelFor(num_visible_gaussians, [&](int begin, int end){
+        for(int i=begin; i<end; i++){
+            const int GaussianID = sorted_indices[i];
+            Splat& s = splats[i];
+            if(soa){
+                const int n = GaussianID;
+                s.bounding_box = vec4(projected.center_x[n], projected.center_y[n], projected.obb_x[n], projected.obb_y[n]);
+                s.conic_opacity = vec4(projected.conic_a[n], projected.conic_b[n], projected.conic_c[n], soa->opacity[n]);
+                s.eigen_vec = vec2(projected.eigen_x[n], projected.eigen_y[n]);
+                valid[i] = int(std::isfinite(s.bounding_box.z) && std::isfinite(s.bounding_box.w) && std::isfinite(s.eigen_vec.x));
+            }else{
+                valid[i] = int(CpuProjection::computeBoundingBox(uniforms, GaussianID, s.bounding_box, s.conic_opacity, s.eigen_vec));
+            }
+            if(valid[i]){
+                s.color = predictColor(uniforms, GaussianID, s.bounding_box);
+            }
+        }
+    });
+    timings.project_ms += elapsedMs(t0);
+
+    // assign the splats to the tiles they overlap, in the sorted order
+    t0 = std::chrono::high_resolution_clock::now();
+    const int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    const int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    tiles.resize(tiles_x * tiles_y);
+    for(auto& t : tiles){
+        t.clear();
+    }
+    for(int i=0; i<num_visible_gaussians; i++){
+        if(!valid[i]){
+            continue;
+        }
+        // same tiles as the tiled rasterizer on the gpu
+        const Splat& s = splats[i];
+        const ivec4 rect = getTileRect(s.bounding_box, s.eigen_vec, width, height);
+        for(int ty = rect.y; ty < rect.w; ty++){
+            for(int tx = rect.x; tx < rect.z; tx++){
+                tiles[ty * tiles_x + tx].push_back(i);
+            }
+        }
+    }
+    timings.binning_ms = elapsedMs(t0);
+
+    // alpha blending, same as quad.fs with the blending equations of GaussianCloud::render
+    t0 = std::chrono::high_resolution_clock::now();
+    std::vector<vec4> image(size_t(width) * size_t(height));
+    parallelFor(tiles_x * tiles_y, [&](int begin, int end){
+        for(int tile=begin; tile<end; tile++){
+            const int x0 = (tile % tiles_x) * TILE_SIZE;
+            const int y0 = (tile / tiles_x) * TILE_SIZE;
+            const int x1 = std::min(x0 + TILE_SIZE, width);
+            const int y1 = std::min(y0 + TILE_SIZE, height);
+
+            for(int y=y0; y<y1; y++){
+                for(int x=x0; x<x1; x++){
+                    const vec2 pixel = vec2(x, y) + 0.5f;
+                    vec3 color = vec3(0.0f);
+                    float alpha_dst = 1.0f; // the fbo is cleared with alpha = 1
+
+                    for(int i : tiles[tile]){
+                        const Splat& s = splats[i];
+                        const vec2 local_coord = pixel - vec2(s.bounding_box);
+                        const mat2 cov2D = mat2(s.conic_opacity.x, s.conic_opacity.y, s.conic_opacity.y, s.conic_opacity.z);
+
+                        const float power = -0.5f * dot(local_coord, cov2D * local_coord);
+                        if(power > 0.0f){
+                            continue;
+                        }
+
+                        const float alpha = min(0.99f, s.conic_opacity.w * exp(power));
+                        if(alpha < uniforms.min_opacity){
+                            continue;
+                        }
+
+                        if(uniforms.front_to_back > 0){
+                            // glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA)
+                            color += alpha_dst * vec3(s.color) * alpha;
+                            alpha_dst *= 1.0f - alpha;
+                        }else{
+                            // glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+                            color = vec3(s.color) * alpha + (1.0f - alpha) * color;
+                            alpha_dst = alpha + (1.0f - alpha) * alpha_dst;
+                        }
+                    }
+
+                    image[size_t(y) * width + x] = vec4(color, alpha_dst);
+                }
+            }
+        }
+    });
+    timings.blend_ms = elapsedMs(t0);
+    timings.total_ms = elapsedMs(t_start);
+
+    return image;
+}
+
+bool CpuRasterizer::writePNG(const std::string &path, const std::vector<glm::vec4> &image, int width, int height) {
+    std::vector<unsigned char> pixels(size_t(width) * size_t(height) * 3);
+    for(size_t i=0; i<size_t(width) * size_t(height); i++){
+        const vec3 c = clamp(vec3(image[i]), 0.0f, 1.0f);
+        pixels[i*3+0] = (unsigned char)(c.r * 255.0f + 0.5f);
+        pixels[i*3+1] = (unsigned char)(c.g * 255.0f + 0.5f);
+        pixels[i*3+2] = (unsigned char)(c.b * 255.0f + 0.5f);
+    }
+
+    stbi_flip_vertically_on_write(1);
+    const int res = stbi_write_png(path.c_str(), width, height, 3, pixels.data(), width * 3);
+    stbi_flip_vertically_on_write(0);
+    return res != 0;
+}
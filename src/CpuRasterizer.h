@@ -0,0 +1,94 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_CPURASTERIZER_H
+#define HARDWARERASTERIZED3DGS_CPURASTERIZER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <functional>
+
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+
+#include "CpuProjection.h"
+
+struct Uniforms;
+class AsyncWorkers;
+
+/**
+ * Renders the gaussians on the cpu with the same formulas as the shaders, so that a frame can be rendered
+ * without a gpu and serve as a reference for the gpu pipeline.
+ * Culling, projection and color prediction are parallelized over the gaussians,
+ * alpha blending over tiles of 16x16 pixels.
+ */
+class CpuRasterizer {
+public:
+    static const int TILE_SIZE = 16; // same as Tiles.h
+
+    struct Timings{
+        float project_ms = 0.0f; // culling, bounding boxes and colors
+        float sort_ms = 0.0f;
+        float binning_ms = 0.0f;
+        float blend_ms = 0.0f;
+        float total_ms = 0.0f;
+    };
+
+    explicit CpuRasterizer(int threads = std::thread::hardware_concurrency());
+    virtual ~CpuRasterizer();
+
+    CpuRasterizer(const CpuRasterizer&) = delete;
+    CpuRasterizer& operator=(const CpuRasterizer&) = delete;
+
+    /**
+     * Renders a frame of uniforms.width x uniforms.height pixels, with the first row at the bottom like the fbo.
+     * The pointers to the gaussian attributes in the uniforms (positions, scales, rotations, opacities
+     * and sh_coeffs_interleaved) must point to cpu memory, the other pointers are ignored.
+     * The rgb channels hold the blended colors, the alpha channel is the same as the fbo after hardware blending.
+     * When soa is not null, it must hold the same gaussians as the uniforms, and the projection is done
+     * with the batched kernels of CpuProjection instead of the scalar functions of Covariance.h.
+     */
+    std::vector<glm::vec4> render(const Uniforms& uniforms, const GaussiansSoA* soa = nullptr);
+
+    int getNumVisibleGaussians() const{
+        return num_visible_gaussians;
+    }
+    const Timings& getTimings() const{
+        return timings;
+    }
+
+    /**
+     * Writes the rgb channels of the image as an 8 bits png, flipped so that the first row is at the top.
+     */
+    static bool writePNG(const std::string& path, const std::vector<glm::vec4>& image, int width, int height);
+
+private:
+    // same content as bounding_boxes, conic_opacity, eigen_vecs and predicted_colors on the gpu
+    struct Splat{
+        glm::vec4 bounding_box;
+        glm::vec4 conic_opacity;
+        glm::vec2 eigen_vec;
+        glm::vec4 color;
+    };
+
+    std::unique_ptr<AsyncWorkers> workers;
+    int num_threads;
+
+    std::vector<int> visible; // 1 if the gaussian passes the visibility test
+    std::vector<float> depths; // sort key, same as gaussians_depth
+    ProjectedGaussiansSoA projected; // output of the batched kernels
+    std::vector<int> sorted_indices;
+    std::vector<Splat> splats; // packed in the sorted order
+    std::vector<std::vector<int>> tiles; // splats overlapping each tile, in the sorted order
+
+    int num_visible_gaussians = 0;
+    Timings timings;
+
+    void parallelFor(int count, const std::function<void(int begin, int end)>& f);
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_CPURASTERIZER_H
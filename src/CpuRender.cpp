@@ -0,0 +1,172 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+// Renders a ply file with the cpu rasterizer and writes a png, without opengl, cuda or a window,
+// for a machine without an nvidia gpu or as the golden reference image of a scene and a camera.
+// The camera orbits around the look-at point like the orbit mode of Camera, the angles are in degrees:
+// Usage: CpuRasterizer_render scene.ply [--output render.png] [--size 1280x720] [--look-at x,y,z]
+//                             [--theta 0] [--phi 0] [--distance 3] [--fovy 45] [--antialiasing] [--simd] [--threads N]
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <cmath>
+#include <thread>
+
+#include "CpuRasterizer.h"
+#include "CpuProjection.h"
+#include "PlyGaussians.h"
+#include "glm/ext/matrix_transform.hpp"
+#include "glm/ext/matrix_clip_space.hpp"
+#include "../resources/shaders/common/CommonTypes.h"
+
+using namespace glm;
+
+struct Options{
+    std::string scene;
+    std::string output = "render.png";
+    ivec2 size = ivec2(1280, 720);
+    vec3 lookPos = vec3(0.0f);
+    float theta = 0.0f;
+    float phi = 0.0f;
+    float distance = 3.0f;
+    float fovY = 45.0f;
+    bool antialiasing = false;
+    bool simd = false;
+    int threads = int(std::thread::hardware_concurrency());
+};
+
+static float parseFloat(const std::string& arg, const char* value){
+    try{
+        return std::stof(value);
+    }catch(const std::exception&){
+        throw std::string("Invalid value for ") + arg + ": " + value;
+    }
+}
+
+static Options parse(int argc, char** argv){
+    Options o;
+    for(int i=1; i<argc; i++){
+        const std::string arg = argv[i];
+        if(arg == "--antialiasing"){
+            o.antialiasing = true;
+            continue;
+        }else if(arg == "--simd"){
+            o.simd = true;
+            continue;
+        }else if(arg.rfind("--", 0) != 0){
+            o.scene = arg;
+            continue;
+        }
+        if(i + 1 >= argc){
+            throw std::string("Missing value for ") + arg;
+        }
+        const char* value = argv[++i];
+        if(arg == "--output"){
+            o.output = value;
+        }else if(arg == "--size"){
+            if(std::sscanf(value, "%dx%d", &o.size.x, &o.size.y) != 2 || o.size.x <= 0 || o.size.y <= 0){
+                throw std::string("Invalid size ") + value + ", expected WIDTHxHEIGHT";
+            }
+        }else if(arg == "--look-at"){
+            if(std::sscanf(value, "%f,%f,%f", &o.lookPos.x, &o.lookPos.y, &o.lookPos.z) != 3){
+                throw std::string("Invalid look-at point ") + value + ", expected x,y,z";
+            }
+        }else if(arg == "--theta"){
+            o.theta = parseFloat(arg, value);
+        }else if(arg == "--phi"){
+            o.phi = parseFloat(arg, value);
+        }else if(arg == "--distance"){
+            o.distance = parseFloat(arg, value);
+        }else if(arg == "--fovy"){
+            o.fovY = parseFloat(arg, value);
+        }else if(arg == "--threads"){
+            o.threads = int(parseFloat(arg, value));
+        }else{
+            throw std::string("Unknown argument ") + arg;
+        }
+    }
+    if(o.scene.empty()){
+        throw std::string("Usage: CpuRasterizer_render scene.ply [--output render.png] [--size 1280x720] [--look-at x,y,z] "
+                          "[--theta 0] [--phi 0] [--distance 3] [--fovy 45] [--antialiasing] [--simd] [--threads N]");
+    }
+    if(o.distance <= 0.0f || o.fovY <= 0.0f || o.fovY >= 180.0f || o.threads <= 0){
+        throw std::string("The distance, the field of view and the number of threads must be positive");
+    }
+    return o;
+}
+
+// Same matrices as Camera in orbit mode, and same uniforms as GaussianCloud::fillUniforms with the default settings.
+static Uniforms makeUniforms(const Options& o){
+    const float theta = radians(o.theta);
+    const float phi = radians(o.phi);
+    const vec3 camDir = -vec3(sin(theta) * cos(phi), sin(phi), cos(theta) * cos(phi));
+    const vec3 camPos = -camDir * o.distance + o.lookPos;
+
+    const float width = float(o.size.x);
+    const float height = float(o.size.y);
+    const float fovY = radians(o.fovY);
+    const float fovX = 2.0f * atan(tan(fovY * 0.5f) * width / height);
+    const float nearPlane = 0.001f;
+    const float farPlane = 100.0f;
+
+    const mat4 rot = rotate(mat4(1.0f), radians(180.0f), vec3(1, 0, 0));
+
+    Uniforms u = {};
+    u.viewMat = lookAt(camPos, o.lookPos, vec3(0, 1, 0)) * rot;
+    u.projMat = perspective(fovY, width / height, nearPlane, farPlane);
+    u.camera_pos = vec4(camPos, 1.0f);
+    u.near_plane = nearPlane;
+    u.far_plane = farPlane;
+    u.scale_modifier = 1.0f;
+    u.selected_gaussian = -1;
+    u.min_opacity = 0.02f;
+    u.width = width;
+    u.height = height;
+    u.focal_x = width / (2.0f * tan(fovX / 2.0f));
+    u.focal_y = height / (2.0f * tan(fovY / 2.0f));
+    u.antialiasing = int(o.antialiasing);
+    u.front_to_back = 1;
+    return u;
+}
+
+int main(int argc, char* argv[]){
+    try{
+        const Options o = parse(argc, argv);
+
+        PlyGaussians ply = PlyGaussians::load(o.scene);
+        std::cout << "Loaded " << ply.count << " gaussians from " << o.scene << std::endl;
+
+        Uniforms u = makeUniforms(o);
+        u.num_gaussians = ply.count;
+        u.positions = ply.positions.data();
+        u.rotations = ply.rotations.data();
+        u.scales = ply.scales.data();
+        u.opacities = ply.opacities.data();
+        u.sh_coeffs_interleaved = reinterpret_cast<vec4 *>(ply.sh_coeffs.data());
+
+        GaussiansSoA soa;
+        if(o.simd){
+            soa.build(ply.positions, ply.scales, ply.rotations, ply.opacities);
+        }
+
+        CpuRasterizer rasterizer(o.threads);
+        const std::vector<vec4> image = rasterizer.render(u, o.simd ? &soa : nullptr);
+
+        const CpuRasterizer::Timings& t = rasterizer.getTimings();
+        printf("%d visible gaussians, %dx%d pixels, %d threads\n", rasterizer.getNumVisibleGaussians(), o.size.x, o.size.y, o.threads);
+        printf("project %.2fms, sort %.2fms, binning %.2fms, blend %.2fms, total %.2fms\n",
+               t.project_ms, t.sort_ms, t.binning_ms, t.blend_ms, t.total_ms);
+
+        if(!CpuRasterizer::writePNG(o.output, image, o.size.x, o.size.y)){
+            std::cout << "Couldn't write " << o.output << std::endl;
+            return 1;
+        }
+        std::cout << "Render written to " << o.output << std::endl;
+    }catch(const std::string& msg){
+        std::cout << msg << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,472 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "Dataset.h"
+
+#include "RenderingBase/AsyncWorkers.h"
+#include "RenderingBase/SharedContext.h"
+#include "RenderingBase/Profiler.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+
+using namespace glm;
+
+float Dataset::View::getFovY(int width, int height) const {
+    if(fovY > 0.0f){
+        return fovY;
+    }
+    return 2.0f * std::atan(std::tan(fovX * 0.5f) * float(height) / float(width));
+}
+
+template<typename T>
+static T read(std::ifstream& file){
+    T value;
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if(!file){
+        throw std::string("Unexpected end of file");
+    }
+    return value;
+}
+
+static std::ifstream openBinary(const std::string& path){
+    std::ifstream file(path, std::ios::binary);
+    if(!file){
+        throw std::string("Couldn't open ") + path;
+    }
+    return file;
+}
+
+// Number of parameters of each camera model of COLMAP, see colmap/src/colmap/sensor/models.h
+static int colmapNumParams(int model_id){
+    switch(model_id){
+        case 0: return 3; // SIMPLE_PINHOLE f, cx, cy
+        case 1: return 4; // PINHOLE fx, fy, cx, cy
+        case 2: return 4; // SIMPLE_RADIAL f, cx, cy, k
+        case 3: return 5; // RADIAL f, cx, cy, k1, k2
+        case 4: return 8; // OPENCV fx, fy, cx, cy, ...
+        case 5: return 8; // OPENCV_FISHEYE fx, fy, cx, cy, ...
+        case 6: return 12; // FULL_OPENCV fx, fy, cx, cy, ...
+        case 7: return 5; // FOV fx, fy, cx, cy, omega
+        case 8: return 4; // SIMPLE_RADIAL_FISHEYE f, cx, cy, k
+        case 9: return 5; // RADIAL_FISHEYE f, cx, cy, k1, k2
+        case 10: return 12; // THIN_PRISM_FISHEYE fx, fy, cx, cy, ...
+        default: throw std::string("Unknown COLMAP camera model ") + std::to_string(model_id);
+    }
+}
+
+Dataset Dataset::loadColmap(const std::string &dir, const std::string &images_folder) {
+    namespace fs = std::filesystem;
+    const fs::path sparse = fs::path(dir) / "sparse" / "0";
+
+    struct ColmapCamera{
+        int width;
+        int height;
+        float fx;
+        float fy;
+    };
+    std::map<int, ColmapCamera> cameras;
+    {
+        std::ifstream file = openBinary((sparse / "cameras.bin").string());
+        const uint64_t num_cameras = read<uint64_t>(file);
+        for(uint64_t i=0; i<num_cameras; i++){
+            const int camera_id = read<int32_t>(file);
+            const int model_id = read<int32_t>(file);
+            ColmapCamera c;
+            c.width = int(read<uint64_t>(file));
+            c.height = int(read<uint64_t>(file));
+            std::vector<double> params(colmapNumParams(model_id));
+            for(double& p : params){
+                p = read<double>(file);
+            }
+            // the models with a single focal length start with f, cx, cy
+            const bool single_focal = model_id == 0 || model_id == 2 || model_id == 3 || model_id == 8 || model_id == 9;
+            c.fx = float(params[0]);
+            c.fy = float(single_focal ? params[0] : params[1]);
+            cameras[camera_id] = c;
+        }
+    }
+
+    Dataset dataset;
+    dataset.path = dir;
+    {
+        std::ifstream file = openBinary((sparse / "images.bin").string());
+        const uint64_t num_images = read<uint64_t>(file);
+        for(uint64_t i=0; i<num_images; i++){
+            read<int32_t>(file); // image_id
+            dvec4 q; // w, x, y, z
+            for(int k=0; k<4; k++){
+                q[k] = read<double>(file);
+            }
+            dvec3 t;
+            for(int k=0; k<3; k++){
+                t[k] = read<double>(file);
+            }
+            const int camera_id = read<int32_t>(file);
+            std::string name;
+            for(char c = read<char>(file); c != '\0'; c = read<char>(file)){
+                name += c;
+            }
+            // the 2D points: x, y as doubles and the id of the 3D point as an int64
+            const uint64_t num_points2D = read<uint64_t>(file);
+            file.seekg(std::streamoff(num_points2D * 24), std::ios::cur);
+
+            const auto camera = cameras.find(camera_id);
+            if(camera == cameras.end()){
+                throw std::string("Unknown camera ") + std::to_string(camera_id) + " for the image " + name;
+            }
+
+            // world to camera with the OpenCV convention (y down, looking towards +z), flipped to the OpenGL convention
+            const mat3 R = mat3_cast(quat(float(q.x), float(q.y), float(q.z), float(q.w)));
+            mat4 worldToCamera = mat4(R);
+            worldToCamera[3] = vec4(vec3(t), 1.0f);
+            const mat4 flip = mat4(vec4(1, 0, 0, 0), vec4(0, -1, 0, 0), vec4(0, 0, -1, 0), vec4(0, 0, 0, 1));
+
+            View v;
+            v.image_path = (fs::path(dir) / images_folder / name).string();
+            v.viewMat = flip * worldToCamera;
+            // the fields of view don't depend on the resolution of the images
+            v.fovX = 2.0f * std::atan(0.5f * float(camera->second.width) / camera->second.fx);
+            v.fovY = 2.0f * std::atan(0.5f * float(camera->second.height) / camera->second.fy);
+            dataset.views.push_back(v);
+        }
+    }
+
+    std::sort(dataset.views.begin(), dataset.views.end(), [](const View& a, const View& b){
+        return a.image_path < b.image_path;
+    });
+    std::cout << "Read " << dataset.views.size() << " views from " << sparse.string() << std::endl;
+    return dataset;
+}
+
+// Just enough of a json parser for transforms.json
+struct JsonValue{
+    enum Type{NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT};
+    Type type = NUL;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    const JsonValue* find(const std::string& key) const{
+        for(const auto& [k, v] : object){
+            if(k == key){
+                return &v;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser{
+public:
+    explicit JsonParser(const std::string& text) : text(text) {}
+
+    JsonValue parse(){
+        JsonValue v = parseValue();
+        skipSpaces();
+        if(pos != text.size()){
+            error("trailing characters");
+        }
+        return v;
+    }
+
+private:
+    const std::string& text;
+    size_t pos = 0;
+
+    [[noreturn]] void error(const std::string& what) const{
+        throw std::string("Json error at character ") + std::to_string(pos) + ": " + what;
+    }
+
+    void skipSpaces(){
+        while(pos < text.size() && std::isspace((unsigned char)text[pos])){
+            pos++;
+        }
+    }
+
+    bool consume(char c){
+        skipSpaces();
+        if(pos < text.size() && text[pos] == c){
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c){
+        if(!consume(c)){
+            error(std::string("expected '") + c + "'");
+        }
+    }
+
+    std::string parseString(){
+        expect('"');
+        std::string s;
+        while(pos < text.size() && text[pos] != '"'){
+            char c = text[pos++];
+            if(c == '\\' && pos < text.size()){
+                c = text[pos++];
+                switch(c){
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': pos += 4; c = '?'; break; // not needed for the paths
+                    default: break; // \" \\ \/
+                }
+            }
+            s += c;
+        }
+        expect('"');
+        return s;
+    }
+
+    JsonValue parseValue(){
+        skipSpaces();
+        if(pos >= text.size()){
+            error("unexpected end");
+        }
+        JsonValue v;
+        const char c = text[pos];
+        if(c == '{'){
+            pos++;
+            v.type = JsonValue::OBJECT;
+            if(!consume('}')){
+                do{
+                    skipSpaces();
+                    std::string key = parseString();
+                    expect(':');
+                    v.object.emplace_back(std::move(key), parseValue());
+                }while(consume(','));
+                expect('}');
+            }
+        }else if(c == '['){
+            pos++;
+            v.type = JsonValue::ARRAY;
+            if(!consume(']')){
+                do{
+                    v.array.push_back(parseValue());
+                }while(consume(','));
+                expect(']');
+            }
+        }else if(c == '"'){
+            v.type = JsonValue::STRING;
+            v.string = parseString();
+        }else if(text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0){
+            v.type = JsonValue::BOOL;
+            v.number = c == 't' ? 1.0 : 0.0;
+            pos += c == 't' ? 4 : 5;
+        }else if(text.compare(pos, 4, "null") == 0){
+            pos += 4;
+        }else{
+            const char* begin = text.c_str() + pos;
+            char* end = nullptr;
+            v.type = JsonValue::NUMBER;
+            v.number = std::strtod(begin, &end);
+            if(end == begin){
+                error("unexpected character");
+            }
+            pos += size_t(end - begin);
+        }
+        return v;
+    }
+};
+
+static const JsonValue& member(const JsonValue& object, const std::string& key){
+    const JsonValue* v = object.find(key);
+    if(!v){
+        throw std::string("Missing json member ") + key;
+    }
+    return *v;
+}
+
+Dataset Dataset::loadTransforms(const std::string &path) {
+    namespace fs = std::filesystem;
+    std::ifstream file(path);
+    if(!file){
+        throw std::string("Couldn't open ") + path;
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string text = ss.str();
+    const JsonValue root = JsonParser(text).parse();
+
+    // NeRF synthetic scenes only give camera_angle_x, instant-ngp also gives the focal lengths and the size
+    const float fovX = float(member(root, "camera_angle_x").number);
+    float fovY = 0.0f;
+    if(root.find("fl_y") && root.find("h")){
+        fovY = 2.0f * std::atan(0.5f * float(root.find("h")->number) / float(root.find("fl_y")->number));
+    }
+
+    Dataset dataset;
+    dataset.path = path;
+    const fs::path folder = fs::path(path).parent_path();
+    for(const JsonValue& frame : member(root, "frames").array){
+        fs::path image = folder / member(frame, "file_path").string;
+        if(!image.has_extension()){
+            image += ".png"; // the NeRF synthetic scenes omit the extension
+        }
+
+        const JsonValue& rows = member(frame, "transform_matrix");
+        mat4 cameraToWorld;
+        for(int i=0; i<4; i++){
+            for(int j=0; j<4; j++){
+                cameraToWorld[j][i] = float(rows.array.at(i).array.at(j).number);
+            }
+        }
+
+        View v;
+        v.image_path = image.lexically_normal().string();
+        v.viewMat = inverse(cameraToWorld); // the cameras of Blender already follow the OpenGL convention
+        v.fovX = fovX;
+        v.fovY = fovY;
+        dataset.views.push_back(v);
+    }
+
+    std::sort(dataset.views.begin(), dataset.views.end(), [](const View& a, const View& b){
+        return a.image_path < b.image_path;
+    });
+    std::cout << "Read " << dataset.views.size() << " views from " << path << std::endl;
+    return dataset;
+}
+
+Dataset Dataset::load(const std::string &path) {
+    if(std::filesystem::path(path).extension() == ".json"){
+        return loadTransforms(path);
+    }
+    return loadColmap(path);
+}
+
+DatasetPrefetcher::DatasetPrefetcher(Dataset dataset, SharedContext &context, int queueSize, int threads, uint32_t seed)
+    : dataset(std::move(dataset)), context(context), workers(std::make_unique<AsyncWorkers>(threads)),
+      queueSize(std::max(queueSize, 1)), rng(seed) {
+    schedule();
+}
+
+DatasetPrefetcher::~DatasetPrefetcher() {
+    // the decoding tasks schedule the uploads, which push the images on the ready queue
+    workers.reset();
+    context.waitForAll();
+
+    while(ready.size() > 0){
+        Image image;
+        bool success;
+        ready.get(image, std::chrono::milliseconds(0), success);
+        if(success && image.fence){
+            glDeleteSync(image.fence);
+        }
+    }
+}
+
+void DatasetPrefetcher::schedule() {
+    if(dataset.views.empty()){
+        return;
+    }
+    while(in_flight < queueSize){
+        if(cursor == order.size()){
+            // new epoch
+            order.resize(dataset.views.size());
+            for(size_t i=0; i<order.size(); i++){
+                order[i] = int(i);
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+            cursor = 0;
+        }
+        const int view = order[cursor++];
+        in_flight++;
+
+        workers->exec([this, view](){
+            Profiler::CpuScope scope("decode image");
+            const auto t0 = std::chrono::high_resolution_clock::now();
+            std::shared_ptr<Texture2D::TextureData> data;
+            try{
+                // the first row of the fbos is at the bottom
+                data = std::make_shared<Texture2D::TextureData>(Texture2D::readTextureFromDisk(dataset.views[view].image_path, true, 4));
+            }catch(const std::string& e){
+                std::cout << e << std::endl;
+            }
+            const auto t1 = std::chrono::high_resolution_clock::now();
+            decode_us += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+            decoded++;
+
+            context.scheduleTask([this, view, data](){
+                Image image;
+                image.view = view;
+                if(data){
+                    Profiler::CpuScope scope("upload image");
+                    const auto t0 = std::chrono::high_resolution_clock::now();
+                    // the handles are made resident by the context that uses them, see next
+                    image.texture = std::make_unique<Texture2D>(*data, false, false, false, 1);
+                    image.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                    glFlush();
+                    const auto t1 = std::chrono::high_resolution_clock::now();
+                    upload_us += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+                    uploaded++;
+                }
+                ready.push(std::move(image));
+            });
+        });
+    }
+}
+
+bool DatasetPrefetcher::next(DatasetPrefetcher::Image &image) {
+    if(dataset.views.empty()){
+        return false;
+    }
+    Profiler::CpuScope scope("wait for image");
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    bool waited = false;
+    // gives up once a whole epoch failed to decode
+    for(int failures = 0; failures <= int(dataset.views.size()); ){
+        waited = waited || ready.size() == 0;
+        bool success = false;
+        ready.get(image, std::chrono::milliseconds(100), success);
+        if(!success){
+            workers->checkErrors();
+            continue;
+        }
+        in_flight--;
+        schedule();
+        if(!image.texture){
+            stats.failed++;
+            failures++;
+            continue;
+        }
+
+        // the upload on the shared context must be visible in this context
+        glWaitSync(image.fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(image.fence);
+        image.fence = nullptr;
+        image.texture->makeImageHandleResident(true, GL_READ_ONLY);
+
+        stats.consumed++;
+        break;
+    }
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    if(waited){
+        stats.stalls++;
+    }
+    stats.wait_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+    return image.texture != nullptr;
+}
+
+DatasetPrefetcher::Stats DatasetPrefetcher::getStats() const {
+    Stats s = stats;
+    s.decode_ms = decoded > 0 ? double(decode_us) * 1.0E-3 / decoded : 0.0;
+    s.upload_ms = uploaded > 0 ? double(upload_us) * 1.0E-3 / uploaded : 0.0;
+    return s;
+}
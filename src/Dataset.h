@@ -0,0 +1,125 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_DATASET_H
+#define HARDWARERASTERIZED3DGS_DATASET_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <random>
+#include <cstdint>
+
+#include "glad/gl.h"
+#include "glm/mat4x4.hpp"
+
+#include "RenderingBase/ThreadSafeQueue.h"
+#include "RenderingBase/Texture2D.h"
+
+class AsyncWorkers;
+class SharedContext;
+
+/**
+ * The training views of a scene: a COLMAP reconstruction (sparse/0/cameras.bin and images.bin)
+ * or a NeRF synthetic scene (any transforms .json file, e.g. transforms_train.json or transforms_test.json).
+ * The distortion parameters of COLMAP are ignored, the images must be undistorted as for 3DGS.
+ * The principal point is assumed to be at the center of the images.
+ */
+class Dataset {
+public:
+    struct View{
+        std::string image_path;
+        glm::mat4 viewMat; // world to camera, OpenGL convention (x right, y up, looking towards -z)
+        float fovX; // radians
+        float fovY; // radians, 0 when it depends on the size of the image (transforms.json)
+
+        // the vertical field of view once the size of the image is known
+        float getFovY(int width, int height) const;
+    };
+
+    std::string path;
+    std::vector<View> views; // sorted by image name
+
+    /**
+     * Reads dir/sparse/0/cameras.bin and dir/sparse/0/images.bin, the images are in dir/images_folder
+     * (images_2, images_4, ... for the downscaled versions).
+     * Throws a std::string on error.
+     */
+    static Dataset loadColmap(const std::string& dir, const std::string& images_folder="images");
+
+    /**
+     * Reads a transforms.json file, the image paths are relative to its folder.
+     * Throws a std::string on error.
+     */
+    static Dataset loadTransforms(const std::string& path);
+
+    // loadTransforms for a .json file, loadColmap otherwise
+    static Dataset load(const std::string& path);
+};
+
+/**
+ * Decodes the images of a dataset with stb_image on worker threads, then uploads them as rgba8 textures on the
+ * shared context, so that the training loop doesn't wait on the disk or the decoding.
+ * At most queueSize images are in flight or waiting to be consumed, which bounds the memory.
+ * The views are visited in a random order, reshuffled at each epoch.
+ */
+class DatasetPrefetcher {
+public:
+    struct Image{
+        int view = -1;
+        std::unique_ptr<Texture2D> texture; // rgba8, the first row at the bottom like the fbos, nullptr if the decoding failed
+        GLsync fence = nullptr; // signaled once the upload is complete
+    };
+
+    DatasetPrefetcher(Dataset dataset, SharedContext& context, int queueSize=8, int threads=4, uint32_t seed=0);
+    virtual ~DatasetPrefetcher();
+
+    DatasetPrefetcher(const DatasetPrefetcher&) = delete;
+    DatasetPrefetcher& operator=(const DatasetPrefetcher&) = delete;
+
+    /**
+     * The next image in the order they are ready, waits when the queue is empty.
+     * The image handle of the texture is resident in the current context, read only.
+     * Returns false when the images can't be decoded.
+     */
+    bool next(Image& image);
+
+    const Dataset& getDataset() const{
+        return dataset;
+    }
+
+    struct Stats{
+        int consumed = 0;
+        int stalls = 0; // calls to next that had to wait
+        double wait_ms = 0.0; // total time spent waiting in next
+        double decode_ms = 0.0; // mean time to read and decode an image, on a worker thread
+        double upload_ms = 0.0; // mean time to upload an image, on the shared context
+        int failed = 0;
+    };
+    Stats getStats() const;
+
+private:
+    void schedule(); // keeps queueSize images in flight
+
+    Dataset dataset;
+    SharedContext& context;
+    std::unique_ptr<AsyncWorkers> workers;
+    ThreadSafeQueue<Image> ready;
+
+    const int queueSize;
+    int in_flight = 0; // scheduled and not yet returned by next
+    std::vector<int> order;
+    size_t cursor = 0;
+    std::mt19937 rng;
+
+    Stats stats;
+    std::atomic<int64_t> decode_us = 0;
+    std::atomic<int64_t> upload_us = 0;
+    std::atomic_int decoded = 0;
+    std::atomic_int uploaded = 0;
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_DATASET_H
@@ -4,6 +4,8 @@
 
 #include "GaussianCloud.h"
 #include "RenderingBase/VAO.h"
+#include "RenderingBase/Profiler.h"
+#include "RenderingBase/ImGuiHelpers.h"
 
 #include "imgui/imgui.h"
 #include "glm/ext/matrix_transform.hpp"
@@ -11,14 +13,84 @@
 
 #include "../resources/shaders/common/CommonTypes.h"
 
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+
 using namespace glm;
 
 const GLenum FBO_FORMAT = GL_RGBA16F;
 
+void GaussianCloud::fillUniforms(Uniforms &u, Camera &camera, int width, int height) const {
+    const mat4 rot = glm::rotate(mat4(1.0f), radians(180.0f), vec3(1, 0, 0));
+
+    u.viewMat = camera.getViewMatrix() * rot;
+    u.projMat = camera.getProjectionMatrix();
+
+    u.camera_pos = vec4(camera.getPosition(), 1.0f);
+
+    u.num_gaussians = num_gaussians;
+    u.near_plane = camera.getNearPlane();
+    u.far_plane = camera.getFarPlane();
+    u.scale_modifier = scale_modifier;
+
+    u.selected_gaussian = selected_gaussian;
+    u.min_opacity = min_opacity;
+    u.width = width;
+    u.height = height;
+
+    auto fov2focal = [](float fov, float pixels){
+        return pixels / (2.0f * tan(fov / 2.0f));
+    };
+
+    u.focal_x = fov2focal(camera.getFovX(), width);
+    u.focal_y = fov2focal(camera.getFovY(), height);
+    u.antialiasing = int(antialiasing);
+    u.front_to_back = int(front_to_back);
+
+    u.color_cache = int(colorCache);
+    u.color_cache_min_cos = cos(radians(colorCacheMaxAngle));
+    u.sh_lod = int(shLod);
+    u.point_decimation_distance = pointDecimationDistance;
+    u.sh_lod_degree1_pixels = shLodPixels[0];
+    u.sh_lod_degree2_pixels = shLodPixels[1];
+    u.sh_lod_degree3_pixels = shLodPixels[2];
+    u.tiled_blending = int(blending == TILED_BLENDING || blending == HYBRID_BLENDING);
+    u.hybrid_blending = int(blending == HYBRID_BLENDING);
+    u.hybrid_max_area = hybridMaxArea;
+    u.depth_slices = depthSlices;
+    u.early_termination = int(earlyTermination && front_to_back);
+    u.termination_transmittance = terminationTransmittance;
+    u.proxy_sides = proxySides;
+    u.instanced_strips = int(instancedStrips);
+    u.stochastic_transparency = int(blending == STOCHASTIC_BLENDING);
+
+    u.foveation = int(foveation);
+    vec2 gaze = vec2(width, height) * 0.5f;
+    // only with the foveation, the mouse moves would restart the stochastic accumulation otherwise
+    if(foveation && gazeFollowsMouse){
+        // the mouse coordinates start at the top left corner, the fbo may be scaled
+        const vec2 mouse = camera.getMouseFramebufferCoords() / vec2(camera.getFramebufferSize());
+        gaze = vec2(mouse.x, 1.0f - mouse.y) * vec2(width, height);
+    }
+    u.gaze_x = gaze.x;
+    u.gaze_y = gaze.y;
+    u.fovea_radius = foveaRadius * float(height);
+    u.fovea_max_pixel_size = float(foveaMaxPixelSize);
+    u.fovea_cull_size = foveaCullSize;
+    u.gradient_accumulation = gradientAccumulation;
+}
+
 void GaussianCloud::prepareRender(Camera &camera) {
 
-    const int width = camera.getFramebufferSize().x;
-    const int height = camera.getFramebufferSize().y;
+    int width = std::max(1, int(std::round(camera.getFramebufferSize().x * renderScale)));
+    int height = std::max(1, int(std::round(camera.getFramebufferSize().y * renderScale)));
+    if(renderSize.x > 0 && renderSize.y > 0){
+        width = renderSize.x;
+        height = renderSize.y;
+    }
 
     const GLenum formats[] = {GL_RGBA8, GL_RGBA16F, GL_RGBA32F};
 
@@ -28,55 +100,66 @@ void GaussianCloud::prepareRender(Camera &camera) {
         fbo.init(width, height);
         fbo.createAttachment(GL_COLOR_ATTACHMENT0, FBO_FORMAT, GL_RGBA, GL_FLOAT);
         fbo.drawBuffersAllAttachments();
+        fbo.createDepthRenderbuffer(GL_DEPTH_COMPONENT32F); // saturated pixels or stochastic transparency
+
+        Texture2D::TextureData data = Texture2D::TextureData("", width, height, GL_RGBA32F, GL_RGBA, GL_FLOAT, nullptr, [](void*){});
+        stochastic_accumulation = std::make_unique<Texture2D>(data, true, false, false, 1);
+
+        if(GLAD_GL_NV_shading_rate_image){
+            // one texel of the shading rate image per block of pixels
+            glGetIntegerv(GL_SHADING_RATE_IMAGE_TEXEL_WIDTH_NV, &shadingRateTexelSize.x);
+            glGetIntegerv(GL_SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV, &shadingRateTexelSize.y);
+            const int w = (width + shadingRateTexelSize.x - 1) / shadingRateTexelSize.x;
+            const int h = (height + shadingRateTexelSize.y - 1) / shadingRateTexelSize.y;
+            Texture2D::TextureData rates = Texture2D::TextureData("", w, h, GL_R8UI, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr, [](void*){});
+            shading_rate_image = std::make_unique<Texture2D>(rates, true, false, false, 1);
+        }
         if(!fbo.checkComplete()){
             exit(0);
         }
 
+        oitfbo.init(width, height);
+        oitfbo.createAttachment(GL_COLOR_ATTACHMENT0, GL_RGBA32F, GL_RGBA, GL_FLOAT); // the weighted sums overflow 16 bits floats
+        oitfbo.createAttachment(GL_COLOR_ATTACHMENT1, GL_R16F, GL_RED, GL_FLOAT);
+        oitfbo.drawBuffersAllAttachments();
+        if(!oitfbo.checkComplete()){
+            exit(0);
+        }
+
         emptyfbo.init(width, height);
         emptyfbo.makeEmpty();
         if(!emptyfbo.checkComplete()){
             exit(0);
         }
 
+        const int num_tiles = ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+        tile_ranges.storeData(nullptr, num_tiles * MAX_DEPTH_SLICES, 2*sizeof(int), 0, false, true, true);
     }
 
     const int zero = 0;
     visible_gaussians_counter.storeData(&zero, 1, sizeof(int), 0, false, false, true);
+    color_cache_hits.clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
 
-    const mat4 rot = glm::rotate(mat4(1.0f), radians(180.0f), vec3(1, 0, 0));
-
-    Uniforms uniforms_cpu = {};
-    uniforms_cpu.viewMat = camera.getViewMatrix() * rot;
-    uniforms_cpu.projMat = camera.getProjectionMatrix();
-
-    uniforms_cpu.camera_pos = vec4(camera.getPosition(), 1.0f);
-
-    uniforms_cpu.num_gaussians = num_gaussians;
-    uniforms_cpu.near_plane = camera.getNearPlane();
-    uniforms_cpu.far_plane = camera.getFarPlane();
-    uniforms_cpu.scale_modifier = scale_modifier;
-
-    uniforms_cpu.selected_gaussian = selected_gaussian;
-    uniforms_cpu.min_opacity = min_opacity;
-    uniforms_cpu.width = width;
-    uniforms_cpu.height = height;
+    uploadUniforms(camera);
+}
 
-    auto fov2focal = [](float fov, float pixels){
-        return pixels / (2.0f * tan(fov / 2.0f));
-    };
+void GaussianCloud::uploadUniforms(Camera &camera) {
+    const int width = fbo.getWidth();
+    const int height = fbo.getHeight();
 
-    uniforms_cpu.focal_x = fov2focal(camera.getFovX(), width);
-    uniforms_cpu.focal_y = fov2focal(camera.getFovY(), height);
-    uniforms_cpu.antialiasing = int(antialiasing);
-    uniforms_cpu.front_to_back = int(front_to_back);
+    Uniforms uniforms_cpu;
+    std::memset(&uniforms_cpu, 0, sizeof(Uniforms)); // the padding is compared below
+    fillUniforms(uniforms_cpu, camera, width, height);
 
     uniforms_cpu.positions = reinterpret_cast<vec4 *>(positions.getGLptr());
     uniforms_cpu.rotations = reinterpret_cast<vec4 *>(rotations.getGLptr());
     uniforms_cpu.scales = reinterpret_cast<vec4 *>(scales.getGLptr());
     uniforms_cpu.opacities = reinterpret_cast<float *>(opacities.getGLptr());
+    uniforms_cpu.baked_colors = reinterpret_cast<uint *>(baked_colors.getGLptr());
     uniforms_cpu.sh_coeffs_red = reinterpret_cast<float *>(sh_coeffs[0].getGLptr());
     uniforms_cpu.sh_coeffs_green = reinterpret_cast<float *>(sh_coeffs[1].getGLptr());
     uniforms_cpu.sh_coeffs_blue = reinterpret_cast<float *>(sh_coeffs[2].getGLptr());
+    uniforms_cpu.sh_coeffs_interleaved = reinterpret_cast<vec4 *>(sh_coeffs_interleaved.getGLptr());
 
     uniforms_cpu.visible_gaussians_counter = reinterpret_cast<int *>(visible_gaussians_counter.getGLptr());
     uniforms_cpu.gaussians_depth = reinterpret_cast<float *>(gaussians_depths.getGLptr());
@@ -89,12 +172,189 @@ void GaussianCloud::prepareRender(Camera &camera) {
     uniforms_cpu.eigen_vecs = reinterpret_cast<vec2 *>(eigen_vecs.getGLptr());
     uniforms_cpu.predicted_colors = reinterpret_cast<vec4 *>(predicted_colors.getGLptr());
 
-    uniforms_cpu.ground_truth_image = 0;
+    uniforms_cpu.tiles_touched = reinterpret_cast<int *>(tiles_touched.getGLptr());
+    uniforms_cpu.tile_offsets = reinterpret_cast<int *>(tile_offsets.getGLptr());
+    uniforms_cpu.tile_keys = reinterpret_cast<uint64_t *>(tile_keys.getGLptr());
+    uniforms_cpu.sorted_tile_keys = reinterpret_cast<uint64_t *>(sorted_tile_keys.getGLptr());
+    uniforms_cpu.tile_ranges = reinterpret_cast<ivec2 *>(tile_ranges.getGLptr());
+    uniforms_cpu.large_splats = reinterpret_cast<int *>(large_splats.getGLptr());
+    uniforms_cpu.large_splat_offsets = reinterpret_cast<int *>(large_splat_offsets.getGLptr());
+    uniforms_cpu.large_splat_indices = reinterpret_cast<int *>(large_splat_indices.getGLptr());
+    uniforms_cpu.hybrid_draws = reinterpret_cast<uvec4 *>(hybrid_draws.getGLptr());
+
+    uniforms_cpu.color_cache_dirs = reinterpret_cast<vec4 *>(color_cache_dirs.getGLptr());
+    uniforms_cpu.color_cache_colors = reinterpret_cast<vec4 *>(color_cache_colors.getGLptr());
+    uniforms_cpu.color_cache_hits = reinterpret_cast<int *>(color_cache_hits.getGLptr());
+
+    uniforms_cpu.dLoss_dsh_coeffs_red = reinterpret_cast<float *>(dLoss_dsh_coeffs[0].getGLptr());
+    uniforms_cpu.dLoss_dsh_coeffs_green = reinterpret_cast<float *>(dLoss_dsh_coeffs[1].getGLptr());
+    uniforms_cpu.dLoss_dsh_coeffs_blue = reinterpret_cast<float *>(dLoss_dsh_coeffs[2].getGLptr());
+    uniforms_cpu.dLoss_dpositions = reinterpret_cast<vec4 *>(dLoss_dpositions.getGLptr());
+    uniforms_cpu.dLoss_dscales = reinterpret_cast<vec4 *>(dLoss_dscales.getGLptr());
+    uniforms_cpu.dLoss_drotations = reinterpret_cast<vec4 *>(dLoss_drotations.getGLptr());
+    uniforms_cpu.dLoss_dopacities = reinterpret_cast<float *>(dLoss_dopacities.getGLptr());
+    uniforms_cpu.moments_positions = reinterpret_cast<vec4 *>(moments_positions.getGLptr());
+    uniforms_cpu.moments_scales = reinterpret_cast<vec4 *>(moments_scales.getGLptr());
+    uniforms_cpu.moments_rotations = reinterpret_cast<vec4 *>(moments_rotations.getGLptr());
+    uniforms_cpu.moments_opacities = reinterpret_cast<vec2 *>(moments_opacities.getGLptr());
+    uniforms_cpu.moments_sh = reinterpret_cast<vec4 *>(moments_sh.getGLptr());
+    uniforms_cpu.densification_stats = reinterpret_cast<vec2 *>(densification_stats.getGLptr());
+    uniforms_cpu.dLoss_dconic_opacity = reinterpret_cast<f16vec4 *>(dLoss_dconic_opacity.getGLptr());
+    uniforms_cpu.dLoss_dpredicted_colors = reinterpret_cast<f16vec4 *>(dLoss_dpredicted_colors.getGLptr());
+    uniforms_cpu.dLoss_dmean2D = reinterpret_cast<f16vec2 *>(dLoss_dmean2D.getGLptr());
+    uniforms_cpu.dLoss_dconic_opacity_fp32 = reinterpret_cast<float *>(dLoss_dconic_opacity_fp32.getGLptr());
+    uniforms_cpu.dLoss_dpredicted_colors_fp32 = reinterpret_cast<float *>(dLoss_dpredicted_colors_fp32.getGLptr());
+    uniforms_cpu.dLoss_dmean2D_fp32 = reinterpret_cast<float *>(dLoss_dmean2D_fp32.getGLptr());
+    uniforms_cpu.loss = reinterpret_cast<float *>(training_loss.getGLptr());
+
+    uniforms_cpu.ground_truth_image = groundTruthImage;
     uniforms_cpu.accumulated_image_fwd = fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getImageHandle();
 
+    // restart the accumulation of the stochastic transparency as soon as anything changes
+    uniforms_cpu.stochastic_frame = 0;
+    const char* bytes = reinterpret_cast<const char*>(&uniforms_cpu);
+    if(stochasticKey.size() != sizeof(Uniforms) || std::memcmp(stochasticKey.data(), bytes, sizeof(Uniforms)) != 0){
+        stochasticKey.assign(bytes, bytes + sizeof(Uniforms));
+        stochasticFrame = 0;
+    }
+    uniforms_cpu.stochastic_frame = stochasticFrame;
+
     uniforms.storeData(&uniforms_cpu, 1, sizeof(Uniforms));
     glBindBufferBase(GL_UNIFORM_BUFFER, 0, uniforms.getID());
+}
 
+void GaussianCloud::binTiles(Camera &camera) {
+    const bool hybrid = blending == HYBRID_BLENDING;
+    num_tile_keys = 0;
+    num_large_splats = 0;
+    if(num_visible_gaussians > 0){
+        // offsets of the keys of each gaussian
+        sort.inclusiveSum(tiles_touched, tile_offsets, num_visible_gaussians);
+        if(hybrid){
+            sort.inclusiveSum(large_splats, large_splat_offsets, num_visible_gaussians);
+        }
+
+        // read back the number of keys to size the sort, that's a second cpu / gpu synchronization.
+        const int last = num_visible_gaussians - 1;
+        glCopyNamedBufferSubData(tile_offsets.getID(), counter.getID(), last * sizeof(int), 2*sizeof(int), sizeof(int));
+        if(hybrid){
+            glCopyNamedBufferSubData(large_splat_offsets.getID(), counter.getID(), last * sizeof(int), 3*sizeof(int), sizeof(int));
+        }
+        Profiler::CpuScope stall("read back the tile keys count");
+        const int* counters = (int*)glMapNamedBuffer(counter.getID(), GL_READ_ONLY);
+        num_tile_keys = counters[2];
+        num_large_splats = hybrid ? counters[3] : 0;
+        glUnmapNamedBuffer(counter.getID());
+    }
+
+    if(num_tile_keys > tile_keys.getNumElements()){
+        // grow with some headroom, the buffers have new addresses so the uniforms are uploaded again
+        const int capacity = num_tile_keys + num_tile_keys / 2;
+        tile_keys.storeData(nullptr, capacity, sizeof(uint64_t), 0, true, false, true);
+        sorted_tile_keys.storeData(nullptr, capacity, sizeof(uint64_t), 0, true, false, true);
+        uploadUniforms(camera);
+    }
+
+    const int zero = 0;
+    tile_ranges.clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+    if(hybrid){
+        // the empty depth slices keep a draw command of 0 vertices
+        hybrid_draws.clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+    }
+    if(num_tile_keys == 0 && num_large_splats == 0){
+        return;
+    }
+
+    emitTileKeysShader.start();
+    glDispatchCompute((num_visible_gaussians+127)/128, 1, 1);
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    emitTileKeysShader.stop();
+
+    if(num_tile_keys == 0){
+        return;
+    }
+
+    // sort by tile, then by depth. Only the bits of the largest tile index are needed above the 32 bits of the depth.
+    const int64_t num_tiles = tile_ranges.getNumElements() / MAX_DEPTH_SLICES * (hybrid ? depthSlices : 1);
+    int tile_bits = 1;
+    while((int64_t(1) << tile_bits) < num_tiles){
+        tile_bits++;
+    }
+    sort.sortKeys(tile_keys, sorted_tile_keys, num_tile_keys, 32 + tile_bits);
+
+    identifyTileRangesShader.start();
+    glDispatchCompute((num_tile_keys+127)/128, 1, 1);
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    identifyTileRangesShader.stop();
+}
+
+void GaussianCloud::blendTiles(int depth_slice) {
+    // one workgroup per tile
+    blendTilesShader.start();
+    blendTilesShader.loadInt("depth_slice", depth_slice);
+    const GLuint ID = fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID();
+    glBindImageTexture(0, ID, 0, false, 0, GL_READ_WRITE, FBO_FORMAT);
+    glDispatchCompute((fbo.getWidth()+TILE_SIZE-1)/TILE_SIZE, (fbo.getHeight()+TILE_SIZE-1)/TILE_SIZE, 1);
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    blendTilesShader.stop();
+}
+
+void GaussianCloud::markSaturatedPixels() {
+    // make the blended colors visible to the image loads
+    glTextureBarrier();
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_ALWAYS);
+
+    saturateShader.start();
+    const GLuint ID = fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID();
+    glBindImageTexture(0, ID, 0, false, 0, GL_READ_ONLY, FBO_FORMAT);
+    VAO vao; // empty vertex array
+    vao.bind();
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    vao.unbind();
+    saturateShader.stop();
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LESS);
+}
+
+bool GaussianCloud::useShadingRateImage() const {
+    return foveation && shading_rate_image != nullptr;
+}
+
+void GaussianCloud::updateShadingRateImage() {
+    if(!useShadingRateImage()){
+        return;
+    }
+    foveationRatesShader.start();
+    foveationRatesShader.loadiVec2("texel_size", shadingRateTexelSize);
+    glBindImageTexture(0, shading_rate_image->getID(), 0, false, 0, GL_WRITE_ONLY, GL_R8UI);
+    glDispatchCompute((shading_rate_image->getWidth()+15)/16, (shading_rate_image->getHeight()+15)/16, 1);
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    glShadingRateImageBarrierNV(GL_TRUE); // the image is read by the rasterizer
+    foveationRatesShader.stop();
+}
+
+void GaussianCloud::setFoveatedShading(bool enable) {
+    if(!useShadingRateImage()){
+        return;
+    }
+    if(enable){
+        // same order as getFoveationRateIndex in Foveation.h
+        const GLenum rates[3] = {
+                GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV,
+                GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV,
+                GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV
+        };
+        glBindShadingRateImageNV(shading_rate_image->getID());
+        glShadingRateImagePaletteNV(0, 0, 3, rates);
+        glEnable(GL_SHADING_RATE_IMAGE_NV);
+    }else{
+        glDisable(GL_SHADING_RATE_IMAGE_NV);
+    }
 }
 
 void GaussianCloud::render(Camera &camera) {
@@ -102,32 +362,56 @@ void GaussianCloud::render(Camera &camera) {
     prepareRender(camera);
 
     if(renderAsQuads){
-        if(softwareBlending){
+        if(blending == INTERLOCK_BLENDING){
             emptyfbo.bind();
             glViewport(0, 0, fbo.getWidth(), fbo.getHeight());
             const GLuint ID = fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID();
             vec4 value = vec4(0.0f, 0.0f, 0.0f, 1.0f);
             glClearTexImage(ID, 0, GL_RGBA, GL_FLOAT, &value);
+        }else if(blending == TILED_BLENDING){
+            // every pixel is written by blendTiles.cp, no need to clear
+            emptyfbo.bind();
+            glViewport(0, 0, fbo.getWidth(), fbo.getHeight());
+        }else if(blending == OIT_BLENDING){
+            oitfbo.bind();
+            glViewport(0, 0, fbo.getWidth(), fbo.getHeight());
+            const vec4 accumulation = vec4(0.0f);
+            const vec4 revealage = vec4(1.0f);
+            glClearNamedFramebufferfv(oitfbo.getID(), GL_COLOR, 0, &accumulation.x);
+            glClearNamedFramebufferfv(oitfbo.getID(), GL_COLOR, 1, &revealage.x);
         }else{
             fbo.bind();
             glViewport(0, 0, fbo.getWidth(), fbo.getHeight());
             // need to clear with alpha = 1 for front to back blending
             glClearColor(0.0f,0.0f,0.0f,1.0f);
-            glClear(GL_COLOR_BUFFER_BIT);
+            glDepthMask(GL_TRUE);
+            glClearDepth(1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         }
 
         glEnable(GL_BLEND);
-        if(front_to_back){
+        if(blending == STOCHASTIC_BLENDING){
+            glDisable(GL_BLEND); // opaque fragments
+        }else if(blending == OIT_BLENDING){
+            glBlendEquation(GL_FUNC_ADD);
+            glBlendFunci(0, GL_ONE, GL_ONE);
+            glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+        }else if(front_to_back){
             glBlendEquation(GL_FUNC_ADD);
             glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE,GL_ZERO,GL_ONE_MINUS_SRC_ALPHA);
         }else{
             glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
         }
+        updateShadingRateImage();
+
         glDisable(GL_CULL_FACE);
+        glDisable(GL_DEPTH_TEST); // only used by the early termination, see markSaturatedPixels
+        glDepthMask(GL_FALSE);
 
 
         {
+            Profiler::GLScope profilerScope("test visibility");
             auto& q = timers[OPERATIONS::TEST_VISIBILITY].push_back();
             q.begin();
             // cull non-visible gaussians
@@ -140,18 +424,35 @@ void GaussianCloud::render(Camera &camera) {
         }
 
         // read back the number of visible gaussians. That's a cpu / gpu synchronization, but it's ok.
-        num_visible_gaussians = *(int*)glMapNamedBuffer(counter.getID(), GL_READ_ONLY);
-        glUnmapNamedBuffer(counter.getID());
+        // The number of color cache hits of the previous frame comes along with it.
+        {
+            Profiler::CpuScope stall("read back the visible count");
+            const int* counters = (int*)glMapNamedBuffer(counter.getID(), GL_READ_ONLY);
+            colorCacheLookups = num_visible_gaussians;
+            colorCacheHits = counters[1];
+            num_visible_gaussians = counters[0];
+            glUnmapNamedBuffer(counter.getID());
+        }
 
         // sort the gaussians by depth
         {
+            Profiler::GLScope profilerScope("sort");
             auto& q = timers[OPERATIONS::SORT].push_back();
             q.begin();
-            sort.sort(gaussians_depths, sorted_depths, gaussians_indices, sorted_gaussian_indices, num_visible_gaussians);
+            if(blending == OIT_BLENDING || blending == STOCHASTIC_BLENDING){
+                // the order doesn't matter, keep the order of testVisibility.cp
+                if(num_visible_gaussians > 0){
+                    glCopyNamedBufferSubData(gaussians_depths.getID(), sorted_depths.getID(), 0, 0, num_visible_gaussians * sizeof(float));
+                    glCopyNamedBufferSubData(gaussians_indices.getID(), sorted_gaussian_indices.getID(), 0, 0, num_visible_gaussians * sizeof(int));
+                }
+            }else{
+                sort.sort(gaussians_depths, sorted_depths, gaussians_indices, sorted_gaussian_indices, num_visible_gaussians);
+            }
             q.end();
         }
 
         {
+            Profiler::GLScope profilerScope("compute bounding boxes");
             auto& q = timers[OPERATIONS::COMPUTE_BOUNDING_BOXES].push_back();
             q.begin();
             computeBoundingBoxesShader.start();
@@ -162,16 +463,19 @@ void GaussianCloud::render(Camera &camera) {
         }
 
         {
+            Profiler::GLScope profilerScope("predict colors");
             auto& q = timers[OPERATIONS::PREDICT_COLORS_VISIBLE].push_back();
             q.begin();
             // Evaluate the sh basis only for the visible gaussians
-            // Groups of 128 threads, with 16 threads working together on the same gaussian: 8*16 = 128
-            predictColorsShader.start();
-            glDispatchCompute((num_visible_gaussians+7)/8, 1, 1);
-            glMemoryBarrier(GL_ALL_BARRIER_BITS);
-            predictColorsShader.stop();
+            dispatchPredictColors(interleavedSH);
             q.end();
         }
+        glCopyNamedBufferSubData(color_cache_hits.getID(), counter.getID(), 0, sizeof(int), sizeof(int));
+
+        if(compareColorKernels){
+            runColorKernelsComparison();
+            compareColorKernels = false;
+        }
 
         if(selected_gaussian != -1){
             glFinish();
@@ -184,51 +488,181 @@ void GaussianCloud::render(Camera &camera) {
             ImGui::Text("eigen_vec: %.2f %.2f", eigen_vec[0], eigen_vec[1]);
         }
 
-        {
+        if(blending == TILED_BLENDING || blending == HYBRID_BLENDING){
+            {
+                Profiler::GLScope profilerScope("bin tiles");
+                auto& q = timers[OPERATIONS::BIN_TILES].push_back();
+                q.begin();
+                binTiles(camera);
+                q.end();
+            }
+
+            Profiler::GLScope profilerScope("blend tiles");
+            auto& q = timers[OPERATIONS::BLEND_TILES].push_back();
+            q.begin();
+            if(blending == TILED_BLENDING){
+                blendTiles(0);
+            }else{
+                // Front to back (or back to front), blend the small splats of each depth slice with the tiles,
+                // then draw its large splats on top with the hardware blending.
+                VAO vao; // empty vertex array
+                hybrid_draws.bindAs(GL_DRAW_INDIRECT_BUFFER);
+                for(int slice=0; slice<depthSlices; slice++){
+                    blendTiles(slice);
+
+                    quadShader.start();
+                    vao.bind();
+                    setFoveatedShading(true);
+                    glDrawArraysIndirect(instancedStrips ? GL_TRIANGLE_STRIP : GL_TRIANGLES, reinterpret_cast<const void*>(slice * sizeof(uvec4)));
+                    setFoveatedShading(false);
+                    vao.unbind();
+                    quadShader.stop();
+                    // make the blended colors visible to the image loads of the next slice
+                    glTextureBarrier();
+                    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+                }
+                hybrid_draws.unbindAs(GL_DRAW_INDIRECT_BUFFER);
+            }
+            q.end();
+        }else{
+            Profiler::GLScope profilerScope("draw quads");
             auto& q = timers[OPERATIONS::DRAW_AS_QUADS].push_back();
             q.begin();
-            // draw a 2D quad for every visible gaussian
-            auto& s = softwareBlending ? quad_interlock_Shader : quadShader;
-            s.start();
+            Query* vertices = nullptr;
+            Query* fragments = nullptr;
+            if(pipelineStatistics){
+                vertices = &vertexInvocations.push_back();
+                fragments = &fragmentInvocations.push_back();
+                vertices->begin();
+                fragments->begin();
+            }
 
-            if(softwareBlending){
-                const GLuint ID = fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID();
-                glBindImageTexture(0, ID, 0, false, 0, GL_READ_WRITE, FBO_FORMAT);
+            // draw a 2D quad for every visible gaussian
+            auto& s = blending == INTERLOCK_BLENDING ? quad_interlock_Shader
+                    : blending == OIT_BLENDING ? quadOITShader
+                    : blending == STOCHASTIC_BLENDING ? quadStochasticShader
+                    : quadShader;
+
+            // The saturated pixels are marked in the depth buffer between the batches,
+            // the depth test then rejects their fragments before the fragment shader.
+            const bool mark_saturated = blending == HARDWARE_BLENDING && earlyTermination && front_to_back;
+            const int batches = mark_saturated ? terminationBatches : 1;
+            if(mark_saturated){
+                glEnable(GL_DEPTH_TEST);
+                glDepthFunc(GL_LESS);
+            }
+            if(blending == STOCHASTIC_BLENDING){
+                // the nearest fragment that passes the alpha test wins
+                glEnable(GL_DEPTH_TEST);
+                glDepthFunc(GL_LESS);
+                glDepthMask(GL_TRUE);
             }
 
             VAO vao; // empty vertex array
-            vao.bind();
-            glMemoryBarrier(GL_ALL_BARRIER_BITS);
-            glDrawArrays(GL_TRIANGLES, 0, num_visible_gaussians * 6);
-            glMemoryBarrier(GL_ALL_BARRIER_BITS);
-            vao.unbind();
+            for(int b=0; b<batches; b++){
+                const int first = int(int64_t(num_visible_gaussians) * b / batches);
+                const int last = int(int64_t(num_visible_gaussians) * (b+1) / batches);
+                if(b > 0){
+                    markSaturatedPixels();
+                }
+
+                s.start();
+                if(blending == INTERLOCK_BLENDING){
+                    const GLuint ID = fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID();
+                    glBindImageTexture(0, ID, 0, false, 0, GL_READ_WRITE, FBO_FORMAT);
+                }
+
+                vao.bind();
+                glMemoryBarrier(GL_ALL_BARRIER_BITS);
+                // the interlock blending writes a single pixel per fragment, it needs the full shading rate
+                setFoveatedShading(blending != INTERLOCK_BLENDING);
+                if(instancedStrips){
+                    glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, proxySides, last - first, first);
+                }else{
+                    glDrawArrays(GL_TRIANGLES, first * getProxyVertices(), (last - first) * getProxyVertices());
+                }
+                setFoveatedShading(false);
+                glMemoryBarrier(GL_ALL_BARRIER_BITS);
+                vao.unbind();
+                s.stop();
+            }
 
-            s.stop();
+            if(mark_saturated){
+                glDisable(GL_DEPTH_TEST);
+            }
+
+            if(blending == STOCHASTIC_BLENDING){
+                glDisable(GL_DEPTH_TEST);
+                glDepthMask(GL_FALSE);
+
+                // average with the previous frames
+                accumulateFramesShader.start();
+                glBindImageTexture(0, fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID(), 0, false, 0, GL_READ_WRITE, FBO_FORMAT);
+                glBindImageTexture(1, stochastic_accumulation->getID(), 0, false, 0, GL_READ_WRITE, GL_RGBA32F);
+                glTextureBarrier();
+                glMemoryBarrier(GL_ALL_BARRIER_BITS);
+                glDispatchCompute((fbo.getWidth()+15)/16, (fbo.getHeight()+15)/16, 1);
+                glMemoryBarrier(GL_ALL_BARRIER_BITS);
+                accumulateFramesShader.stop();
+                stochasticFrame++;
+            }
+
+            if(blending == OIT_BLENDING){
+                // resolve the transparency into the fbo
+                fbo.bind();
+                glDisable(GL_BLEND);
+                oitCompositeShader.start();
+                glBindImageTexture(0, oitfbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID(), 0, false, 0, GL_READ_ONLY, GL_RGBA32F);
+                glBindImageTexture(1, oitfbo.getAttachment(GL_COLOR_ATTACHMENT1)->getID(), 0, false, 0, GL_READ_ONLY, GL_R16F);
+                glTextureBarrier();
+                vao.bind();
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+                vao.unbind();
+                oitCompositeShader.stop();
+            }
+
+            if(pipelineStatistics){
+                vertices->end();
+                fragments->end();
+            }
             q.end();
         }
 
+        if(compareWithCpu){
+            runCpuComparison(camera);
+            compareWithCpu = false;
+        }
+
         glEnable(GL_CULL_FACE);
         glDisable(GL_BLEND);
 
         {
+            Profiler::GLScope profilerScope("blit fbo");
             auto& q = timers[OPERATIONS::BLIT_FBO].push_back();
             q.begin();
-            fbo.blit(0, GL_COLOR_BUFFER_BIT);
+            if(fbo.getWidth() == camera.getFramebufferSize().x && fbo.getHeight() == camera.getFramebufferSize().y){
+                fbo.blit(0, GL_COLOR_BUFFER_BIT);
+            }else{
+                // bilinear upsampling of the scaled fbo
+                fbo.blit(0, GL_COLOR_BUFFER_BIT, camera.getFramebufferSize().x, camera.getFramebufferSize().y, GL_LINEAR);
+            }
             q.end();
         }
 
-        if(softwareBlending){
+        if(blending == INTERLOCK_BLENDING || blending == TILED_BLENDING){
             emptyfbo.unbind();
         }else{
             fbo.unbind();
         }
+        glViewport(0, 0, camera.getFramebufferSize().x, camera.getFramebufferSize().y);
     }
 
     if(renderAsPoints) {
         glEnable(GL_DEPTH_TEST);
 
-        {
+        if(!bakedPointColors){
             // Predict colors for all the gaussians
+            Profiler::GLScope profilerScope("predict colors (all)");
             auto& q = timers[OPERATIONS::PREDICT_COLORS_ALL].push_back();
             q.begin();
             predictColorsForAllShader.start();
@@ -240,16 +674,18 @@ void GaussianCloud::render(Camera &camera) {
         }
 
         {
+            Profiler::GLScope profilerScope("draw points");
             auto& q = timers[OPERATIONS::DRAW_AS_POINTS].push_back();
             q.begin();
             // Draw as a point cloud
             glEnable(GL_PROGRAM_POINT_SIZE);
-            pointShader.start();
+            auto& s = bakedPointColors ? pointBakedShader : pointShader;
+            s.start();
             VAO vao; // empty vertex array
             vao.bind();
             glDrawArrays(GL_POINTS, 0, num_gaussians);
             vao.unbind();
-            pointShader.stop();
+            s.stop();
             q.end();
             glDisable(GL_PROGRAM_POINT_SIZE);
         }
@@ -258,47 +694,635 @@ void GaussianCloud::render(Camera &camera) {
 
 }
 
+void GaussianCloud::dispatchPredictColors(bool interleaved) {
+    if(interleaved){
+        // Groups of 128 threads, one thread per gaussian
+        predictColorsInterleavedShader.start();
+        glDispatchCompute((num_visible_gaussians+127)/128, 1, 1);
+        glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        predictColorsInterleavedShader.stop();
+    }else{
+        // Groups of 128 threads, with 16 threads working together on the same gaussian: 8*16 = 128
+        predictColorsShader.start();
+        glDispatchCompute((num_visible_gaussians+7)/8, 1, 1);
+        glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        predictColorsShader.stop();
+    }
+}
+
+float GaussianCloud::timeColorKernel(bool interleaved, int repetitions) {
+    dispatchPredictColors(interleaved); // warmup
+
+    QueryBuffer q(GL_TIME_ELAPSED, repetitions);
+    for(int i=0; i<repetitions; i++){
+        auto& query = q.push_back();
+        query.begin();
+        dispatchPredictColors(interleaved);
+        query.end();
+    }
+    glFinish();
+    return float(q.getTotal() * 1.0E-6 / repetitions);
+}
+
+void GaussianCloud::runColorKernelsComparison() {
+    // Both kernels write the same predicted_colors, so they can be run back to back on the current frame.
+    colorKernelTimes[0] = timeColorKernel(false, 20);
+    colorKernelTimes[1] = timeColorKernel(true, 20);
+    colorKernelsComparedOn = num_visible_gaussians;
+}
+
+std::vector<glm::vec4> GaussianCloud::readFramebuffer() {
+    std::vector<vec4> pixels(size_t(fbo.getWidth()) * size_t(fbo.getHeight()));
+    const GLuint ID = fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID();
+    glGetTextureImage(ID, 0, GL_RGBA, GL_FLOAT, GLsizei(pixels.size() * sizeof(vec4)), pixels.data());
+    return pixels;
+}
+
+void GaussianCloud::runCpuComparison(Camera &camera) {
+    if(!cpuRasterizer){
+        cpuRasterizer = std::make_unique<CpuRasterizer>();
+    }
+
+    Uniforms u = {};
+    fillUniforms(u, camera, fbo.getWidth(), fbo.getHeight());
+
+    // the cpu rasterizer reads the attributes from the cpu copies
+    if(positions_cpu.size() != size_t(num_gaussians)){
+        downloadAttributes(); // the gaussians have been densified on the gpu
+    }
+    u.positions = positions_cpu.data();
+    u.rotations = rotations_cpu.data();
+    u.scales = scales_cpu.data();
+    u.opacities = opacities_cpu.data();
+    u.sh_coeffs_interleaved = reinterpret_cast<vec4 *>(sh_coeffs_cpu.data());
+
+    if(cpuSimdProjection && gaussians_soa.count != num_gaussians){
+        gaussians_soa.build(positions_cpu, scales_cpu, rotations_cpu, opacities_cpu);
+    }
+
+    const std::vector<vec4> image = cpuRasterizer->render(u, cpuSimdProjection ? &gaussians_soa : nullptr);
+    cpuDifference = ImageCompare::compare(readFramebuffer(), image);
+    cpuTimings = cpuRasterizer->getTimings();
+    cpuVisibleGaussians = cpuRasterizer->getNumVisibleGaussians();
+
+    if(writeCpuRender){
+        const std::string path = "cpu_render.png";
+        if(CpuRasterizer::writePNG(path, image, fbo.getWidth(), fbo.getHeight())){
+            std::cout << "Cpu render written to " << path << std::endl;
+        }else{
+            std::cout << "Couldn't write " << path << std::endl;
+        }
+    }
+}
+
+void GaussianCloud::runSHLodSweep(Camera &camera) {
+    // Fixed camera path: views evenly spaced on the orbit around the current look-at point.
+    const int num_views = 8;
+    const float threshold_scales[] = {0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f};
+
+    const bool saved_lod = shLod;
+    const bool saved_cache = colorCache;
+    const bool saved_points = renderAsPoints;
+    const bool saved_quads = renderAsQuads;
+    const float saved_pixels[3] = {shLodPixels[0], shLodPixels[1], shLodPixels[2]};
+    colorCache = false;
+    renderAsPoints = false;
+    renderAsQuads = true;
+
+    Camera view = camera;
+    Camera::Pose pose = camera.getPose();
+    pose.freeCam = false;
+    auto setView = [&](int v){
+        Camera::Pose p = pose;
+        p.theta += 2.0f * glm::pi<float>() * float(v) / float(num_views);
+        view.setPose(p);
+    };
+
+    // full degree reference
+    shLod = false;
+    std::vector<std::vector<vec4>> references(num_views);
+    float reference_ms = 0.0f;
+    for(int v=0; v<num_views; v++){
+        setView(v);
+        render(view);
+        references[v] = readFramebuffer();
+        reference_ms += timeColorKernel(interleavedSH, 5);
+    }
+
+    shLodCurve.clear();
+    shLodCurve.push_back({0.0f, std::numeric_limits<float>::infinity(), reference_ms / float(num_views)});
+
+    shLod = true;
+    for(float scale : threshold_scales){
+        for(int i=0; i<3; i++){
+            shLodPixels[i] = saved_pixels[i] * scale;
+        }
+
+        double mse = 0.0;
+        float ms = 0.0f;
+        for(int v=0; v<num_views; v++){
+            setView(v);
+            render(view);
+            mse += ImageCompare::compare(readFramebuffer(), references[v]).mse;
+            ms += timeColorKernel(interleavedSH, 5);
+        }
+        mse /= double(num_views);
+        const float psnr = mse > 0.0 ? float(-10.0 * log10(mse)) : std::numeric_limits<float>::infinity();
+        shLodCurve.push_back({scale, psnr, ms / float(num_views)});
+    }
+
+    shLod = saved_lod;
+    colorCache = saved_cache;
+    renderAsPoints = saved_points;
+    renderAsQuads = saved_quads;
+    for(int i=0; i<3; i++){
+        shLodPixels[i] = saved_pixels[i];
+    }
+
+    std::cout << "threshold_scale,psnr_db,color_pass_ms" << std::endl;
+    for(const auto& sample : shLodCurve){
+        std::cout << sample.threshold_scale << "," << sample.psnr << "," << sample.color_pass_ms << std::endl;
+    }
+}
+
+void GaussianCloud::runProxyComparison(Camera &camera) {
+    const int repetitions = 10;
+    const int saved_sides = proxySides;
+    const bool saved_statistics = pipelineStatistics;
+    pipelineStatistics = true;
+
+    proxyComparison.clear();
+    for(int sides : {4, 6, 8}){
+        proxySides = sides;
+        for(int r=0; r<repetitions; r++){
+            render(camera);
+        }
+        glFinish();
+        const float ms = timers[OPERATIONS::DRAW_AS_QUADS].getNLastResults(repetitions) * 1.0E-6f / repetitions;
+        proxyComparison.push_back({sides, ms, fragmentInvocations.getLastResult()});
+    }
+
+    proxySides = saved_sides;
+    pipelineStatistics = saved_statistics;
+
+    std::cout << "sides,draw_ms,fragments" << std::endl;
+    for(const auto& sample : proxyComparison){
+        std::cout << sample.sides << "," << sample.draw_ms << "," << sample.fragments << std::endl;
+    }
+}
+
+void GaussianCloud::runOITComparison(Camera &camera) {
+    const int saved_blending = blending;
+
+    blending = HARDWARE_BLENDING;
+    render(camera);
+    const std::vector<vec4> reference = readFramebuffer();
+
+    blending = OIT_BLENDING;
+    render(camera);
+    oitDifference = ImageCompare::compare(readFramebuffer(), reference);
+    oitCompared = true;
+
+    blending = saved_blending;
+}
+
+void GaussianCloud::runStochasticConvergence(Camera &camera) {
+    const int max_frames = 256;
+    const int saved_blending = blending;
+
+    blending = HARDWARE_BLENDING;
+    render(camera);
+    const std::vector<vec4> reference = readFramebuffer();
+
+    // the accumulation restarts since the blending mode changed
+    blending = STOCHASTIC_BLENDING;
+    stochasticConvergence.clear();
+    for(int frames=1; frames<=max_frames; frames++){
+        render(camera);
+        if((frames & (frames - 1)) == 0){
+            const float psnr = float(ImageCompare::compare(readFramebuffer(), reference).psnr);
+            stochasticConvergence.push_back({frames, psnr});
+        }
+    }
+
+    blending = saved_blending;
+
+    std::cout << "frames,psnr_db" << std::endl;
+    for(const auto& sample : stochasticConvergence){
+        std::cout << sample.frames << "," << sample.psnr << std::endl;
+    }
+}
+
+void GaussianCloud::runBlendingComparison(Camera &camera) {
+    // Same fixed camera path as runSHLodSweep
+    const int num_views = 8;
+    const int repetitions = 5;
+
+    const int saved_blending = blending;
+    const bool saved_points = renderAsPoints;
+    const bool saved_quads = renderAsQuads;
+    renderAsPoints = false;
+    renderAsQuads = true;
+
+    Camera view = camera;
+    Camera::Pose pose = camera.getPose();
+    pose.freeCam = false;
+
+    for(int mode=0; mode<NUM_BLENDING_MODES; mode++){
+        blending = mode;
+        double total_ms = 0.0;
+        for(int v=0; v<num_views; v++){
+            Camera::Pose p = pose;
+            p.theta += 2.0f * glm::pi<float>() * float(v) / float(num_views);
+            view.setPose(p);
+
+            render(view); // warmup, the buffers may be resized on the first frame
+            glFinish();
+            const auto start = std::chrono::high_resolution_clock::now();
+            for(int r=0; r<repetitions; r++){
+                render(view);
+            }
+            glFinish();
+            const auto end = std::chrono::high_resolution_clock::now();
+            total_ms += std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+        }
+        blendingModeTimes[mode] = float(total_ms / num_views);
+    }
+
+    blending = saved_blending;
+    renderAsPoints = saved_points;
+    renderAsQuads = saved_quads;
+
+    const char* names[NUM_BLENDING_MODES] = {"hardware", "software", "tiled", "hybrid", "oit", "stochastic"};
+    std::cout << "blending,frame_ms" << std::endl;
+    for(int i=0; i<NUM_BLENDING_MODES; i++){
+        std::cout << names[i] << "," << blendingModeTimes[i] << std::endl;
+    }
+}
+
+float GaussianCloud::getQuadRenderingMs() {
+    const bool tiles = blending == TILED_BLENDING || blending == HYBRID_BLENDING;
+    float total = 0.0f;
+    for(int i=OPERATIONS::TEST_VISIBILITY; i<= OPERATIONS::BLIT_FBO; i++){
+        const bool tiles_op = i == OPERATIONS::BIN_TILES || i == OPERATIONS::BLEND_TILES;
+        if(i == OPERATIONS::DRAW_AS_QUADS ? tiles : tiles_op && !tiles){
+            continue; // timers of the other blending modes
+        }
+        total += timers[i].getLastResult() * 1.0E-6;
+    }
+    return total;
+}
+
+void GaussianCloud::updateRenderScale() {
+    if(!dynamicResolution || !renderAsQuads){
+        return;
+    }
+
+    // The timer queries are read a few frames late, wait for the results at the current scale.
+    if(++framesSinceScaleChange < 8){
+        return;
+    }
+
+    const float ms = getQuadRenderingMs();
+    if(ms <= 0.0f){
+        return;
+    }
+
+    // The cost is mostly proportional to the number of pixels, i.e. to the square of the scale.
+    // Over the budget, the scale goes down right away. Below the budget, it only goes up once the time
+    // is out of the hysteresis band, and by small steps, so that it doesn't oscillate around the target.
+    // The scale moves by steps of 1/32 to avoid reallocating the fbo for tiny changes.
+    float scale = renderScale * std::sqrt(targetFrameMs / ms);
+    if(ms > targetFrameMs){
+        scale = std::floor(std::max(scale, renderScale * 0.75f) * 32.0f) / 32.0f;
+    }else if(ms < targetFrameMs * (1.0f - scaleHysteresis)){
+        scale = std::round(std::min(scale, renderScale * 1.1f) * 32.0f) / 32.0f;
+    }else{
+        return;
+    }
+    scale = std::clamp(scale, minRenderScale, 1.0f);
+    if(scale != renderScale){
+        renderScale = scale;
+        framesSinceScaleChange = 0;
+    }
+}
+
 void GaussianCloud::initShaders() {
     pointShader.init_uniforms({});
+    pointBakedShader.init_uniforms({});
     testVisibilityShader.init_uniforms({});
     computeBoundingBoxesShader.init_uniforms({});
     quadShader.init_uniforms({});
     quad_interlock_Shader.init_uniforms({});
     predictColorsShader.init_uniforms({});
+    predictColorsInterleavedShader.init_uniforms({});
     predictColorsForAllShader.init_uniforms({});
+    emitTileKeysShader.init_uniforms({});
+    identifyTileRangesShader.init_uniforms({});
+    blendTilesShader.init_uniforms({"depth_slice"});
+    saturateShader.init_uniforms({});
+    quadOITShader.init_uniforms({});
+    quadStochasticShader.init_uniforms({});
+    accumulateFramesShader.init_uniforms({});
+    foveationRatesShader.init_uniforms({"texel_size"});
+    oitCompositeShader.init_uniforms({});
+
+    quad_interlock_bwd_Shader.init_uniforms({});
+    computeLossShader.init_uniforms({});
+    predictColorsBwdShader.init_uniforms({});
+    computeBoundingBoxesBwdShader.init_uniforms({});
+    adamStepShader.init_uniforms({"lr_positions", "lr_scales", "lr_rotations", "lr_opacities", "lr_sh_dc", "lr_sh_rest",
+                                  "beta1", "beta2", "adam_epsilon", "bias_correction1", "bias_correction2"});
+    densifyMarkShader.init_uniforms({});
+    densifyScatterShader.init_uniforms({});
+
+    // number of visible gaussians, color cache hits, number of tile keys, number of large splats
+    counter.storeData(nullptr, 4, sizeof(int), GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT, false, true, true);
+    hybrid_draws.storeData(nullptr, MAX_DEPTH_SLICES, sizeof(uvec4), 0, false, true, true);
+}
 
-    counter.storeData(nullptr, 1, sizeof(int), GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT, false, true, true);
+void GaussianCloud::invalidateColorCache() {
+    const int zero = 0;
+    color_cache_dirs.clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
 }
 
-// Helper to display a little (?) mark which shows a tooltip when hovered.
-// In your own code you may want to display an actual icon if you are using a merged icon fonts (see misc/fonts/README.txt)
-static void HelpMarker(const char* desc)
-{
-    ImGui::SameLine();
-    ImGui::TextDisabled("(?)");
-    if (ImGui::IsItemHovered())
-    {
-        ImGui::BeginTooltip();
-        ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
-        ImGui::TextUnformatted(desc);
-        ImGui::PopTextWrapPos();
-        ImGui::EndTooltip();
-    }
+void GaussianCloud::allocateWorkBuffers(bool cudaGLInterop) {
+    gaussians_depths.storeData(nullptr, capacity, sizeof(float), 0, cudaGLInterop, true, true);
+    gaussians_indices.storeData(nullptr, capacity, sizeof(int), 0, cudaGLInterop, true, true);
+    sorted_depths.storeData(nullptr, capacity, sizeof(float), 0, cudaGLInterop, true, true);
+    sorted_gaussian_indices.storeData(nullptr, capacity, sizeof(int), 0, cudaGLInterop, true, true);
+
+    bounding_boxes.storeData(nullptr, capacity, 4*sizeof(float), 0, cudaGLInterop, true, true);
+    conic_opacity.storeData(nullptr, capacity, 4*sizeof(float), 0, cudaGLInterop, true, true);
+    eigen_vecs.storeData(nullptr, capacity, 2*sizeof(float), 0, cudaGLInterop, true, true);
+    predicted_colors.storeData(nullptr, capacity, 4*sizeof(float), 0, cudaGLInterop, true, true);
+
+    tiles_touched.storeData(nullptr, capacity, sizeof(int), 0, cudaGLInterop, true, true);
+    tile_offsets.storeData(nullptr, capacity, sizeof(int), 0, cudaGLInterop, true, true);
+    large_splats.storeData(nullptr, capacity, sizeof(int), 0, cudaGLInterop, true, true);
+    large_splat_offsets.storeData(nullptr, capacity, sizeof(int), 0, cudaGLInterop, true, true);
+    large_splat_indices.storeData(nullptr, capacity, sizeof(int), 0, false, true, true);
+
+    // the cache is empty
+    color_cache_dirs.storeData(nullptr, capacity, 4*sizeof(float), 0, false, true, true);
+    color_cache_colors.storeData(nullptr, capacity, 4*sizeof(float), 0, false, true, true);
 }
 
+void GaussianCloud::downloadAttributes() {
+    // the number of gaussians changes with the densification
+    positions_cpu.resize(num_gaussians);
+    scales_cpu.resize(num_gaussians);
+    rotations_cpu.resize(num_gaussians);
+    opacities_cpu.resize(num_gaussians);
+    sh_coeffs_cpu.resize(size_t(num_gaussians) * 48);
+    glGetNamedBufferSubData(positions.getID(), 0, num_gaussians * sizeof(vec4), positions_cpu.data());
+    glGetNamedBufferSubData(scales.getID(), 0, num_gaussians * sizeof(vec4), scales_cpu.data());
+    glGetNamedBufferSubData(rotations.getID(), 0, num_gaussians * sizeof(vec4), rotations_cpu.data());
+    glGetNamedBufferSubData(opacities.getID(), 0, num_gaussians * sizeof(float), opacities_cpu.data());
+    glGetNamedBufferSubData(sh_coeffs_interleaved.getID(), 0, num_gaussians * 48 * sizeof(float), sh_coeffs_cpu.data());
+    gaussians_soa.count = 0; // rebuilt on the next cpu comparison
+}
 
 void GaussianCloud::GUI(Camera& camera) {
 
+    updateRenderScale();
+
     const float frac = num_visible_gaussians / float(num_gaussians) * 100.0f;
     ImGui::Text("There are %d currently visible gaussians (%.1f%%).", num_visible_gaussians, frac);
 
     ImGui::Checkbox("Render as points", &renderAsPoints);
+    if(renderAsPoints){
+        ImGui::Checkbox("Baked point colors", &bakedPointColors);
+        HelpMarker("Draw the points with the view-averaged colors baked at load time, "
+                   "instead of evaluating the spherical harmonics of all the gaussians every frame.");
+        if(bakedPointColors){
+            ImGui::SliderFloat("Decimation distance", &pointDecimationDistance, 0.0f, 100.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+            HelpMarker("Beyond this distance, the points are randomly dropped so that their density on screen stays roughly constant. "
+                       "Disabled when 0.");
+        }
+    }
     ImGui::Checkbox("Render as quads", &renderAsQuads);
+    if(renderAsQuads){
+        ImGui::Checkbox("Dynamic resolution", &dynamicResolution);
+        HelpMarker("Render the quads in a scaled down framebuffer, upsampled when blitting to the screen. "
+                   "The scale is adjusted from the measured gpu time of the quad rendering to stay within the budget: "
+                   "it goes down as soon as the budget is exceeded, and only goes up once the time is below "
+                   "(1 - hysteresis) * budget.");
+        if(dynamicResolution){
+            ImGui::SliderFloat("Frame time budget (ms)", &targetFrameMs, 1.0f, 50.0f, "%.1f");
+            ImGui::SliderFloat("Min render scale", &minRenderScale, 0.1f, 1.0f, "%.2f");
+            ImGui::SliderFloat("Hysteresis", &scaleHysteresis, 0.0f, 0.5f, "%.2f");
+            renderScale = std::max(renderScale, minRenderScale);
+        }else{
+            ImGui::SliderFloat("Render scale", &renderScale, 0.1f, 1.0f, "%.2f");
+        }
+        ImGui::Text("Render scale: %.3f (%dx%d), quad rendering: %.2fms", renderScale, fbo.getWidth(), fbo.getHeight(), getQuadRenderingMs());
+    }
+    if(renderAsQuads){
+        ImGui::Checkbox("Foveation", &foveation);
+        HelpMarker("Shade the quads with coarser pixels away from the gaze point: 2x2 pixels beyond the fovea radius, "
+                   "4x4 pixels beyond twice the radius (GL_NV_shading_rate_image), "
+                   "and cull the gaussians smaller than the coarse pixels. "
+                   "The culling applies to every blending mode, the coarse shading only to the fixed-function blending.");
+        if(foveation){
+            ImGui::Checkbox("Gaze follows the mouse", &gazeFollowsMouse);
+            ImGui::SliderFloat("Fovea radius", &foveaRadius, 0.01f, 1.0f, "%.2f");
+            HelpMarker("Relative to the height of the framebuffer.");
+            ImGui::RadioButton("Up to 2x2 pixels", &foveaMaxPixelSize, 2);
+            ImGui::SameLine();
+            ImGui::RadioButton("Up to 4x4 pixels", &foveaMaxPixelSize, 4);
+            ImGui::SliderFloat("Cull size", &foveaCullSize, 0.0f, 2.0f, "%.2f");
+            HelpMarker("Gaussians whose bounding box is smaller than this many coarse pixels are culled, 0 to disable.");
+            if(!GLAD_GL_NV_shading_rate_image){
+                ImGui::Text("GL_NV_shading_rate_image is not supported, only the culling is active.");
+            }
+        }
+    }
     ImGui::Checkbox("Antialiasing", &antialiasing);
     ImGui::Checkbox("Front to back blending", &front_to_back);
-    ImGui::Checkbox("Software alpha-blending", &softwareBlending);
+    ImGui::RadioButton("Hardware alpha-blending", &blending, HARDWARE_BLENDING);
+    HelpMarker("Draw a quad for every visible gaussian and blend them with the fixed-function blending.");
+    ImGui::RadioButton("Software alpha-blending", &blending, INTERLOCK_BLENDING);
     HelpMarker("Perform alpha-blending manually with ARB_fragment_shader_interlock "
                "to define a critical section in the fragment shader.");
+    if(blending == HARDWARE_BLENDING || blending == INTERLOCK_BLENDING){
+        ImGui::Checkbox("Early termination", &earlyTermination);
+        HelpMarker("Front to back only. Skip the fragments of the pixels whose transmittance is below the threshold. "
+                   "With the hardware blending, the quads are drawn in batches and the saturated pixels are written "
+                   "in the depth buffer between two batches, so that the depth test rejects their fragments. "
+                   "With the software blending, the fragments read the transmittance before entering the critical section.");
+        if(earlyTermination){
+            ImGui::SliderFloat("Termination transmittance", &terminationTransmittance, 0.0001f, 0.1f, "%.4f", ImGuiSliderFlags_Logarithmic);
+            if(blending == HARDWARE_BLENDING){
+                ImGui::SliderInt("Batches", &terminationBatches, 1, 64);
+            }
+        }
+        ImGui::Text("Splat proxy:");
+        ImGui::SameLine();
+        ImGui::RadioButton("Quad", &proxySides, 4);
+        ImGui::SameLine();
+        ImGui::RadioButton("Hexagon", &proxySides, 6);
+        ImGui::SameLine();
+        ImGui::RadioButton("Octagon", &proxySides, 8);
+        HelpMarker("Polygon drawn for each splat, circumscribed to the ellipse where the opacity reaches min_opacity. "
+                   "The fraction of the polygon outside of the ellipse, shaded then discarded, "
+                   "is 21.5% for the quad, 9.3% for the hexagon and 5.2% for the octagon, at the cost of 6, 12 or 18 vertices (4, 6 or 8 with triangle strips).");
+        if(ImGui::Button("Compare proxies")){
+            runProxyComparison(camera);
+        }
+        for(const auto& sample : proxyComparison){
+            ImGui::Text("%d sides: %.3fms, %.2fM fragments", sample.sides, sample.draw_ms, sample.fragments * 1.0E-6);
+        }
+        ImGui::Checkbox("Instanced triangle strips", &instancedStrips);
+        HelpMarker("Draw one instance of a triangle strip per splat, with one vertex per corner of the polygon, "
+                   "instead of a list of triangles that repeats the shared corners. "
+                   "The vertex shader fetches the bounding box and builds the rotation once per corner.");
+    }
+    ImGui::RadioButton("Tiled compute rasterizer", &blending, TILED_BLENDING);
+    HelpMarker("Bin the visible gaussians into 16x16 pixel tiles, sort them by tile then depth, "
+               "and blend each tile in a compute shader that loads the gaussians in shared memory by batches of 256, "
+               "and stops each pixel once it is opaque.");
+    ImGui::RadioButton("Hybrid tiles and quads", &blending, HYBRID_BLENDING);
+    HelpMarker("Blend the gaussians with a small oriented bounding box with the tiles, and draw the large ones as quads. "
+               "The visible gaussians are split in depth slices, and the two paths are interleaved slice by slice, "
+               "so the blending order is only approximate inside of a slice.");
+    if(blending == HYBRID_BLENDING){
+        ImGui::SliderFloat("Max tiled area (px)", &hybridMaxArea, 1.0f, 10000.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+        ImGui::SliderInt("Depth slices", &depthSlices, 1, MAX_DEPTH_SLICES);
+        if(num_visible_gaussians > 0){
+            ImGui::Text("Large splats: %d (%.1f%%)", num_large_splats, num_large_splats * 100.0f / float(num_visible_gaussians));
+        }
+    }
+    ImGui::RadioButton("Weighted blended OIT", &blending, OIT_BLENDING);
+    HelpMarker("Approximate order-independent transparency that skips the sort: the colors are averaged "
+               "with weights that decrease with the depth, and the coverage is the product of the (1 - alpha). "
+               "Fast, but the nearest gaussians don't fully hide the farther ones.");
+    if(blending == OIT_BLENDING){
+        if(ImGui::Button("Compare with the sorted render")){
+            runOITComparison(camera);
+        }
+        HelpMarker("Renders the current view with the hardware blending of the sorted gaussians, then with the weighted blended OIT, "
+                   "and compares the two images.");
+        if(oitCompared){
+            ImGui::Text("PSNR: %.2fdB, mean abs error: %.5f, max abs error: %.4f",
+                        oitDifference.psnr, oitDifference.mean_abs, oitDifference.max_abs);
+            ImGui::Text("Pixels off by more than 1/255: %.3f%%", oitDifference.fraction_above * 100.0f);
+        }
+    }
+    ImGui::RadioButton("Stochastic transparency", &blending, STOCHASTIC_BLENDING);
+    HelpMarker("Sort-free: each fragment is drawn as opaque with a probability equal to its alpha, with the depth test. "
+               "The expected color is the same as the front to back blending, "
+               "and the frames are averaged while the view and the settings don't change.");
+    if(blending == STOCHASTIC_BLENDING){
+        ImGui::Text("Accumulated frames: %d", stochasticFrame);
+        if(ImGui::Button("Measure convergence")){
+            runStochasticConvergence(camera);
+        }
+        HelpMarker("Renders the current view with the hardware blending of the sorted gaussians, "
+                   "then accumulates 256 frames with the stochastic transparency, and reports the PSNR against "
+                   "the sorted render after 1, 2, 4, ... frames. The results are also printed as csv.");
+        for(const auto& sample : stochasticConvergence){
+            ImGui::Text("%d frames: %.2fdB", sample.frames, sample.psnr);
+        }
+    }
+    if((blending == TILED_BLENDING || blending == HYBRID_BLENDING) && num_visible_gaussians > 0){
+        ImGui::Text("Tile keys: %d (%.2f per visible gaussian)", num_tile_keys, num_tile_keys / float(num_visible_gaussians));
+    }
+    if(ImGui::TreeNode("Blending modes benchmark")){
+        if(ImGui::Button("Compare blending modes")){
+            runBlendingComparison(camera);
+        }
+        HelpMarker("Renders an orbit of 8 views around the current look-at point with each blending mode, "
+                   "and reports the average frame time, including the cpu / gpu synchronizations. "
+                   "The results are also printed as csv.");
+        const char* names[NUM_BLENDING_MODES] = {"Hardware", "Software", "Tiled", "Hybrid", "Weighted blended OIT", "Stochastic"};
+        for(int i=0; i<NUM_BLENDING_MODES; i++){
+            if(blendingModeTimes[i] > 0.0f){
+                ImGui::Text("%s: %.3fms", names[i], blendingModeTimes[i]);
+            }
+        }
+        ImGui::TreePop();
+    }
+    ImGui::Checkbox("Interleaved SH (one thread per gaussian)", &interleavedSH);
+    HelpMarker("Evaluate the view-dependent colors with one thread per gaussian, "
+               "reading the 48 coefficients from an interleaved buffer with vectorized loads, "
+               "instead of 16 threads per gaussian reading the 3 color channels separately.");
+    ImGui::Checkbox("SH level of detail", &shLod);
+    HelpMarker("Select the degree of the spherical harmonics of each gaussian from the half extent "
+               "of its oriented bounding box, so that small splats only read the coefficients they need.");
+    if(shLod){
+        ImGui::SliderFloat3("Degree 1 / 2 / 3 from (px)", shLodPixels, 0.1f, 100.0f, "%.1f", ImGuiSliderFlags_Logarithmic);
+    }
+    if(ImGui::TreeNode("SH level of detail sweep")){
+        if(ImGui::Button("Run sweep")){
+            runSHLodSweep(camera);
+        }
+        HelpMarker("Renders an orbit of 8 views around the current look-at point with full degree spherical harmonics, "
+                   "then with the level of detail thresholds scaled by several factors, "
+                   "and reports the PSNR against the full degree renders and the color pass time. "
+                   "The results are also printed as csv.");
+        for(const auto& sample : shLodCurve){
+            if(sample.threshold_scale == 0.0f){
+                ImGui::Text("Full degree: %.3fms", sample.color_pass_ms);
+            }else{
+                ImGui::Text("Thresholds x%.2f: %.2fdB, %.3fms", sample.threshold_scale, sample.psnr, sample.color_pass_ms);
+            }
+        }
+        ImGui::TreePop();
+    }
+
+    if(ImGui::TreeNode("CPU reference")){
+        if(renderAsQuads){
+            if(ImGui::Button("Render on the cpu and compare")){
+                compareWithCpu = true;
+            }
+            HelpMarker("Renders the current frame with the cpu rasterizer, which uses the same formulas as the shaders, "
+                       "and compares it with the gpu render. "
+                       "The color cache should be disabled for the colors to match exactly.");
+            ImGui::Checkbox("Write cpu_render.png", &writeCpuRender);
+            ImGui::Checkbox("Batched projection", &cpuSimdProjection);
+            HelpMarker("Project the gaussians with the batched kernels of CpuProjection, "
+                       "with the best instruction set of the cpu, instead of the scalar functions of Covariance.h.");
+            if(cpuSimdProjection){
+                ImGui::SameLine();
+                ImGui::Text("(%s)", CpuProjection::getName(CpuProjection::detectISA()));
+            }
+        }else{
+            ImGui::Text("Only available when rendering as quads.");
+        }
+        if(cpuVisibleGaussians >= 0){
+            ImGui::Text("Visible gaussians: %d (gpu: %d)", cpuVisibleGaussians, num_visible_gaussians);
+            ImGui::Text("Project: %.1fms, sort: %.1fms, binning: %.1fms, blend: %.1fms, total: %.1fms",
+                        cpuTimings.project_ms, cpuTimings.sort_ms, cpuTimings.binning_ms, cpuTimings.blend_ms, cpuTimings.total_ms);
+            ImGui::Text("PSNR: %.2fdB, mean abs error: %.5f, max abs error: %.4f",
+                        cpuDifference.psnr, cpuDifference.mean_abs, cpuDifference.max_abs);
+            ImGui::Text("Pixels off by more than 1/255: %.3f%%", cpuDifference.fraction_above * 100.0f);
+        }
+        ImGui::TreePop();
+    }
+
+    ImGui::Checkbox("View-direction color cache", &colorCache);
+    HelpMarker("Reuse the color of a visible gaussian when the direction from the camera "
+               "to its center is within the angular threshold of the direction the color was evaluated at.");
+    if(colorCache){
+        ImGui::SliderFloat("Cache angular threshold", &colorCacheMaxAngle, 0.01f, 5.0f, "%.2f deg", ImGuiSliderFlags_Logarithmic);
+        const float hit_rate = colorCacheLookups > 0 ? colorCacheHits / float(colorCacheLookups) * 100.0f : 0.0f;
+        ImGui::Text("Cache hit rate: %.1f%% (%d / %d)", hit_rate, colorCacheHits, colorCacheLookups);
+        if(uncachedColorPassNsPerGaussian > 0.0f){
+            const float uncached = uncachedColorPassNsPerGaussian * num_visible_gaussians * 1.0E-6f;
+            const float cached = timers[OPERATIONS::PREDICT_COLORS_VISIBLE].getLastResult() * 1.0E-6f;
+            ImGui::Text("Time saved: %.3fms (%.3fms without the cache)", uncached - cached, uncached);
+        }else{
+            ImGui::Text("Time saved: disable the cache once to measure the uncached color pass.");
+        }
+        if(ImGui::Button("Invalidate color cache")){
+            invalidateColorCache();
+        }
+    }else if(num_visible_gaussians > 0){
+        // exponential moving average of the cost of the color pass without the cache
+        const float ns = timers[OPERATIONS::PREDICT_COLORS_VISIBLE].getLastResult() / float(num_visible_gaussians);
+        uncachedColorPassNsPerGaussian = uncachedColorPassNsPerGaussian > 0.0f ? uncachedColorPassNsPerGaussian * 0.95f + ns * 0.05f : ns;
+    }
     ImGui::SliderFloat("scale_modifier", &scale_modifier, 0.001f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
     ImGui::SliderFloat("min_opacity", &min_opacity, 0.01f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
 
@@ -314,11 +1338,13 @@ void GaussianCloud::GUI(Camera& camera) {
     if(ImGui::TreeNode("Timers")){
         if(renderAsPoints){
             ImGui::Text("Point rendering:");
-            ImGui::Text("Predict colors: %.3fms", timers[OPERATIONS::PREDICT_COLORS_ALL].getLastResult() * 1.0E-6);
+            if(!bakedPointColors){
+                ImGui::Text("Predict colors: %.3fms", timers[OPERATIONS::PREDICT_COLORS_ALL].getLastResult() * 1.0E-6);
+            }
             ImGui::Text("Draw points: %.3fms", timers[OPERATIONS::DRAW_AS_POINTS].getLastResult() * 1.0E-6);
 
             float total = 0.0f;
-            for(int i=0; i<= OPERATIONS::DRAW_AS_POINTS; i++){
+            for(int i=bakedPointColors ? OPERATIONS::DRAW_AS_POINTS : 0; i<= OPERATIONS::DRAW_AS_POINTS; i++){
                 total += timers[i].getLastResult() * 1.0E-6;
             }
             ImGui::Text("Total: %.3fms", total);
@@ -331,14 +1357,36 @@ void GaussianCloud::GUI(Camera& camera) {
             ImGui::Text("Sort: %.3fms", timers[OPERATIONS::SORT].getLastResult() * 1.0E-6);
             ImGui::Text("Compute bounding boxes: %.3fms", timers[OPERATIONS::COMPUTE_BOUNDING_BOXES].getLastResult() * 1.0E-6);
             ImGui::Text("Predict colors: %.3fms", timers[OPERATIONS::PREDICT_COLORS_VISIBLE].getLastResult() * 1.0E-6);
-            ImGui::Text("Draw quads: %.3fms", timers[OPERATIONS::DRAW_AS_QUADS].getLastResult() * 1.0E-6);
+            const bool tiles = blending == TILED_BLENDING || blending == HYBRID_BLENDING;
+            if(tiles){
+                ImGui::Text("Bin tiles: %.3fms", timers[OPERATIONS::BIN_TILES].getLastResult() * 1.0E-6);
+                ImGui::Text(blending == HYBRID_BLENDING ? "Blend tiles and draw quads: %.3fms" : "Blend tiles: %.3fms",
+                            timers[OPERATIONS::BLEND_TILES].getLastResult() * 1.0E-6);
+            }else{
+                ImGui::Text("Draw quads: %.3fms", timers[OPERATIONS::DRAW_AS_QUADS].getLastResult() * 1.0E-6);
+                ImGui::Checkbox("Pipeline statistics", &pipelineStatistics);
+                HelpMarker("Number of vertex and fragment shader invocations of the quads, with pipeline statistics queries.");
+                if(pipelineStatistics && num_visible_gaussians > 0){
+                    const int64_t vertices = vertexInvocations.getLastResult();
+                    const int64_t fragments = fragmentInvocations.getLastResult();
+                    ImGui::Text("Vertex shader invocations: %.2fM (%.2f per visible gaussian)",
+                                vertices * 1.0E-6, vertices / double(num_visible_gaussians));
+                    ImGui::Text("Fragment shader invocations: %.2fM (overdraw: %.2f per pixel)",
+                                fragments * 1.0E-6, fragments / double(fbo.getWidth() * fbo.getHeight()));
+                }
+            }
             ImGui::Text("Blit framebuffer: %.3fms", timers[OPERATIONS::BLIT_FBO].getLastResult() * 1.0E-6);
 
-            float total = 0.0f;
-            for(int i=OPERATIONS::TEST_VISIBILITY; i<= OPERATIONS::BLIT_FBO; i++){
-                total += timers[i].getLastResult() * 1.0E-6;
+            ImGui::Text("Total: %.3fms", getQuadRenderingMs());
+
+            if(ImGui::Button("Compare color kernels")){
+                compareColorKernels = true;
+            }
+            if(colorKernelsComparedOn > 0){
+                ImGui::Text("On %d visible gaussians:", colorKernelsComparedOn);
+                ImGui::Text("16 threads per gaussian: %.3fms", colorKernelTimes[0]);
+                ImGui::Text("1 thread per gaussian, interleaved: %.3fms", colorKernelTimes[1]);
             }
-            ImGui::Text("Total: %.3fms", total);
 
             ImGui::Separator();
         }
@@ -13,16 +13,22 @@
 #include "RenderingBase/GLTimer.h"
 #include "RenderingBase/FBO.h"
 #include "Sort.cuh"
+#include "CpuRasterizer.h"
+#include "ImageCompare.h"
+
+struct Uniforms;
 
 class GaussianCloud {
 public:
     bool initialized = false;
     int num_gaussians;
+    int capacity = 0; // number of gaussians the buffers can hold, >= num_gaussians, grows with the densification
 
     std::vector<glm::vec4> positions_cpu;
     std::vector<glm::vec4> scales_cpu;
     std::vector<glm::vec4> rotations_cpu;
     std::vector<float> opacities_cpu;
+    std::vector<float> sh_coeffs_cpu; // interleaved, 48 floats per gaussian
 
     // values for all the gaussians
     GLBuffer positions; // x, y, z, padding
@@ -30,6 +36,8 @@ public:
     GLBuffer rotations; // rx, ry, rz, rw
     GLBuffer opacities; // alpha
     GLBuffer sh_coeffs[3]; // 3 color channels, 16 coeffs each
+    GLBuffer sh_coeffs_interleaved; // 16 coeffs, with the 3 color channels next to each other
+    GLBuffer baked_colors; // view-averaged colors packed as rgba8, for the point cloud preview
 
     // values only for the gaussians that are visible, packed tightly without gaps
     GLBuffer conic_opacity;
@@ -43,39 +51,235 @@ public:
     GLBuffer sorted_depths;
     GLBuffer sorted_gaussian_indices;
 
+    // tiled rasterizer
+    GLBuffer tiles_touched; // number of tiles overlapped by each visible gaussian
+    GLBuffer tile_offsets; // inclusive prefix sum of tiles_touched
+    GLBuffer tile_keys; // (tile index << 32) | index in the depth order, grown on demand
+    GLBuffer sorted_tile_keys;
+    GLBuffer tile_ranges; // [begin, end) of the keys of each tile and depth slice, resized with the fbo
+
+    // hybrid rasterizer
+    GLBuffer large_splats; // 1 if the visible gaussian is drawn as a quad
+    GLBuffer large_splat_offsets; // inclusive prefix sum of large_splats
+    GLBuffer large_splat_indices; // indices in the depth order of the large splats
+    GLBuffer hybrid_draws; // indirect draw command of the large splats of each depth slice
+
+    // view-dependent colors cached for all the gaussians, with the direction they were evaluated at
+    GLBuffer color_cache_dirs;
+    GLBuffer color_cache_colors;
+    GLBuffer color_cache_hits;
+
+    // gradients of the training loss, allocated by the Trainer
+    GLBuffer dLoss_dpositions;
+    GLBuffer dLoss_dscales;
+    GLBuffer dLoss_drotations;
+    GLBuffer dLoss_dopacities;
+    GLBuffer dLoss_dsh_coeffs[3]; // same layout as sh_coeffs
+    GLBuffer dLoss_dconic_opacity; // f16vec4, for the visible gaussians in the depth order
+    GLBuffer dLoss_dpredicted_colors; // f16vec4, same
+    GLBuffer dLoss_dmean2D; // f16vec2, same
+    GLBuffer dLoss_dconic_opacity_fp32; // same as the 3 above, in fp32 for the GRADIENTS_FP32_* modes
+    GLBuffer dLoss_dpredicted_colors_fp32;
+    GLBuffer dLoss_dmean2D_fp32;
+    GLBuffer training_loss; // sum of the squared errors of the last training view
+
+    // moments of the Adam optimizer, allocated by the Trainer, see CommonTypes.h for the layout
+    GLBuffer moments_positions;
+    GLBuffer moments_scales;
+    GLBuffer moments_rotations;
+    GLBuffer moments_opacities;
+    GLBuffer moments_sh;
+    GLBuffer densification_stats; // vec2 for each gaussian, see Densification.h
+
     void initShaders();
+    // (Re)allocates the buffers holding the intermediate values of the rendering for each gaussian, with room for capacity gaussians
+    void allocateWorkBuffers(bool cudaGLInterop=true);
+    void invalidateColorCache();
+    // copies the attributes back to the cpu after they have been modified on the gpu
+    void downloadAttributes();
     void GUI(Camera& camera);
     void render(Camera& camera);
 
 private:
     Shader pointShader = GLShaderLoader::load("point.vs", "point.fs");
+    Shader pointBakedShader = GLShaderLoader::load("point_baked.vs", "point.fs");
     Shader quadShader = GLShaderLoader::load("quad.vs", "quad.fs");
     Shader quad_interlock_Shader = GLShaderLoader::load("quad_interlock.vs", "quad_interlock.fs");
     Shader testVisibilityShader = GLShaderLoader::load("testVisibility.cp");
     Shader computeBoundingBoxesShader = GLShaderLoader::load("computeBoundingBoxes.cp");
     Shader predictColorsShader = GLShaderLoader::load("predict_colors.cp");
+    Shader predictColorsInterleavedShader = GLShaderLoader::load("predict_colors_interleaved.cp");
     Shader predictColorsForAllShader = GLShaderLoader::load("predict_colors_for_all.cp");
+    Shader emitTileKeysShader = GLShaderLoader::load("emitTileKeys.cp");
+    Shader identifyTileRangesShader = GLShaderLoader::load("identifyTileRanges.cp");
+    Shader blendTilesShader = GLShaderLoader::load("blendTiles.cp");
+    Shader quadOITShader = GLShaderLoader::load("quad.vs", "quad_oit.fs");
+    Shader quadStochasticShader = GLShaderLoader::load("quad.vs", "quad_stochastic.fs");
+    Shader accumulateFramesShader = GLShaderLoader::load("accumulateFrames.cp");
+    Shader foveationRatesShader = GLShaderLoader::load("foveationRates.cp");
+    Shader oitCompositeShader = GLShaderLoader::load("fullscreen.vs", "oit_composite.fs");
+    Shader saturateShader = GLShaderLoader::load("fullscreen.vs", "saturate.fs");
+
+    // reads the stage timers
+    friend class Benchmark;
 
-    // Backward pass
+    // Backward pass, see Trainer
+    friend class Trainer;
     Shader quad_interlock_bwd_Shader = GLShaderLoader::load("quad_interlock_bwd.vs", "quad_interlock_bwd.fs");
+    Shader computeLossShader = GLShaderLoader::load("computeLoss.cp");
+    Shader predictColorsBwdShader = GLShaderLoader::load("predict_colors_bwd.cp");
+    Shader computeBoundingBoxesBwdShader = GLShaderLoader::load("computeBoundingBoxes_bwd.cp");
+    Shader adamStepShader = GLShaderLoader::load("adamStep.cp");
+    Shader densifyMarkShader = GLShaderLoader::load("densifyMark.cp");
+    Shader densifyScatterShader = GLShaderLoader::load("densifyScatter.cp");
+    uint64_t groundTruthImage = 0; // image handle of the target of the training view, 0 otherwise
+    int gradientAccumulation = 0; // GRADIENTS_* mode of quad_interlock_bwd.fs, see CommonTypes.h
 
+    void fillUniforms(Uniforms& u, Camera& camera, int width, int height) const;
+    void uploadUniforms(Camera& camera);
     void prepareRender(Camera& camera);
+    void binTiles(Camera& camera);
+    void blendTiles(int depth_slice);
+    void markSaturatedPixels();
 
     GLBuffer uniforms;
     FBO fbo;
     FBO emptyfbo;
+    FBO oitfbo; // accumulation and revealage targets of the weighted blended transparency
 
     Sort sort;
 
     int num_visible_gaussians = 0;
     bool renderAsPoints = true;
     bool renderAsQuads = false;
+    bool bakedPointColors = false;
+    float pointDecimationDistance = 0.0f; // disabled when <= 0
     float scale_modifier = 1.0f;
     bool antialiasing = false;
     float min_opacity = 0.02f;
     bool front_to_back = true;
     int selected_gaussian = -1;
-    bool softwareBlending = false;
+
+    enum BLENDING{
+        HARDWARE_BLENDING, // fixed-function blending of the quads
+        INTERLOCK_BLENDING, // manual blending of the quads with ARB_fragment_shader_interlock
+        TILED_BLENDING, // gaussians binned in screen tiles and blended in a compute shader
+        HYBRID_BLENDING, // small splats blended with the tiles, large splats drawn as quads, interleaved by depth slices
+        OIT_BLENDING, // weighted blended order-independent transparency, without sorting
+        STOCHASTIC_BLENDING, // depth tested quads with a hashed alpha test, averaged over the frames, without sorting
+        NUM_BLENDING_MODES
+    };
+    int blending = HARDWARE_BLENDING;
+
+    static const int TILE_SIZE = 16; // same as Tiles.h
+    static const int MAX_DEPTH_SLICES = 32; // same as Tiles.h
+    int num_tile_keys = 0; // number of (tile, gaussian) pairs of the last frame
+    int num_large_splats = 0; // number of gaussians drawn as quads in the hybrid mode during the last frame
+    float hybridMaxArea = 64.0f; // in pixels, the larger oriented bounding boxes are drawn as quads
+    int depthSlices = 8;
+
+    // Early termination of the saturated pixels in front to back mode.
+    // With the hardware blending, the quads are drawn in batches and the saturated pixels are marked in the depth buffer
+    // between two batches. With the software blending, the fragments of the saturated pixels are discarded.
+    bool earlyTermination = false;
+    float terminationTransmittance = 1.0f / 255.0f;
+    int terminationBatches = 8;
+
+    // pipeline statistics of the quads
+    bool pipelineStatistics = false;
+    QueryBuffer vertexInvocations = QueryBuffer(GL_VERTEX_SHADER_INVOCATIONS, 10);
+    QueryBuffer fragmentInvocations = QueryBuffer(GL_FRAGMENT_SHADER_INVOCATIONS, 10);
+
+    // Dynamic resolution: the fbo is scaled down to render the quads within the frame time budget, then upsampled by the blit
+    bool dynamicResolution = false;
+    float renderScale = 1.0f; // fbo size relative to the framebuffer
+    float minRenderScale = 0.25f;
+    float targetFrameMs = 16.0f; // gpu time of the quad rendering
+    float scaleHysteresis = 0.2f; // the scale only increases below (1 - hysteresis) * targetFrameMs
+    int framesSinceScaleChange = 0;
+    glm::ivec2 renderSize = glm::ivec2(0); // size of the fbo when > 0, instead of the scaled framebuffer size
+    float getQuadRenderingMs();
+    void updateRenderScale();
+
+    // Foveation, see Foveation.h
+    bool foveation = false;
+    bool gazeFollowsMouse = true; // the gaze point is the center of the screen otherwise
+    float foveaRadius = 0.25f; // relative to the height of the fbo
+    int foveaMaxPixelSize = 4;
+    float foveaCullSize = 1.0f;
+    std::unique_ptr<Texture2D> shading_rate_image; // null when GL_NV_shading_rate_image isn't supported
+    glm::ivec2 shadingRateTexelSize = glm::ivec2(16);
+    bool useShadingRateImage() const;
+    void updateShadingRateImage();
+    void setFoveatedShading(bool enable);
+
+    // Number of sides of the polygon drawn for each splat, see SplatProxy.h
+    int proxySides = 4;
+    bool instancedStrips = false; // one instance of a triangle strip per splat instead of a list of triangles
+    int getProxyVertices() const{
+        return 3 * (proxySides - 2); // same as SplatProxy.h
+    }
+    struct ProxySample{
+        int sides;
+        float draw_ms; // time to draw the quads
+        int64_t fragments; // fragment shader invocations
+    };
+    std::vector<ProxySample> proxyComparison;
+    void runProxyComparison(Camera& camera);
+
+    bool oitCompared = false;
+    ImageDifference oitDifference; // against the sorted hardware blending
+    void runOITComparison(Camera& camera);
+
+    std::unique_ptr<Texture2D> stochastic_accumulation; // running average of the frames, resized with the fbo
+    std::vector<char> stochasticKey; // uniforms of the accumulated frames
+    int stochasticFrame = 0; // number of accumulated frames
+    struct ConvergenceSample{
+        int frames;
+        float psnr; // against the sorted hardware blending
+    };
+    std::vector<ConvergenceSample> stochasticConvergence;
+    void runStochasticConvergence(Camera& camera);
+
+    float blendingModeTimes[NUM_BLENDING_MODES] = {}; // average frame time in ms of each mode, 0 until measured
+    void runBlendingComparison(Camera& camera);
+    bool interleavedSH = false;
+
+    bool compareColorKernels = false;
+    float colorKernelTimes[2] = {0.0f, 0.0f}; // 16 threads per gaussian, 1 thread per gaussian
+    int colorKernelsComparedOn = 0; // number of visible gaussians during the comparison
+
+    bool colorCache = false;
+    float colorCacheMaxAngle = 0.5f; // in degrees
+    int colorCacheHits = 0; // number of cache hits during the last color pass read back
+    int colorCacheLookups = 0; // number of visible gaussians during that same color pass
+    float uncachedColorPassNsPerGaussian = 0.0f; // measured while the cache is disabled
+
+    bool shLod = false;
+    float shLodPixels[3] = {1.5f, 4.0f, 10.0f}; // minimum footprint in pixels for the degrees 1, 2 and 3
+
+    struct SHLodSample{
+        float threshold_scale; // multiplies shLodPixels, 0 for the full degree reference
+        float psnr; // against the full degree render, averaged over the camera path
+        float color_pass_ms; // averaged over the camera path
+    };
+    std::vector<SHLodSample> shLodCurve;
+
+    std::unique_ptr<CpuRasterizer> cpuRasterizer; // created on first use
+    bool compareWithCpu = false;
+    bool writeCpuRender = false;
+    bool cpuSimdProjection = true;
+    GaussiansSoA gaussians_soa; // built on first use by the cpu rasterizer
+    int cpuVisibleGaussians = -1; // -1 until the first comparison
+    CpuRasterizer::Timings cpuTimings;
+    ImageDifference cpuDifference;
+
+    void dispatchPredictColors(bool interleaved);
+    float timeColorKernel(bool interleaved, int repetitions);
+    void runColorKernelsComparison();
+    void runSHLodSweep(Camera& camera);
+    std::vector<glm::vec4> readFramebuffer();
+    void runCpuComparison(Camera& camera);
 
     enum OPERATIONS{
         PREDICT_COLORS_ALL,
@@ -85,6 +289,8 @@ private:
         COMPUTE_BOUNDING_BOXES,
         PREDICT_COLORS_VISIBLE,
         DRAW_AS_QUADS,
+        BIN_TILES,
+        BLEND_TILES,
         BLIT_FBO,
         NUM_OPS
     };
@@ -0,0 +1,45 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "ImageCompare.h"
+
+#include <cmath>
+#include <cassert>
+#include <limits>
+#include "glm/vec3.hpp"
+#include "glm/common.hpp"
+
+using namespace glm;
+
+ImageDifference ImageCompare::compare(const std::vector<glm::vec4> &image, const std::vector<glm::vec4> &reference, float threshold) {
+    assert(image.size() == reference.size());
+
+    ImageDifference res;
+    if(image.empty()){
+        return res;
+    }
+
+    double sum_sq = 0.0;
+    double sum_abs = 0.0;
+    size_t above = 0;
+    for(size_t i=0; i<image.size(); i++){
+        const vec3 a = clamp(vec3(image[i]), 0.0f, 1.0f);
+        const vec3 b = clamp(vec3(reference[i]), 0.0f, 1.0f);
+        const vec3 d = abs(a - b);
+
+        sum_sq += double(d.x) * d.x + double(d.y) * d.y + double(d.z) * d.z;
+        sum_abs += double(d.x) + d.y + d.z;
+        res.max_abs = max(res.max_abs, max(d.x, max(d.y, d.z)));
+        if(d.x > threshold || d.y > threshold || d.z > threshold){
+            above++;
+        }
+    }
+
+    const double n = double(image.size()) * 3.0;
+    res.mse = sum_sq / n;
+    res.psnr = res.mse > 0.0 ? -10.0 * std::log10(res.mse) : std::numeric_limits<double>::infinity();
+    res.mean_abs = float(sum_abs / n);
+    res.fraction_above = float(double(above) / double(image.size()));
+    return res;
+}
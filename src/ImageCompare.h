@@ -0,0 +1,28 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_IMAGECOMPARE_H
+#define HARDWARERASTERIZED3DGS_IMAGECOMPARE_H
+
+#include <vector>
+#include "glm/vec4.hpp"
+
+struct ImageDifference{
+    double mse = 0.0; // mean squared error over the rgb channels
+    double psnr = 0.0; // in dB, with a peak value of 1
+    float mean_abs = 0.0f; // mean absolute error over the rgb channels
+    float max_abs = 0.0f; // largest absolute error over the rgb channels
+    float fraction_above = 0.0f; // fraction of the pixels with an absolute error above the threshold on any channel
+};
+
+class ImageCompare {
+public:
+    /**
+     * Compares the rgb channels of two images of the same size, after clamping them to [0, 1].
+     */
+    static ImageDifference compare(const std::vector<glm::vec4>& image, const std::vector<glm::vec4>& reference, float threshold = 1.0f / 255.0f);
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_IMAGECOMPARE_H
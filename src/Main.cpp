@@ -12,6 +12,7 @@
 #include <cassert>
 
 #include "Window.cuh"
+#include "Benchmark.h"
 
 void my_terminate_handler() {
     std::cout << "Unhandled exception" << std::endl;
@@ -55,7 +56,8 @@ int main(int argc, char* argv[]){
     bool error = false;
 
     int samples = 1;
-    Window w(std::string("HardwareRasterized3DGS"), samples);
+    // the benchmark runs in a hidden window
+    Window w(std::string("HardwareRasterized3DGS"), samples, !Benchmark::isRequested(argc, argv));
     try {
         w.mainloop(argc, argv);
     } catch (const char* msg) {
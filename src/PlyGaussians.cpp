@@ -0,0 +1,136 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "PlyGaussians.h"
+
+#include <cmath>
+#include <random>
+
+#include "glm/common.hpp"
+#include "glm/exponential.hpp"
+#include "glm/geometric.hpp"
+#include "glm/vec3.hpp"
+
+#include "miniply/miniply.h"
+
+using namespace glm;
+
+static float sigmoid(float x){
+    return 1.0f / (1.0f + exp(-x));
+}
+
+PlyGaussians PlyGaussians::load(const std::string &path) {
+    miniply::PLYReader reader(path.c_str());
+    if (!reader.valid() || !reader.has_element()) {
+        throw std::string("Couldn't read ") + path;
+    }
+
+    const miniply::PLYElement *elem = reader.element();
+    if (elem->name != "vertex" || !reader.load_element()) {
+        throw std::string("Element ") + elem->name + " failed to load.";
+    }
+
+    PlyGaussians dst;
+    dst.count = (int)elem->count;
+
+    const uint pos_idx[3] = {
+            elem->find_property("x"),
+            elem->find_property("y"),
+            elem->find_property("z")
+    };
+    const uint rot_idx[4] = {
+            elem->find_property("rot_0"),
+            elem->find_property("rot_1"),
+            elem->find_property("rot_2"),
+            elem->find_property("rot_3")
+    };
+    const uint scale_idx[3] = {
+            elem->find_property("scale_0"),
+            elem->find_property("scale_1"),
+            elem->find_property("scale_2")
+    };
+    const uint opacity_idx[1] = {
+            elem->find_property("opacity")
+    };
+
+    dst.positions = std::vector<glm::vec4>(dst.count);
+    for(int i=0; i<dst.count; i++){
+        dst.positions[i].w = 1.0f;
+    }
+    reader.extract_properties_with_stride(pos_idx, 3, miniply::PLYPropertyType::Float, dst.positions.data(), 4*sizeof(float));
+
+    dst.scales = std::vector<glm::vec4>(dst.count);
+    reader.extract_properties_with_stride(scale_idx, 3, miniply::PLYPropertyType::Float, dst.scales.data(), 4*sizeof(float));
+    for(int i=0; i<dst.count; i++){
+        dst.scales[i] = exp(dst.scales[i]); // apply exponential activation
+        dst.scales[i].w = 0.0f;
+    }
+
+    dst.rotations = std::vector<glm::vec4>(dst.count);
+    reader.extract_properties(rot_idx, 4, miniply::PLYPropertyType::Float, dst.rotations.data());
+
+    dst.opacities = std::vector<float>(dst.count);
+    reader.extract_properties(opacity_idx, 1, miniply::PLYPropertyType::Float, dst.opacities.data());
+    for(int i=0; i<dst.count; i++){
+        dst.opacities[i] = sigmoid(dst.opacities[i]); // apply sigmoid activation
+    }
+
+    uint sh_idx[48];
+    for(int i=0; i<48; i++){
+        const std::string prop_name = i < 3 ? "f_dc_" + std::to_string(i) : "f_rest_" + std::to_string(i-3);
+        sh_idx[i] = elem->find_property(prop_name.c_str());
+    }
+
+    // interleaved layout: the (r, g, b) values of each coefficient are contiguous
+    uint interleaved_idx[48];
+    for(int j=0; j<16; j++){
+        for(int i=0; i<3; i++){
+            interleaved_idx[j*3+i] = j == 0 ? sh_idx[i] : sh_idx[3+i*15+j-1];
+        }
+    }
+    dst.sh_coeffs = std::vector<float>(dst.count * 48);
+    reader.extract_properties(interleaved_idx, 48, miniply::PLYPropertyType::Float, dst.sh_coeffs.data());
+
+    return dst;
+}
+
+PlyGaussians PlyGaussians::synthetic(int count, float radius, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    PlyGaussians dst;
+    dst.count = count;
+    dst.positions = std::vector<glm::vec4>(count);
+    dst.scales = std::vector<glm::vec4>(count);
+    dst.rotations = std::vector<glm::vec4>(count);
+    dst.opacities = std::vector<float>(count);
+    dst.sh_coeffs = std::vector<float>(size_t(count) * 48);
+
+    for(int n=0; n<count; n++){
+        vec3 p;
+        do{
+            p = vec3(uniform(rng), uniform(rng), uniform(rng));
+        }while(dot(p, p) > 1.0f);
+        dst.positions[n] = vec4(p * radius, 1.0f);
+
+        // a few pixels wide at the default camera distance, so that the color kernels dominate over the blending
+        dst.scales[n] = vec4(exp(vec3(normal(rng), normal(rng), normal(rng)) * 0.3f - 6.0f), 0.0f);
+
+        const vec4 q = vec4(normal(rng), normal(rng), normal(rng), normal(rng));
+        dst.rotations[n] = q / std::max(length(q), 1.0E-6f);
+
+        dst.opacities[n] = sigmoid(normal(rng));
+
+        // decreasing energy in the higher degree bands, like in the trained scenes
+        for(int j=0; j<16; j++){
+            const float sigma = j == 0 ? 1.0f : j < 4 ? 0.2f : j < 9 ? 0.1f : 0.05f;
+            for(int i=0; i<3; i++){
+                dst.sh_coeffs[size_t(n)*48+j*3+i] = normal(rng) * sigma;
+            }
+        }
+    }
+
+    return dst;
+}
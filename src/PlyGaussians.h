@@ -0,0 +1,32 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_PLYGAUSSIANS_H
+#define HARDWARERASTERIZED3DGS_PLYGAUSSIANS_H
+
+#include <string>
+#include <vector>
+
+#include "glm/vec4.hpp"
+
+/**
+ * The gaussians of a ply file of the original 3DGS implementation with the activations applied, in cpu memory only,
+ * so that they can be loaded without an opengl context (see PointCloudLoader for the gpu buffers).
+ */
+struct PlyGaussians {
+    int count = 0;
+    std::vector<glm::vec4> positions; // w = 1
+    std::vector<glm::vec4> scales; // exponential activation, w = 0
+    std::vector<glm::vec4> rotations;
+    std::vector<float> opacities; // sigmoid activation
+    std::vector<float> sh_coeffs; // 48 per gaussian, interleaved: the (r, g, b) values of each coefficient are contiguous
+
+    // Throws a std::string when the file can't be read.
+    static PlyGaussians load(const std::string& path);
+    // Small random gaussians uniformly distributed in a ball around the origin, the same ones for the same seed.
+    static PlyGaussians synthetic(int count, float radius, unsigned int seed = 0);
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_PLYGAUSSIANS_H
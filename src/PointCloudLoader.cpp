@@ -8,7 +8,10 @@
 
 #include "glm/vec3.hpp"
 #include "glm/common.hpp"
+#include "glm/packing.hpp"
 #include "RenderingBase/VAO.h"
+#include "RenderingBase/Profiler.h"
+#include "PlyGaussians.h"
 
 #include "miniply/miniply.h"
 
@@ -134,11 +137,8 @@ bool print_ply_header(const char *filename) {
 //    return vertices;
 //}
 
-float sigmoid(float x){
-    return 1.0f / (1.0f + exp(-x));
-}
-
 void PointCloudLoader::load(GaussianCloud& dst, const std::string &path, bool useCudaGLInterop) {
+    Profiler::CpuScope scope("load ply");
     dst.initialized = false;
 
     std::cout << "Loading point cloud: " << path << " ..." << std::endl;
@@ -146,105 +146,65 @@ void PointCloudLoader::load(GaussianCloud& dst, const std::string &path, bool us
     print_ply_header(path.c_str());
     std::cout << "End of header."<< std::endl;
 
-    miniply::PLYReader reader(path.c_str());
-    if (!reader.valid()) {
-        std::cout << "Couldn't read " <<path << std::endl;
+    PlyGaussians ply;
+    try{
+        ply = PlyGaussians::load(path);
+    }catch(const std::string& e){
+        std::cout << e << std::endl;
         return;
     }
 
-    assert(reader.has_element());
+    upload(dst, std::move(ply), useCudaGLInterop);
 
-    const miniply::PLYElement *elem = reader.element();
+    std::cout << "Finished loading point cloud." << std::endl;
+}
 
-    if (!reader.load_element()) {
-        std::cout <<"Element" <<elem->name <<" failed to load." <<std::endl;
-        return;
-    }
+void PointCloudLoader::upload(GaussianCloud &dst, PlyGaussians ply, bool useCudaGLInterop) {
+    dst.initialized = false;
+    dst.num_gaussians = ply.count;
 
-    assert(elem->name == "vertex");
-
-    dst.num_gaussians = (int)elem->count;
-
-    const uint pos_idx[3] = {
-            elem->find_property("x"),
-            elem->find_property("y"),
-            elem->find_property("z")
-    };
-    const uint rot_idx[4] = {
-            elem->find_property("rot_0"),
-            elem->find_property("rot_1"),
-            elem->find_property("rot_2"),
-            elem->find_property("rot_3")
-    };
-    const uint scale_idx[3] = {
-            elem->find_property("scale_0"),
-            elem->find_property("scale_1"),
-            elem->find_property("scale_2")
-    };
-    const uint opacity_idx[1] = {
-            elem->find_property("opacity")
-    };
-
-    dst.positions_cpu = std::vector<glm::vec4>(dst.num_gaussians);
-    for(int i=0; i<dst.num_gaussians; i++){
-        dst.positions_cpu[i].w = 1.0f;
-    }
-    reader.extract_properties_with_stride(pos_idx, 3, miniply::PLYPropertyType::Float, dst.positions_cpu.data(), 4*sizeof(float));
+    dst.positions_cpu = std::move(ply.positions);
     dst.positions.storeData(dst.positions_cpu.data(), dst.num_gaussians, 4*sizeof(float), 0, useCudaGLInterop, false, true);
 
-    dst.scales_cpu = std::vector<glm::vec4>(dst.num_gaussians);
-    reader.extract_properties_with_stride(scale_idx, 3, miniply::PLYPropertyType::Float, dst.scales_cpu.data(), 4*sizeof(float));
-    for(int i=0; i<dst.num_gaussians; i++){
-        dst.scales_cpu[i] = exp(dst.scales_cpu[i]); // apply exponential activation
-        dst.scales_cpu[i].w = 0.0f;
-    }
+    dst.scales_cpu = std::move(ply.scales);
     dst.scales.storeData(dst.scales_cpu.data(), dst.num_gaussians, 4*sizeof(float), 0, useCudaGLInterop, false, true);
 
-    dst.rotations_cpu = std::vector<glm::vec4>(dst.num_gaussians);
-    reader.extract_properties(rot_idx, 4, miniply::PLYPropertyType::Float, dst.rotations_cpu.data());
+    dst.rotations_cpu = std::move(ply.rotations);
     dst.rotations.storeData(dst.rotations_cpu.data(), dst.num_gaussians, 4*sizeof(float), 0, useCudaGLInterop, false, true);
 
-    dst.opacities_cpu = std::vector<float>(dst.num_gaussians);
-    reader.extract_properties(opacity_idx, 1, miniply::PLYPropertyType::Float, dst.opacities_cpu.data());
-    for(int i=0; i<dst.num_gaussians; i++){
-        dst.opacities_cpu[i] = sigmoid(dst.opacities_cpu[i]); // apply sigmoid activation
-    }
+    dst.opacities_cpu = std::move(ply.opacities);
     dst.opacities.storeData(dst.opacities_cpu.data(), dst.num_gaussians, 1*sizeof(float), 0, useCudaGLInterop, false, true);
 
-    uint sh_idx[48];
-    for(int i=0; i<48; i++){
-        const std::string prop_name = i < 3 ? "f_dc_" + std::to_string(i) : "f_rest_" + std::to_string(i-3);
-        sh_idx[i] = elem->find_property(prop_name.c_str());
-    }
+    dst.sh_coeffs_cpu = std::move(ply.sh_coeffs);
+    dst.sh_coeffs_interleaved.storeData(dst.sh_coeffs_cpu.data(), dst.num_gaussians, 48*sizeof(float), 0, useCudaGLInterop, false, true);
 
+    // planar layout: one buffer per color channel
     for(int i=0; i<3; i++) {
         float* sh_coeffs = new float[dst.num_gaussians * 16];
-        uint channel_idx[16];
-        for(int j=0; j<16; j++){
-//            channel_idx[j] = sh_idx[j*3+i];
-            if(j == 0){
-                channel_idx[0] = sh_idx[i];
-            }else{
-                channel_idx[j] = sh_idx[3+i*15+j-1];
+        for(int n=0; n<dst.num_gaussians; n++){
+            for(int j=0; j<16; j++){
+                sh_coeffs[n*16+j] = dst.sh_coeffs_cpu[n*48+j*3+i];
             }
         }
-        reader.extract_properties(channel_idx, 16, miniply::PLYPropertyType::Float, sh_coeffs);
         dst.sh_coeffs[i].storeData(sh_coeffs, dst.num_gaussians, 16*sizeof(float), 0, useCudaGLInterop, false, true);
         delete[] sh_coeffs;
     }
 
-    dst.visible_gaussians_counter.storeData(nullptr, 1, sizeof(int), 0, useCudaGLInterop, false, true);
-    dst.gaussians_depths.storeData(nullptr, dst.num_gaussians, sizeof(float), 0, useCudaGLInterop, true, true);
-    dst.gaussians_indices.storeData(nullptr, dst.num_gaussians, sizeof(int), 0, useCudaGLInterop, true, true);
-    dst.sorted_depths.storeData(nullptr, dst.num_gaussians, sizeof(float), 0, useCudaGLInterop, true, true);
-    dst.sorted_gaussian_indices.storeData(nullptr, dst.num_gaussians, sizeof(int), 0, useCudaGLInterop, true, true);
+    // The higher degree bands integrate to zero over the sphere,
+    // so the view-averaged color only depends on the DC coefficient.
+    const float SH_C0 = 0.28209479177387814f;
+    std::vector<uint32_t> baked_colors(dst.num_gaussians);
+    for(int n=0; n<dst.num_gaussians; n++){
+        const vec3 dc = vec3(dst.sh_coeffs_cpu[n*48+0], dst.sh_coeffs_cpu[n*48+1], dst.sh_coeffs_cpu[n*48+2]);
+        const vec3 color = clamp(0.5f + SH_C0 * dc, 0.0f, 1.0f);
+        baked_colors[n] = packUnorm4x8(vec4(color, dst.opacities_cpu[n]));
+    }
+    dst.baked_colors.storeData(baked_colors.data(), dst.num_gaussians, sizeof(uint32_t), 0, false, false, true);
 
-    dst.bounding_boxes.storeData(nullptr, dst.num_gaussians, 4*sizeof(float), 0, useCudaGLInterop, true, true);
-    dst.conic_opacity.storeData(nullptr, dst.num_gaussians, 4*sizeof(float), 0, useCudaGLInterop, true, true);
-    dst.eigen_vecs.storeData(nullptr, dst.num_gaussians, 2*sizeof(float), 0, useCudaGLInterop, true, true);
-    dst.predicted_colors.storeData(nullptr, dst.num_gaussians, 4*sizeof(float), 0, useCudaGLInterop, true, true);
+    dst.visible_gaussians_counter.storeData(nullptr, 1, sizeof(int), 0, useCudaGLInterop, false, true);
+    dst.color_cache_hits.storeData(nullptr, 1, sizeof(int), 0, false, true, true);
+    dst.capacity = dst.num_gaussians;
+    dst.allocateWorkBuffers(useCudaGLInterop);
 
     dst.initialized = true;
-
-    std::cout << "Finished loading point cloud." << std::endl;
 }
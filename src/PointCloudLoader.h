@@ -8,10 +8,13 @@
 #include <string>
 
 #include "GaussianCloud.h"
+#include "PlyGaussians.h"
 
 class PointCloudLoader {
 public:
     static void load(GaussianCloud& dst, const std::string& path, bool cudaGLInterop=true);
+    // Uploads gaussians that are already in cpu memory, e.g. a synthetic cloud.
+    static void upload(GaussianCloud& dst, PlyGaussians gaussians, bool cudaGLInterop=true);
 };
 
 
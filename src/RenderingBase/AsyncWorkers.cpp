@@ -5,8 +5,10 @@
 #include "AsyncWorkers.h"
 
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 
-inline AsyncWorkers::AsyncWorkers(int threads) {
+AsyncWorkers::AsyncWorkers(int threads) {
 
     for (int ID = 0; ID < threads; ID++) {
         std::function < void() > f = [this, ID]() {
@@ -16,7 +18,7 @@ inline AsyncWorkers::AsyncWorkers(int threads) {
     }
 }
 
-inline AsyncWorkers::~AsyncWorkers() {
+AsyncWorkers::~AsyncWorkers() {
     if(!error_occurred){
         ThreadSafeQueue<int> l;
         exec([&](){
@@ -47,14 +49,14 @@ inline AsyncWorkers::~AsyncWorkers() {
 }
 
 
-inline void AsyncWorkers::exec(std::function<void()> &&f) {
+void AsyncWorkers::exec(std::function<void()> &&f) {
     if(error_occurred){
         throw std::runtime_error("An error has occurred in the async threads");
     }
     tasks.push(std::move(f));
 }
 
-inline std::chrono::milliseconds AsyncWorkers::execAll(
+std::chrono::milliseconds AsyncWorkers::execAll(
         std::vector<std::function<void()>> &tasks) {
     if(error_occurred){
         throw std::runtime_error("An error has occurred in the async threads");
@@ -83,7 +85,7 @@ inline std::chrono::milliseconds AsyncWorkers::execAll(
     return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
 }
 
-inline void AsyncWorkers::thread_loop(int ID) {
+void AsyncWorkers::thread_loop(int ID) {
 
     std::chrono::milliseconds timeout(200);
     while (!should_exit) {
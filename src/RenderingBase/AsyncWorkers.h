@@ -8,6 +8,8 @@
 #include "ThreadSafeQueue.h"
 #include <thread>
 #include <functional>
+#include <atomic>
+#include <vector>
 
 class AsyncWorkers {
 public:
@@ -19,7 +21,7 @@ public:
     AsyncWorkers& operator=(const AsyncWorkers&) = delete;
     AsyncWorkers& operator=(AsyncWorkers&&) = delete;
 
-    inline void checkErrors();
+    void checkErrors();
 
     void exec(std::function<void()>&& f);
     std::chrono::milliseconds execAll(std::vector<std::function<void()>>& tasks);
@@ -65,7 +65,6 @@ void Camera::updateView(GLFWwindow *window, bool windowHovered, float scroll) {
     ImGui::Spacing();
 
 
-    vec3 up = vec3(0, 1, 0);
     if (!freeCam) {
         if (!windowHovered) {
             if(movementsEnabled){
@@ -77,13 +76,6 @@ void Camera::updateView(GLFWwindow *window, bool windowHovered, float scroll) {
         }
         scroll = 0;
 
-        camDir = -vec3(sin(theta) * cos(phi), sin(phi),
-                            cos(theta) * cos(phi));
-
-
-        camPos = -camDir * dist2lookPos + lookPos;
-        viewMat = glm::lookAt(camPos, lookPos, up);
-
         if(movementsEnabled && ((ctrlKey && lmbPressed) || rmbPressed)){
             // panning
             lookPos += camRight * -dx * dist2lookPos / (float)width;
@@ -117,9 +109,22 @@ void Camera::updateView(GLFWwindow *window, bool windowHovered, float scroll) {
                 camPos += vec3(0, 1, 0) * -camSpeed;
             }
         }
+    }
 
-        camDir = -vec3(sin(theta) * cos(phi), sin(phi),
-                            cos(theta) * cos(phi));
+    updateMatrices();
+}
+
+void Camera::updateMatrices() {
+    const int width = framebufferSize.x;
+    const int height = framebufferSize.y;
+
+    vec3 up = vec3(0, 1, 0);
+    camDir = -vec3(sin(theta) * cos(phi), sin(phi),
+                   cos(theta) * cos(phi));
+    if (!freeCam) {
+        camPos = -camDir * dist2lookPos + lookPos;
+        viewMat = glm::lookAt(camPos, lookPos, up);
+    } else {
         viewMat = lookAt(camPos, camPos + camDir, up);
     }
 
@@ -143,6 +148,42 @@ void Camera::updateView(GLFWwindow *window, bool windowHovered, float scroll) {
 
 }
 
+Camera::Pose Camera::getPose() const {
+    return Pose{freeCam, theta, phi, dist2lookPos, lookPos, camPos};
+}
+
+void Camera::setPose(const Camera::Pose &pose) {
+    freeCam = pose.freeCam;
+    theta = pose.theta;
+    phi = pose.phi;
+    dist2lookPos = pose.dist2lookPos;
+    lookPos = pose.lookPos;
+    camPos = pose.camPos;
+    updateMatrices();
+}
+
+void Camera::setView(const glm::mat4 &viewMatrix, float fovY, glm::ivec2 framebufferSize) {
+    this->fovY = fovY;
+    this->framebufferSize = framebufferSize;
+
+    viewMat = viewMatrix;
+    invViewMat = glm::inverse(viewMat);
+    camPos = vec3(invViewMat[3]);
+    camDir = -vec3(invViewMat[2]);
+    camRight = vec3(invViewMat[0]);
+    camUp = vec3(invViewMat[1]);
+
+    projMat = glm::perspective(fovY, (float) framebufferSize.x / (float) framebufferSize.y, nearPlane, farPlane);
+    invProj = glm::inverse(projMat);
+    projViewMat = projMat * viewMat;
+    invProjViewMat = glm::inverse(projViewMat);
+}
+
+void Camera::setFramebufferSize(glm::ivec2 size) {
+    framebufferSize = size;
+    updateMatrices();
+}
+
 glm::mat4 Camera::getProjectionViewMatrix() const {
     return projViewMat;
 }
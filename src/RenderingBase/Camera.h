@@ -17,11 +17,35 @@
 
 class Camera {
 public:
+    /**
+     * The state from which the view matrix is built, either in orbit or in free camera mode.
+     */
+    struct Pose{
+        bool freeCam;
+        float theta;
+        float phi;
+        float dist2lookPos;
+        glm::vec3 lookPos;
+        glm::vec3 camPos; // only used in free camera mode
+    };
+
     Camera();
     virtual ~Camera();
 
     void updateView(GLFWwindow *window, bool windowHovered, float scroll);
 
+    Pose getPose() const;
+    void setPose(const Pose& pose);
+
+    /**
+     * Overrides the view matrix, the vertical field of view and the framebuffer size, for the views of a dataset
+     * that can't be described by a Pose. Lasts until the next call to updateView or setPose.
+     */
+    void setView(const glm::mat4& viewMatrix, float fovY, glm::ivec2 framebufferSize);
+
+    // Sets the size of the framebuffer without a window, until the next call to updateView
+    void setFramebufferSize(glm::ivec2 size);
+
     glm::vec3 getPosition() const;
     glm::mat4 getViewMatrix() const;
     glm::mat4 getProjectionMatrix() const;
@@ -36,6 +60,8 @@ public:
     float getFovX() const;
     float getFovY() const;
 private:
+    void updateMatrices();
+
     float dist2lookPos = 3;
     float theta = 0;
     float phi = 0;
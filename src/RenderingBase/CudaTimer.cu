@@ -47,3 +47,19 @@ float CudaTimer::getTimeMs() {
     const double normalization = 1.0 / (1.0 - pow(beta, calls));
     return calls > 0 ? float(total_ms * normalization) : 0.0f;
 }
+
+void CudaTimer::synchronize() {
+    checkCudaErrors(cudaEventSynchronize(stop_time));
+}
+
+float CudaTimer::getLastTimeMs() const {
+    float elapsedTime_ms = 0.0f;
+    checkCudaErrors(cudaEventElapsedTime(&elapsedTime_ms, start_time, stop_time));
+    return elapsedTime_ms;
+}
+
+float CudaTimer::getStartMs(const CudaTimer &reference) const {
+    float elapsedTime_ms = 0.0f;
+    checkCudaErrors(cudaEventElapsedTime(&elapsedTime_ms, reference.start_time, start_time));
+    return elapsedTime_ms;
+}
@@ -13,6 +13,13 @@ public:
     void start();
     void stop();
     float getTimeMs();
+
+    // Waits for the stop event.
+    void synchronize();
+    // The last measure, without the moving average. Both events must have completed.
+    float getLastTimeMs() const;
+    // From the start of the reference to the start of this timer. Both start events must have completed.
+    float getStartMs(const CudaTimer& reference) const;
 private:
     cudaEvent_t start_time, stop_time;
     int calls=0;
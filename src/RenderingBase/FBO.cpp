@@ -7,6 +7,7 @@
 #include "GLIntrospection.h"
 #include "Texture2D.h"
 #include <iostream>
+#include <algorithm>
 
 FBO::FBO() {
 }
@@ -26,6 +27,10 @@ void FBO::reset() {
     if(ID == 0) return;
     glDeleteFramebuffers(1, &ID);
     ID = 0;
+    if(depthRenderbuffer != 0){
+        glDeleteRenderbuffers(1, &depthRenderbuffer);
+        depthRenderbuffer = 0;
+    }
     width = height = 0;
     attachments.clear();
 }
@@ -41,6 +46,16 @@ void FBO::createAttachment(GLenum attachment, GLenum internalFormat, GLenum form
 
 }
 
+void FBO::createDepthRenderbuffer(GLenum internalFormat) {
+    if(depthRenderbuffer != 0){
+        throw std::string("Error, FBO depth renderbuffer already specified");
+    }
+
+    glCreateRenderbuffers(1, &depthRenderbuffer);
+    glNamedRenderbufferStorage(depthRenderbuffer, internalFormat, width, height);
+    glNamedFramebufferRenderbuffer(ID, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRenderbuffer);
+}
+
 bool FBO::checkComplete() {
     GLenum res = glCheckNamedFramebufferStatus(ID, GL_DRAW_FRAMEBUFFER);
     if (res == GL_FRAMEBUFFER_COMPLETE) {
@@ -75,6 +90,8 @@ void FBO::drawBuffersAllAttachments() {
     for(auto& [attachement, tex] : attachments){
         names.push_back(attachement);
     }
+    // the fragment outputs are matched in the order of the attachments
+    std::sort(names.begin(), names.end());
     glNamedFramebufferDrawBuffers(ID, (int)names.size(), names.data());
 }
 
@@ -93,6 +110,13 @@ void FBO::blit(GLuint dstID, GLbitfield mask) {
             mask, GL_NEAREST);
 }
 
+void FBO::blit(GLuint dstID, GLbitfield mask, int dstWidth, int dstHeight, GLenum filter) {
+    glBlitNamedFramebuffer(ID, dstID,
+            0, 0, width, height,
+            0, 0, dstWidth, dstHeight,
+            mask, filter);
+}
+
 void FBO::makeEmpty() {
     glNamedFramebufferParameteri(ID, GL_FRAMEBUFFER_DEFAULT_WIDTH, (int)width);
     glNamedFramebufferParameteri(ID, GL_FRAMEBUFFER_DEFAULT_HEIGHT, (int)height);
@@ -18,11 +18,17 @@ public:
     void reset();
     void makeEmpty();
     void createAttachment(GLenum attachment, GLenum internalFormat, GLenum format, GLenum type);
+    /**
+     * Depth attachment stored in a renderbuffer, it can't be sampled nor shared with cuda.
+     */
+    void createDepthRenderbuffer(GLenum internalFormat);
     bool checkComplete();
     void drawBuffersAllAttachments();
     void bind();
     void unbind();
     void blit(GLuint dstID, GLbitfield mask);
+    // Blit to a destination of a different size, filter must be GL_NEAREST for the depth and stencil buffers
+    void blit(GLuint dstID, GLbitfield mask, int dstWidth, int dstHeight, GLenum filter);
 
     int getWidth() const{return width;}
     int getHeight() const{return height;}
@@ -36,6 +42,7 @@ private:
     int width{};
     int height{};
     std::unordered_map<GLenum, std::unique_ptr<Texture2D>> attachments;
+    GLuint depthRenderbuffer{};
 };
 
 
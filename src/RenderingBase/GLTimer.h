@@ -36,6 +36,7 @@ public:
 
     void end(){
         glEndQuery(type);
+        glDeleteSync(s); // the query may be reused
         s = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     }
 
@@ -44,6 +45,7 @@ public:
      */
     void queryCounter(){
         glQueryCounter(ID, type);
+        glDeleteSync(s); // the query may be reused
         s = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     }
 
@@ -0,0 +1,254 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "Profiler.h"
+
+#include "ImGuiHelpers.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+Profiler* Profiler::instance = nullptr;
+
+static int64_t steadyClockNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::Profiler(int capacity) : origin(steadyClockNs()), events(capacity) {
+    if(Profiler::instance != nullptr){
+        throw std::string("Error, a Profiler instance has already been created");
+    }
+    Profiler::instance = this;
+    // the thread of the main context is the first track
+    tracks[std::this_thread::get_id()] = 0;
+}
+
+Profiler::~Profiler() {
+    Profiler::instance = nullptr;
+}
+
+int64_t Profiler::now() const {
+    return steadyClockNs() - origin;
+}
+
+int Profiler::getTrack() {
+    const auto it = tracks.find(std::this_thread::get_id());
+    if(it != tracks.end()){
+        return it->second;
+    }
+    const int track = int(tracks.size());
+    tracks[std::this_thread::get_id()] = track;
+    return track;
+}
+
+void Profiler::push(const char *name, int track, int64_t begin_ns, int64_t end_ns, int64_t frame) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // the oldest event is overwritten once the ring buffer is full
+    events[head] = Event{name, track < 0 ? getTrack() : track, begin_ns, end_ns, frame};
+    head = (head + 1) % events.size();
+    count = std::min(count + 1, events.size());
+}
+
+void Profiler::resolveGL(bool wait) {
+    // the queries complete in order
+    while(!pendingGL.empty()){
+        PendingGL& p = pendingGL.front();
+        if(!wait && !p.end->resultAvailable()){
+            break;
+        }
+        int64_t begin = 0, end = 0;
+        p.begin->getResult(begin);
+        p.end->getResult(end);
+        push(p.name, GL_TRACK, begin + p.offset_ns, end + p.offset_ns, p.frame);
+        freeQueries.push_back(std::move(p.begin));
+        freeQueries.push_back(std::move(p.end));
+        pendingGL.pop_front();
+    }
+}
+
+std::unique_ptr<Query> Profiler::acquireQuery() {
+    if(freeQueries.empty()){
+        return std::make_unique<Query>(GL_TIMESTAMP);
+    }
+    std::unique_ptr<Query> q = std::move(freeQueries.back());
+    freeQueries.pop_back();
+    return q;
+}
+
+void Profiler::resolveCuda() {
+    // The cuda scopes are relative to the reference event of their frame, they are resolved before the next one.
+    // The interop unmaps already wait for the kernels, the synchronization doesn't stall.
+    for(PendingCuda& p : pendingCuda){
+        if(p.frame == cudaReferenceFrame){
+            p.timer->synchronize();
+            const int64_t begin = cudaReferenceTime + int64_t(double(p.timer->getStartMs(*cudaReference)) * 1.0E6);
+            const int64_t duration = int64_t(double(p.timer->getLastTimeMs()) * 1.0E6);
+            push(p.name, CUDA_TRACK, begin, begin + duration, p.frame);
+        }
+        freeTimers.push_back(std::move(p.timer));
+    }
+    pendingCuda.clear();
+}
+
+void Profiler::newFrame() {
+    resolveGL(false);
+    resolveCuda();
+    frame++;
+    if(!enabled){
+        return;
+    }
+
+    // the gl clock when the previous commands have reached the gpu, against the cpu clock now
+    GLint64 glTime = 0;
+    glGetInteger64v(GL_TIMESTAMP, &glTime);
+    glOffset = now() - glTime;
+
+    // the default stream is idle between the frames, the reference completes right away
+    if(!cudaReference){
+        cudaReference = std::make_unique<CudaTimer>();
+    }
+    cudaReference->start();
+    cudaReference->stop();
+    cudaReference->synchronize();
+    cudaReferenceTime = now();
+    cudaReferenceFrame = frame;
+}
+
+static std::string escape(const char* s){
+    std::string e;
+    for(; *s; s++){
+        if(*s == '"' || *s == '\\'){
+            e += '\\';
+        }
+        e += *s;
+    }
+    return e;
+}
+
+bool Profiler::exportChromeTrace(const std::string &path) {
+    resolveGL(true);
+
+    std::vector<Event> copy;
+    std::unordered_map<std::thread::id, int> tracks_copy;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // oldest first
+        const size_t first = (head + events.size() - count) % events.size();
+        for(size_t i=0; i<count; i++){
+            copy.push_back(events[(first + i) % events.size()]);
+        }
+        tracks_copy = tracks;
+    }
+
+    std::ofstream file(path);
+    if(!file){
+        return false;
+    }
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    file << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"args\": {\"name\": \"HardwareRasterized3DGS\"}},\n";
+    for(const auto& [id, track] : tracks_copy){
+        file << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << track
+             << ", \"args\": {\"name\": \"" << (track == 0 ? std::string("main thread") : "cpu thread " + std::to_string(track)) << "\"}},\n";
+    }
+    file << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << int(GL_TRACK) << ", \"args\": {\"name\": \"OpenGL\"}},\n";
+    file << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << int(CUDA_TRACK) << ", \"args\": {\"name\": \"CUDA\"}}";
+    for(const Event& e : copy){
+        const char* category = e.track == GL_TRACK ? "gl" : e.track == CUDA_TRACK ? "cuda" : "cpu";
+        // complete events, in microseconds
+        file << ",\n{\"name\": \"" << escape(e.name) << "\", \"cat\": \"" << category << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.track
+             << ", \"ts\": " << double(e.begin_ns) * 1.0E-3 << ", \"dur\": " << double(e.end_ns - e.begin_ns) * 1.0E-3
+             << ", \"args\": {\"frame\": " << e.frame << "}}";
+    }
+    file << "\n]}\n";
+    return bool(file);
+}
+
+void Profiler::GUI() {
+    if(!ImGui::TreeNode("Profiler")){
+        return;
+    }
+
+    bool record = enabled;
+    if(ImGui::Checkbox("Record the timeline", &record)){
+        enabled = record;
+    }
+    HelpMarker("Records the cpu scopes, the gl commands and the cuda kernels of each frame in a ring buffer. "
+               "The trace can be opened with chrome://tracing or ui.perfetto.dev.");
+    size_t recorded;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        recorded = count;
+    }
+    ImGui::Text("%d events (at most %d), frame %d", int(recorded), int(events.size()), int(frame));
+    ImGui::InputText("Trace", exportPath, sizeof(exportPath));
+    ImGui::SameLine();
+    if(ImGui::Button("Export")){
+        if(exportChromeTrace(exportPath)){
+            std::cout << "Trace written to " << exportPath << std::endl;
+        }else{
+            std::cout << "Couldn't write " << exportPath << std::endl;
+        }
+    }
+
+    ImGui::TreePop();
+}
+
+Profiler::CpuScope::CpuScope(const char *name) : name(name) {
+    Profiler* p = Profiler::instance;
+    if(p && p->enabled){
+        begin = p->now();
+    }
+}
+
+Profiler::CpuScope::~CpuScope() {
+    Profiler* p = Profiler::instance;
+    if(p && begin >= 0){
+        p->push(name, -1, begin, p->now(), p->frame);
+    }
+}
+
+Profiler::GLScope::GLScope(const char *name) : name(name) {
+    Profiler* p = Profiler::instance;
+    if(!p || !p->enabled){
+        return;
+    }
+    begin = p->acquireQuery();
+    begin->queryCounter();
+}
+
+Profiler::GLScope::~GLScope() {
+    Profiler* p = Profiler::instance;
+    if(!p || !begin){
+        return;
+    }
+    std::unique_ptr<Query> end = p->acquireQuery();
+    end->queryCounter();
+    p->pendingGL.push_back({name, std::move(begin), std::move(end), p->glOffset, p->frame});
+}
+
+Profiler::CudaScope::CudaScope(const char *name) : name(name) {
+    Profiler* p = Profiler::instance;
+    if(!p || !p->enabled){
+        return;
+    }
+    if(p->freeTimers.empty()){
+        timer = std::make_unique<CudaTimer>();
+    }else{
+        timer = std::move(p->freeTimers.back());
+        p->freeTimers.pop_back();
+    }
+    timer->start();
+}
+
+Profiler::CudaScope::~CudaScope() {
+    Profiler* p = Profiler::instance;
+    if(!p || !timer){
+        return;
+    }
+    timer->stop();
+    p->pendingCuda.push_back({name, std::move(timer), p->frame});
+}
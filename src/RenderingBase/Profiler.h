@@ -0,0 +1,148 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_PROFILER_H
+#define HARDWARERASTERIZED3DGS_PROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <unordered_map>
+
+#include "GLTimer.h"
+#include <cuda_runtime_api.h>
+#include "CudaTimer.cuh"
+
+/**
+ * Timeline of the cpu scopes, of the gl commands (GL_TIMESTAMP queries) and of the cuda kernels (CudaTimer events),
+ * kept in a ring buffer and exported in the Chrome trace event format (chrome://tracing or ui.perfetto.dev),
+ * to see the overlap of the cpu and the gpu and the synchronizations of each frame.
+ * The gpu times are converted to the cpu clock: the gl clock is compared with the cpu clock at each frame,
+ * and a cuda timer is synchronized at each frame as the reference of the cuda scopes of the frame.
+ * The scopes do nothing while the profiler is disabled or doesn't exist.
+ */
+class Profiler {
+public:
+    static Profiler* instance; // set by the constructor
+
+    explicit Profiler(int capacity = 1 << 16);
+    virtual ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * Called once per frame on the thread of the main context: collects the gpu scopes whose results are available
+     * and synchronizes the gpu clocks with the cpu clock.
+     */
+    void newFrame();
+
+    // Returns false when the file can't be written.
+    bool exportChromeTrace(const std::string& path);
+
+    void GUI();
+
+    bool isEnabled() const{
+        return enabled.load();
+    }
+    void setEnabled(bool b){
+        enabled = b;
+    }
+
+    // cpu time until the end of the scope, on any thread
+    class CpuScope{
+    public:
+        explicit CpuScope(const char* name);
+        ~CpuScope();
+    private:
+        const char* name;
+        int64_t begin = -1; // -1 when the profiler is disabled
+    };
+
+    // gpu time of the gl commands issued until the end of the scope, on the thread of the main context
+    class GLScope{
+    public:
+        explicit GLScope(const char* name);
+        ~GLScope();
+    private:
+        const char* name;
+        std::unique_ptr<Query> begin; // null when the profiler is disabled
+    };
+
+    // gpu time of the cuda kernels launched on the default stream until the end of the scope
+    class CudaScope{
+    public:
+        explicit CudaScope(const char* name);
+        ~CudaScope();
+    private:
+        const char* name;
+        std::unique_ptr<CudaTimer> timer; // null when the profiler is disabled
+    };
+
+private:
+    enum TRACKS{
+        GL_TRACK = 1000, // the cpu threads are numbered from 0
+        CUDA_TRACK = 1001
+    };
+
+    struct Event{
+        const char* name; // string literal
+        int track;
+        int64_t begin_ns; // cpu clock, since the creation of the profiler
+        int64_t end_ns;
+        int64_t frame;
+    };
+
+    struct PendingGL{
+        const char* name;
+        std::unique_ptr<Query> begin, end;
+        int64_t offset_ns; // cpu clock - gl clock during the frame
+        int64_t frame;
+    };
+
+    struct PendingCuda{
+        const char* name;
+        std::unique_ptr<CudaTimer> timer;
+        int64_t frame;
+    };
+
+    int64_t now() const; // cpu clock
+    // track < 0 for the track of the calling thread
+    void push(const char* name, int track, int64_t begin_ns, int64_t end_ns, int64_t frame);
+    // track of the calling thread, with the mutex locked
+    int getTrack();
+    void resolveGL(bool wait);
+    std::unique_ptr<Query> acquireQuery();
+    void resolveCuda();
+
+    std::atomic_bool enabled = false;
+    int64_t origin; // steady_clock at the creation, in ns
+    std::atomic<int64_t> frame = 0;
+
+    std::mutex mutex; // the ring buffer and the tracks, the cpu scopes are recorded from any thread
+    std::vector<Event> events;
+    size_t head = 0; // next slot of the ring buffer
+    size_t count = 0;
+    std::unordered_map<std::thread::id, int> tracks;
+
+    // only used on the thread of the main context
+    std::deque<PendingGL> pendingGL;
+    std::deque<PendingCuda> pendingCuda;
+    std::vector<std::unique_ptr<CudaTimer>> freeTimers; // the events are reused
+    std::vector<std::unique_ptr<Query>> freeQueries; // the GL_TIMESTAMP queries are reused
+    int64_t glOffset = 0;
+    std::unique_ptr<CudaTimer> cudaReference; // recorded at the beginning of the frame
+    int64_t cudaReferenceTime = 0; // cpu clock when cudaReference completed
+    int64_t cudaReferenceFrame = -1;
+
+    char exportPath[256] = "trace.json";
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_PROFILER_H
@@ -21,8 +21,8 @@ public:
         GLenum internalFormat;
         GLenum format;
         GLenum type;
-        void* ptr; // Can be actual data or clear data or nullptr
-        std::function<void(void*)> deleter; // to be called on ptr
+        void* ptr = nullptr; // Can be actual data or clear data or nullptr
+        std::function<void(void*)> deleter = [](void*){}; // to be called on ptr
 
         TextureData() = default;
         TextureData(const std::string& path, int width, int height, GLenum internalFormat, GLenum format, GLenum type,
@@ -7,6 +7,7 @@
 
 #include <list>
 #include <mutex>
+#include <condition_variable>
 #include <chrono>
 
 template<typename T>
@@ -5,11 +5,13 @@
 #include "Sort.cuh"
 
 #include "RenderingBase/CudaBuffer.cuh"
+#include "RenderingBase/Profiler.h"
 #include <cub/cub.cuh>
 
 static CudaBuffer<char> temp;
 
 void Sort::sort(GLBuffer &depths, GLBuffer &sorted_depths, GLBuffer &indices, GLBuffer &sorted_indices, int count) {
+    Profiler::CpuScope scope("radix sort");
 
     checkCudaErrors(cudaGraphicsMapResources(1, &depths.getCudaResource()));
 
@@ -30,11 +32,81 @@ void Sort::sort(GLBuffer &depths, GLBuffer &sorted_depths, GLBuffer &indices, GL
         temp = CudaBuffer<char>::allocate(int(temp_storage_bytes), "RadixSort::TempStorage");
     }
 
-    cub::DeviceRadixSort::SortPairs(
-            temp.ptr, temp_storage_bytes,
-            keys_in.ptr, keys_out.ptr, // keys
-            values_in.ptr, values_out.ptr, // values
+    {
+        Profiler::CudaScope cudaScope("radix sort");
+        cub::DeviceRadixSort::SortPairs(
+                temp.ptr, temp_storage_bytes,
+                keys_in.ptr, keys_out.ptr, // keys
+                values_in.ptr, values_out.ptr, // values
+                count);
+    }
+
+    {
+        Profiler::CpuScope unmapScope("unmap resources");
+        checkCudaErrors(cudaGraphicsUnmapResources(1, &depths.getCudaResource()));
+    }
+}
+
+void Sort::sortKeys(GLBuffer &keys, GLBuffer &sorted_keys, int count, int end_bit) {
+    Profiler::CpuScope scope("radix sort keys");
+
+    checkCudaErrors(cudaGraphicsMapResources(1, &keys.getCudaResource()));
+
+    CudaBuffer<uint64_t> keys_in = CudaBuffer<uint64_t>::fromGLBuffer(keys);
+    CudaBuffer<uint64_t> keys_out = CudaBuffer<uint64_t>::fromGLBuffer(sorted_keys);
+
+    size_t temp_storage_bytes;
+    cub::DeviceRadixSort::SortKeys(
+            nullptr, temp_storage_bytes,
+            keys_in.ptr, keys_out.ptr,
+            count, 0, end_bit);
+
+    if(temp.numElements < temp_storage_bytes){
+        temp = CudaBuffer<char>::allocate(int(temp_storage_bytes), "RadixSort::TempStorage");
+    }
+
+    {
+        Profiler::CudaScope cudaScope("radix sort keys");
+        cub::DeviceRadixSort::SortKeys(
+                temp.ptr, temp_storage_bytes,
+                keys_in.ptr, keys_out.ptr,
+                count, 0, end_bit);
+    }
+
+    {
+        Profiler::CpuScope unmapScope("unmap resources");
+        checkCudaErrors(cudaGraphicsUnmapResources(1, &keys.getCudaResource()));
+    }
+}
+
+void Sort::inclusiveSum(GLBuffer &values, GLBuffer &sums, int count) {
+    Profiler::CpuScope scope("inclusive sum");
+
+    checkCudaErrors(cudaGraphicsMapResources(1, &values.getCudaResource()));
+
+    CudaBuffer<int> values_in = CudaBuffer<int>::fromGLBuffer(values);
+    CudaBuffer<int> sums_out = CudaBuffer<int>::fromGLBuffer(sums);
+
+    size_t temp_storage_bytes;
+    cub::DeviceScan::InclusiveSum(
+            nullptr, temp_storage_bytes,
+            values_in.ptr, sums_out.ptr,
             count);
 
-    checkCudaErrors(cudaGraphicsUnmapResources(1, &depths.getCudaResource()));
+    if(temp.numElements < temp_storage_bytes){
+        temp = CudaBuffer<char>::allocate(int(temp_storage_bytes), "Scan::TempStorage");
+    }
+
+    {
+        Profiler::CudaScope cudaScope("inclusive sum");
+        cub::DeviceScan::InclusiveSum(
+                temp.ptr, temp_storage_bytes,
+                values_in.ptr, sums_out.ptr,
+                count);
+    }
+
+    {
+        Profiler::CpuScope unmapScope("unmap resources");
+        checkCudaErrors(cudaGraphicsUnmapResources(1, &values.getCudaResource()));
+    }
 }
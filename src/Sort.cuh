@@ -10,6 +10,12 @@
 class Sort {
 public:
     void sort(GLBuffer& depths, GLBuffer& sorted_depths, GLBuffer& indices, GLBuffer& sorted_indices, int count);
+
+    // Sorts count 64 bits keys, only looking at the bits [0, end_bit)
+    void sortKeys(GLBuffer& keys, GLBuffer& sorted_keys, int count, int end_bit);
+
+    // Inclusive prefix sum of count ints
+    void inclusiveSum(GLBuffer& values, GLBuffer& sums, int count);
 };
 
 
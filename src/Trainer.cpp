@@ -0,0 +1,967 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#include "Trainer.h"
+#include "GaussianCloud.h"
+#include "RenderingBase/VAO.h"
+#include "RenderingBase/Profiler.h"
+#include "RenderingBase/ImGuiHelpers.h"
+#include "glm/ext/matrix_transform.hpp"
+#include "glm/gtc/packing.hpp"
+#include "glm/packing.hpp"
+
+#include "imgui/imgui.h"
+
+#include "../resources/shaders/common/CommonTypes.h"
+
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <cstring>
+#include <chrono>
+#include <utility>
+
+using namespace glm;
+
+Trainer::Settings Trainer::useTrainingSettings(GaussianCloud &cloud, ivec2 size) const {
+    const Settings saved = {
+            cloud.renderAsPoints, cloud.renderAsQuads, cloud.blending, cloud.front_to_back, cloud.antialiasing,
+            cloud.scale_modifier, cloud.earlyTermination, cloud.foveation, cloud.colorCache, cloud.shLod,
+            cloud.dynamicResolution, cloud.renderSize
+    };
+
+    // the backward pass replays the software blending, front to back, with the full degree spherical harmonics
+    cloud.renderAsPoints = false;
+    cloud.renderAsQuads = true;
+    cloud.blending = GaussianCloud::INTERLOCK_BLENDING;
+    cloud.front_to_back = true;
+    cloud.antialiasing = false;
+    cloud.scale_modifier = 1.0f;
+    cloud.earlyTermination = false;
+    cloud.foveation = false;
+    cloud.colorCache = false;
+    cloud.shLod = false;
+    cloud.dynamicResolution = false;
+    if(size.x > 0 && size.y > 0){
+        cloud.renderSize = size;
+    }
+    return saved;
+}
+
+void Trainer::restoreSettings(GaussianCloud &cloud, const Settings &settings) const {
+    cloud.renderAsPoints = settings.renderAsPoints;
+    cloud.renderAsQuads = settings.renderAsQuads;
+    cloud.blending = settings.blending;
+    cloud.front_to_back = settings.front_to_back;
+    cloud.antialiasing = settings.antialiasing;
+    cloud.scale_modifier = settings.scale_modifier;
+    cloud.earlyTermination = settings.earlyTermination;
+    cloud.foveation = settings.foveation;
+    cloud.colorCache = settings.colorCache;
+    cloud.shLod = settings.shLod;
+    cloud.dynamicResolution = settings.dynamicResolution;
+    cloud.renderSize = settings.renderSize;
+}
+
+void Trainer::allocateGradients(GaussianCloud &cloud) {
+    // with room for the gaussians added by the densification
+    const int n = cloud.capacity;
+    if(cloud.dLoss_dpositions.getNumElements() == n){
+        return;
+    }
+    // only allocated once training starts, that's about 300 bytes per gaussian
+    cloud.dLoss_dpositions.storeData(nullptr, n, 4*sizeof(float), 0, false, true, true);
+    cloud.dLoss_dscales.storeData(nullptr, n, 4*sizeof(float), 0, false, true, true);
+    cloud.dLoss_drotations.storeData(nullptr, n, 4*sizeof(float), 0, false, true, true);
+    cloud.dLoss_dopacities.storeData(nullptr, n, sizeof(float), 0, false, true, true);
+    for(auto& b : cloud.dLoss_dsh_coeffs){
+        b.storeData(nullptr, n, 16*sizeof(float), 0, false, true, true);
+    }
+    cloud.dLoss_dconic_opacity.storeData(nullptr, n, 4*sizeof(uint16_t), 0, false, true, true);
+    cloud.dLoss_dpredicted_colors.storeData(nullptr, n, 4*sizeof(uint16_t), 0, false, true, true);
+    cloud.dLoss_dmean2D.storeData(nullptr, n, 2*sizeof(uint16_t), 0, false, true, true);
+    cloud.dLoss_dconic_opacity_fp32.storeData(nullptr, n, 4*sizeof(float), 0, false, true, true);
+    cloud.dLoss_dpredicted_colors_fp32.storeData(nullptr, n, 4*sizeof(float), 0, false, true, true);
+    cloud.dLoss_dmean2D_fp32.storeData(nullptr, n, 2*sizeof(float), 0, false, true, true);
+    cloud.training_loss.storeData(nullptr, 1, sizeof(float), 0, false, true, true);
+    // accumulated over the steps until the next densification, not cleared with the gradients
+    cloud.densification_stats.storeData(nullptr, n, 2*sizeof(float), 0, false, true, true);
+}
+
+void Trainer::allocateMoments(GaussianCloud &cloud) {
+    // the densification replaces the moments with buffers of the new capacity
+    const int n = cloud.capacity;
+    if(cloud.moments_positions.getNumElements() == n * 2){
+        return;
+    }
+    // 488 bytes per gaussian
+    cloud.moments_positions.storeData(nullptr, n * 2, 4*sizeof(float), 0, false, true, true);
+    cloud.moments_scales.storeData(nullptr, n * 2, 4*sizeof(float), 0, false, true, true);
+    cloud.moments_rotations.storeData(nullptr, n * 2, 4*sizeof(float), 0, false, true, true);
+    cloud.moments_opacities.storeData(nullptr, n, 2*sizeof(float), 0, false, true, true);
+    cloud.moments_sh.storeData(nullptr, n * CpuAdam::SH_VEC4 * 2, 4*sizeof(float), 0, false, true, true);
+}
+
+void Trainer::clearGradients(GaussianCloud &cloud) {
+    // all the bits at 0 is 0.0 for the 32 and 16 bits floats
+    const int zero = 0;
+    GLBuffer* buffers[] = {
+            &cloud.dLoss_dpositions, &cloud.dLoss_dscales, &cloud.dLoss_drotations, &cloud.dLoss_dopacities,
+            &cloud.dLoss_dsh_coeffs[0], &cloud.dLoss_dsh_coeffs[1], &cloud.dLoss_dsh_coeffs[2],
+            &cloud.training_loss
+    };
+    for(GLBuffer* b : buffers){
+        b->clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+    }
+    clearSplatGradients(cloud);
+}
+
+void Trainer::clearSplatGradients(GaussianCloud &cloud) {
+    const int zero = 0;
+    GLBuffer* buffers[] = {
+            &cloud.dLoss_dconic_opacity, &cloud.dLoss_dpredicted_colors, &cloud.dLoss_dmean2D,
+            &cloud.dLoss_dconic_opacity_fp32, &cloud.dLoss_dpredicted_colors_fp32, &cloud.dLoss_dmean2D_fp32
+    };
+    for(GLBuffer* b : buffers){
+        b->clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+    }
+}
+
+void Trainer::clearMoments(GaussianCloud &cloud) {
+    const int zero = 0;
+    GLBuffer* buffers[] = {
+            &cloud.moments_positions, &cloud.moments_scales, &cloud.moments_rotations,
+            &cloud.moments_opacities, &cloud.moments_sh
+    };
+    for(GLBuffer* b : buffers){
+        b->clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+    }
+}
+
+void Trainer::allocateBackwardImage() {
+    if(!backward_image || backward_image->getWidth() != targetSize.x || backward_image->getHeight() != targetSize.y){
+        Texture2D::TextureData data = Texture2D::TextureData("", targetSize.x, targetSize.y, GL_RGBA16F, GL_RGBA, GL_FLOAT, nullptr, [](void*){});
+        backward_image = std::make_unique<Texture2D>(data, true, false, false, 1);
+    }
+}
+
+void Trainer::backwardBlending(GaussianCloud &cloud) {
+    const int width = cloud.fbo.getWidth();
+    const int height = cloud.fbo.getHeight();
+    const int num_visible = cloud.num_visible_gaussians;
+
+    {
+        Profiler::GLScope profilerScope("loss");
+        auto& q = timers[STAGES::LOSS].push_back();
+        q.begin();
+        cloud.computeLossShader.start();
+        glDispatchCompute((width+15)/16, (height+15)/16, 1);
+        glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        cloud.computeLossShader.stop();
+        q.end();
+    }
+
+    {
+        Profiler::GLScope profilerScope("backward blending");
+        auto& q = timers[STAGES::BACKWARD_BLENDING].push_back();
+        q.begin();
+        // Blend the quads again in the same order, each fragment gets the color and transmittance in front of it
+        // from the critical section, and the color behind it from the final image of the forward pass.
+        cloud.emptyfbo.bind();
+        glViewport(0, 0, width, height);
+        const vec4 value = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        glClearTexImage(backward_image->getID(), 0, GL_RGBA, GL_FLOAT, &value);
+        glDisable(GL_CULL_FACE);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+
+        cloud.quad_interlock_bwd_Shader.start();
+        glBindImageTexture(0, backward_image->getID(), 0, false, 0, GL_READ_WRITE, GL_RGBA16F);
+        VAO vao; // empty vertex array
+        vao.bind();
+        glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        if(cloud.instancedStrips){
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, cloud.proxySides, num_visible, 0);
+        }else{
+            glDrawArrays(GL_TRIANGLES, 0, num_visible * cloud.getProxyVertices());
+        }
+        glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        vao.unbind();
+        cloud.quad_interlock_bwd_Shader.stop();
+
+        glEnable(GL_CULL_FACE);
+        cloud.emptyfbo.unbind();
+        q.end();
+    }
+}
+
+void Trainer::backward(GaussianCloud &cloud) {
+    const int num_visible = cloud.num_visible_gaussians;
+    backwardBlending(cloud);
+
+    {
+        Profiler::GLScope profilerScope("backward colors");
+        auto& q = timers[STAGES::BACKWARD_COLORS].push_back();
+        q.begin();
+        // 16 threads per gaussian, same as predict_colors.cp
+        cloud.predictColorsBwdShader.start();
+        glDispatchCompute((num_visible+7)/8, 1, 1);
+        glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        cloud.predictColorsBwdShader.stop();
+        q.end();
+    }
+
+    {
+        Profiler::GLScope profilerScope("backward geometry");
+        auto& q = timers[STAGES::BACKWARD_GEOMETRY].push_back();
+        q.begin();
+        cloud.computeBoundingBoxesBwdShader.start();
+        glDispatchCompute((num_visible+127)/128, 1, 1);
+        glMemoryBarrier(GL_ALL_BARRIER_BITS);
+        cloud.computeBoundingBoxesBwdShader.stop();
+        q.end();
+    }
+}
+
+void Trainer::optimizerStep(GaussianCloud &cloud) {
+    Profiler::GLScope profilerScope("optimizer step");
+    auto& q = timers[STAGES::OPTIMIZER_STEP].push_back();
+    q.begin();
+    // index of the step, starting at 1, for the bias correction of the moments
+    const int t = steps + 1;
+    auto& s = cloud.adamStepShader;
+    s.start();
+    s.loadFloat("lr_positions", adam.lr_positions);
+    s.loadFloat("lr_scales", adam.lr_scales);
+    s.loadFloat("lr_rotations", adam.lr_rotations);
+    s.loadFloat("lr_opacities", adam.lr_opacities);
+    s.loadFloat("lr_sh_dc", adam.lr_sh_dc);
+    s.loadFloat("lr_sh_rest", adam.lr_sh_rest);
+    s.loadFloat("beta1", adam.beta1);
+    s.loadFloat("beta2", adam.beta2);
+    s.loadFloat("adam_epsilon", adam.epsilon);
+    s.loadFloat("bias_correction1", float(1.0 - std::pow(double(adam.beta1), t)));
+    s.loadFloat("bias_correction2", float(1.0 - std::pow(double(adam.beta2), t)));
+    glDispatchCompute((cloud.num_gaussians+127)/128, 1, 1);
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    s.stop();
+    q.end();
+
+    // the colors changed
+    cloud.invalidateColorCache();
+}
+
+template<typename T>
+static std::vector<T> download(const GLBuffer& buffer, size_t count){
+    std::vector<T> v(count);
+    glGetNamedBufferSubData(buffer.getID(), 0, GLsizeiptr(count * sizeof(T)), v.data());
+    return v;
+}
+
+static CpuAdam::Parameters downloadParameters(const GaussianCloud& cloud){
+    const size_t n = cloud.num_gaussians;
+    return {
+        download<vec4>(cloud.positions, n),
+        download<vec4>(cloud.scales, n),
+        download<vec4>(cloud.rotations, n),
+        download<float>(cloud.opacities, n),
+        download<vec4>(cloud.sh_coeffs_interleaved, n * CpuAdam::SH_VEC4)
+    };
+}
+
+static CpuAdam::Moments downloadMoments(const GaussianCloud& cloud){
+    const size_t n = cloud.num_gaussians;
+    return {
+        download<vec4>(cloud.moments_positions, n * 2),
+        download<vec4>(cloud.moments_scales, n * 2),
+        download<vec4>(cloud.moments_rotations, n * 2),
+        download<vec2>(cloud.moments_opacities, n),
+        download<vec4>(cloud.moments_sh, n * CpuAdam::SH_VEC4 * 2)
+    };
+}
+
+void Trainer::validateOptimizerStep(GaussianCloud &cloud) {
+    const size_t n = cloud.num_gaussians;
+    const CpuAdam::Parameters before = downloadParameters(cloud);
+    CpuAdam::Moments moments = downloadMoments(cloud);
+    CpuAdam::Gradients grads;
+    grads.positions = download<vec4>(cloud.dLoss_dpositions, n);
+    grads.scales = download<vec4>(cloud.dLoss_dscales, n);
+    grads.rotations = download<vec4>(cloud.dLoss_drotations, n);
+    grads.opacities = download<float>(cloud.dLoss_dopacities, n);
+    for(int c=0; c<3; c++){
+        grads.sh_coeffs[c] = download<float>(cloud.dLoss_dsh_coeffs[c], n * 16);
+    }
+
+    optimizerStep(cloud);
+    const CpuAdam::Parameters gpu = downloadParameters(cloud);
+    const CpuAdam::Moments gpu_moments = downloadMoments(cloud);
+
+    CpuAdam::Parameters cpu = before;
+    CpuAdam::step(adam, steps + 1, cpu, grads, moments);
+
+    optimizerDifference = CpuAdam::compare(before, gpu, cpu, gpu_moments, moments);
+    optimizerValidatedOn = cloud.num_gaussians;
+}
+
+bool Trainer::acquireBatch(int count) {
+    batchImages.resize(count);
+    for(DatasetPrefetcher::Image& image : batchImages){
+        // the previous image is released once the next one is ready
+        if(!prefetcher->next(image)){
+            batchImages.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+Texture2D* Trainer::selectTarget(Camera &view, int index) {
+    if(prefetcher){
+        Texture2D* image = batchImages[index].texture.get();
+        const Dataset::View& v = prefetcher->getDataset().views[batchImages[index].view];
+        targetSize = ivec2(image->getWidth(), image->getHeight());
+        // fillUniforms rotates the world by 180 degrees around x before the view matrix, the rotation is its own inverse
+        const mat4 rot = glm::rotate(mat4(1.0f), radians(180.0f), vec3(1, 0, 0));
+        view.setView(v.viewMat * rot, v.getFovY(targetSize.x, targetSize.y), targetSize);
+        return image;
+    }
+    if(targetfbo.getWidth() == 0){
+        return nullptr;
+    }
+    targetSize = ivec2(targetfbo.getWidth(), targetfbo.getHeight());
+    view.setPose(targetPose);
+    return targetfbo.getAttachment(GL_COLOR_ATTACHMENT0).get();
+}
+
+bool Trainer::step(GaussianCloud &cloud, Camera &camera) {
+    if(prefetcher){
+        // all the images of the batch are acquired before the gpu work, the waits on the decoding don't stall between the views
+        if(!acquireBatch(batchSize)){
+            return false;
+        }
+    }else if(targetfbo.getWidth() == 0){
+        return false;
+    }
+
+    allocateGradients(cloud);
+    allocateMoments(cloud);
+    clearGradients(cloud);
+    if(steps == 0){
+        clearMoments(cloud);
+    }
+
+    // Each view has its own culling, sort and forward pass. The gradients of the attributes are summed over the views
+    // by the backward passes, only the gradients of the 2D splats are cleared in between since they are indexed
+    // by the visible gaussians of the view. The only readback between the views is the number of visible gaussians.
+    const Settings saved = useTrainingSettings(cloud, ivec2(0));
+    int visibleViews = 0;
+    for(int b=0; b<batchSize; b++){
+        Camera view = camera;
+        const Texture2D* target = selectTarget(view, prefetcher ? b : 0);
+        allocateBackwardImage();
+        cloud.renderSize = targetSize;
+        cloud.groundTruthImage = target->getImageHandle();
+        cloud.render(view);
+        if(cloud.num_visible_gaussians > 0){
+            if(visibleViews > 0){
+                clearSplatGradients(cloud);
+            }
+            backward(cloud);
+            visibleViews++;
+        }
+    }
+
+    const bool visible = visibleViews > 0;
+    if(visible){
+        // Adam is invariant to the scale of the gradients, the sum over the views needs no normalization
+        if(validateOptimizer){
+            validateOptimizerStep(cloud);
+            validateOptimizer = false;
+        }else{
+            optimizerStep(cloud);
+        }
+        glGetNamedBufferSubData(cloud.training_loss.getID(), 0, sizeof(float), &lastLoss);
+        lastLoss /= float(visibleViews); // mean over the views of the batch
+        steps++;
+    }
+
+    cloud.groundTruthImage = 0;
+    restoreSettings(cloud, saved);
+    glViewport(0, 0, camera.getFramebufferSize().x, camera.getFramebufferSize().y);
+
+    if(visible && densifyInterval > 0 && steps % densifyInterval == 0){
+        densify(cloud, camera);
+    }
+    return visible;
+}
+
+void Trainer::benchmarkBatchSizes(GaussianCloud &cloud, Camera &camera) {
+    const int savedBatchSize = batchSize;
+    const int savedDensifyInterval = densifyInterval;
+    densifyInterval = 0; // the number of gaussians stays the same for all the batch sizes
+    for(int b=1; b<=MAX_BATCH_SIZE; b++){
+        batchSize = b;
+        step(cloud, camera); // warm up, the buffers are allocated for the size of the views
+        glFinish();
+        const auto start = std::chrono::steady_clock::now();
+        int done = 0;
+        for(int i=0; i<benchmarkSteps; i++){
+            done += step(cloud, camera);
+        }
+        glFinish();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stepsPerSecond[b-1] = done / seconds;
+        imagesPerSecond[b-1] = done * b / seconds;
+    }
+    batchSize = savedBatchSize;
+    densifyInterval = savedDensifyInterval;
+    cloud.downloadAttributes();
+}
+
+// the fp16 gradients, as floats
+static std::vector<vec4> downloadHalf4(const GLBuffer& buffer, size_t count){
+    const std::vector<uint64_t> packed = download<uint64_t>(buffer, count);
+    std::vector<vec4> v(count);
+    for(size_t i=0; i<count; i++){
+        v[i] = unpackHalf4x16(packed[i]);
+    }
+    return v;
+}
+
+static std::vector<vec2> downloadHalf2(const GLBuffer& buffer, size_t count){
+    const std::vector<uint32_t> packed = download<uint32_t>(buffer, count);
+    std::vector<vec2> v(count);
+    for(size_t i=0; i<count; i++){
+        v[i] = unpackHalf2x16(packed[i]);
+    }
+    return v;
+}
+
+bool Trainer::compareAccumulationModes(GaussianCloud &cloud, Camera &camera) {
+    if(prefetcher ? batchImages.empty() && !acquireBatch(1) : targetfbo.getWidth() == 0){
+        return false;
+    }
+    Camera view = camera;
+    // the last view of the last batch
+    const Texture2D* target = selectTarget(view, prefetcher ? int(batchImages.size()) - 1 : 0);
+    allocateGradients(cloud);
+    allocateBackwardImage();
+
+    const Settings saved = useTrainingSettings(cloud, targetSize);
+    const int savedMode = cloud.gradientAccumulation;
+    cloud.groundTruthImage = target->getImageHandle();
+    // the forward pass is the same for all the modes
+    cloud.render(view);
+
+    const int n = cloud.num_visible_gaussians;
+    if(n > 0){
+        const int width = cloud.fbo.getWidth();
+        const int height = cloud.fbo.getHeight();
+        const CpuBlendingBackward::Splats splats = {
+                download<vec4>(cloud.bounding_boxes, n),
+                download<vec2>(cloud.eigen_vecs, n),
+                download<vec4>(cloud.conic_opacity, n),
+                download<vec4>(cloud.predicted_colors, n)
+        };
+        std::vector<vec4> final_image(size_t(width) * height);
+        std::vector<vec4> target_image(final_image.size());
+        const GLsizei bytes = GLsizei(final_image.size() * sizeof(vec4));
+        glGetTextureImage(cloud.fbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID(), 0, GL_RGBA, GL_FLOAT, bytes, final_image.data());
+        glGetTextureImage(target->getID(), 0, GL_RGBA, GL_FLOAT, bytes, target_image.data());
+        const CpuBlendingBackward::Gradients reference = CpuBlendingBackward::compute(
+                splats, final_image, target_image, width, height, cloud.proxySides, cloud.min_opacity);
+
+        accumulationErrors.assign(GRADIENTS_MODES, CpuBlendingBackward::Error());
+        accumulationTimes.assign(GRADIENTS_MODES, 0.0);
+        for(int mode=0; mode<GRADIENTS_MODES; mode++){
+            cloud.gradientAccumulation = mode;
+            cloud.uploadUniforms(view);
+
+            // the timer queries of the stages can't be nested, wait for each blending to read its own
+            int64_t total = 0;
+            for(int r=0; r<accumulationRepeats; r++){
+                clearGradients(cloud);
+                backwardBlending(cloud);
+                glFinish();
+                total += timers[STAGES::BACKWARD_BLENDING].getLastResult();
+            }
+            accumulationTimes[mode] = double(total) * 1.0E-6 / accumulationRepeats;
+
+            if(mode == GRADIENTS_FP32_ATOMIC || mode == GRADIENTS_FP32_PARTITIONED){
+                accumulationErrors[mode] = CpuBlendingBackward::compare(reference,
+                        download<vec4>(cloud.dLoss_dpredicted_colors_fp32, n),
+                        download<vec4>(cloud.dLoss_dconic_opacity_fp32, n),
+                        download<vec2>(cloud.dLoss_dmean2D_fp32, n));
+            }else{
+                accumulationErrors[mode] = CpuBlendingBackward::compare(reference,
+                        downloadHalf4(cloud.dLoss_dpredicted_colors, n),
+                        downloadHalf4(cloud.dLoss_dconic_opacity, n),
+                        downloadHalf2(cloud.dLoss_dmean2D, n));
+            }
+        }
+        accumulationComparedOn = n;
+        // the next step starts from zero anyway, but the gradients shouldn't outlive the comparison
+        clearGradients(cloud);
+    }
+
+    cloud.gradientAccumulation = savedMode;
+    cloud.groundTruthImage = 0;
+    restoreSettings(cloud, saved);
+    glViewport(0, 0, camera.getFramebufferSize().x, camera.getFramebufferSize().y);
+    return n > 0;
+}
+
+void Trainer::DensifiedBuffers::allocate(int capacity) {
+    this->capacity = capacity;
+    // same flags as PointCloudLoader
+    positions.storeData(nullptr, capacity, 4*sizeof(float), 0, true, false, true);
+    scales.storeData(nullptr, capacity, 4*sizeof(float), 0, true, false, true);
+    rotations.storeData(nullptr, capacity, 4*sizeof(float), 0, true, false, true);
+    opacities.storeData(nullptr, capacity, sizeof(float), 0, true, false, true);
+    for(auto& b : sh_coeffs){
+        b.storeData(nullptr, capacity, 16*sizeof(float), 0, true, false, true);
+    }
+    sh_coeffs_interleaved.storeData(nullptr, capacity, 48*sizeof(float), 0, true, false, true);
+    baked_colors.storeData(nullptr, capacity, sizeof(uint32_t), 0, false, false, true);
+
+    // same layout as Trainer::allocateMoments
+    moments_positions.storeData(nullptr, capacity * 2, 4*sizeof(float), 0, false, false, true);
+    moments_scales.storeData(nullptr, capacity * 2, 4*sizeof(float), 0, false, false, true);
+    moments_rotations.storeData(nullptr, capacity * 2, 4*sizeof(float), 0, false, false, true);
+    moments_opacities.storeData(nullptr, capacity, 2*sizeof(float), 0, false, false, true);
+    moments_sh.storeData(nullptr, capacity * CpuAdam::SH_VEC4 * 2, 4*sizeof(float), 0, false, false, true);
+}
+
+void Trainer::DensifiedBuffers::reset() {
+    capacity = 0;
+    GLBuffer* buffers[] = {
+            &positions, &scales, &rotations, &opacities, &sh_coeffs[0], &sh_coeffs[1], &sh_coeffs[2],
+            &sh_coeffs_interleaved, &baked_colors,
+            &moments_positions, &moments_scales, &moments_rotations, &moments_opacities, &moments_sh
+    };
+    for(GLBuffer* b : buffers){
+        b->reset();
+    }
+}
+
+void Trainer::DensifiedBuffers::clearMoments(int first) {
+    // all the bits at 0 is 0.0f
+    const int zero = 0;
+    GLBuffer* buffers[] = {&moments_positions, &moments_scales, &moments_rotations, &moments_opacities, &moments_sh};
+    for(GLBuffer* b : buffers){
+        const GLintptr bytesPerGaussian = GLintptr(b->getSizeInBytes()) / capacity;
+        const GLintptr offset = bytesPerGaussian * first;
+        const GLsizeiptr size = GLsizeiptr(b->getSizeInBytes()) - offset;
+        if(size > 0){
+            glClearNamedBufferSubData(b->getID(), GL_R32I, offset, size, GL_RED_INTEGER, GL_INT, &zero);
+        }
+    }
+}
+
+void Trainer::DensifiedBuffers::fillUniforms(DensifyUniforms& u) const {
+    u.positions = reinterpret_cast<vec4 *>(positions.getGLptr());
+    u.rotations = reinterpret_cast<vec4 *>(rotations.getGLptr());
+    u.scales = reinterpret_cast<vec4 *>(scales.getGLptr());
+    u.opacities = reinterpret_cast<float *>(opacities.getGLptr());
+    u.baked_colors = reinterpret_cast<uint *>(baked_colors.getGLptr());
+    u.sh_coeffs_red = reinterpret_cast<float *>(sh_coeffs[0].getGLptr());
+    u.sh_coeffs_green = reinterpret_cast<float *>(sh_coeffs[1].getGLptr());
+    u.sh_coeffs_blue = reinterpret_cast<float *>(sh_coeffs[2].getGLptr());
+    u.sh_coeffs_interleaved = reinterpret_cast<vec4 *>(sh_coeffs_interleaved.getGLptr());
+    u.moments_positions = reinterpret_cast<vec4 *>(moments_positions.getGLptr());
+    u.moments_scales = reinterpret_cast<vec4 *>(moments_scales.getGLptr());
+    u.moments_rotations = reinterpret_cast<vec4 *>(moments_rotations.getGLptr());
+    u.moments_opacities = reinterpret_cast<vec2 *>(moments_opacities.getGLptr());
+    u.moments_sh = reinterpret_cast<vec4 *>(moments_sh.getGLptr());
+}
+
+void Trainer::DensifiedBuffers::swap(GaussianCloud& cloud) {
+    std::swap(cloud.positions, positions);
+    std::swap(cloud.scales, scales);
+    std::swap(cloud.rotations, rotations);
+    std::swap(cloud.opacities, opacities);
+    for(int c=0; c<3; c++){
+        std::swap(cloud.sh_coeffs[c], sh_coeffs[c]);
+    }
+    std::swap(cloud.sh_coeffs_interleaved, sh_coeffs_interleaved);
+    std::swap(cloud.baked_colors, baked_colors);
+    std::swap(cloud.moments_positions, moments_positions);
+    std::swap(cloud.moments_scales, moments_scales);
+    std::swap(cloud.moments_rotations, moments_rotations);
+    std::swap(cloud.moments_opacities, moments_opacities);
+    std::swap(cloud.moments_sh, moments_sh);
+}
+
+bool Trainer::densify(GaussianCloud &cloud, Camera &camera) {
+    const int n = cloud.num_gaussians;
+    if(cloud.densification_stats.getNumElements() < n){
+        return false; // no training step yet
+    }
+    allocateMoments(cloud);
+
+    Profiler::GLScope profilerScope("densification");
+    auto& q = timers[STAGES::DENSIFICATION].push_back();
+    q.begin();
+
+    // the uniforms point to the current attributes, moments and statistics
+    cloud.uploadUniforms(camera);
+
+    if(densify_counts.getNumElements() < n){
+        densify_kinds.storeData(nullptr, n, sizeof(int), 0, false, false, true);
+        densify_counts.storeData(nullptr, n, sizeof(int), 0, true, false, true);
+        densify_offsets.storeData(nullptr, n, sizeof(int), 0, true, false, true);
+    }
+    const int zero = 0;
+    if(densify_kind_counters.getNumElements() == 0){
+        densify_kind_counters.storeData(nullptr, 4, sizeof(int), 0, false, true, true);
+    }
+    densify_kind_counters.clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+
+    // a different seed for each densification, the cpu reference uses the same
+    DensificationSettings settings = densification;
+    settings.seed += uint32_t(densifications);
+
+    DensifyUniforms u;
+    std::memset(&u, 0, sizeof(DensifyUniforms));
+    u.num_gaussians = n;
+    u.grad_threshold = densification.grad_threshold;
+    u.split_scale = densification.split_scale;
+    u.prune_opacity = densification.prune_opacity;
+    u.prune_scale = densification.prune_scale;
+    u.seed = settings.seed;
+    u.kinds = reinterpret_cast<int *>(densify_kinds.getGLptr());
+    u.counts = reinterpret_cast<int *>(densify_counts.getGLptr());
+    u.offsets = reinterpret_cast<int *>(densify_offsets.getGLptr());
+    u.kind_counters = reinterpret_cast<int *>(densify_kind_counters.getGLptr());
+    densify_uniforms.storeData(&u, 1, sizeof(DensifyUniforms));
+    glBindBufferBase(GL_UNIFORM_BUFFER, 1, densify_uniforms.getID());
+
+    cloud.densifyMarkShader.start();
+    glDispatchCompute((n+127)/128, 1, 1);
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    cloud.densifyMarkShader.stop();
+
+    // position of each gaussian in the output
+    cloud.sort.inclusiveSum(densify_counts, densify_offsets, n);
+    int total = 0;
+    glGetNamedBufferSubData(densify_offsets.getID(), (n - 1) * sizeof(int), sizeof(int), &total);
+    glGetNamedBufferSubData(densify_kind_counters.getID(), 0, 4 * sizeof(int), lastKindCounts);
+    if(total == 0){
+        q.end();
+        std::cout << "The densification would prune all the gaussians, skipped." << std::endl;
+        return false;
+    }
+
+    // grows by at least 50% to amortize the reallocations
+    const int capacity = total > cloud.capacity ? std::max(total, cloud.capacity + cloud.capacity / 2) : cloud.capacity;
+
+    // the cpu reference reads the same inputs
+    CpuAdam::Parameters before;
+    CpuAdam::Moments moments_before;
+    std::vector<vec2> stats;
+    std::vector<int> gpu_kinds;
+    if(validateDensification){
+        before = downloadParameters(cloud);
+        moments_before = downloadMoments(cloud);
+        stats = download<vec2>(cloud.densification_stats, n);
+        gpu_kinds = download<int>(densify_kinds, n);
+    }
+
+    // The gaussians are compacted into the second set of buffers rather than in place: a gaussian may move backwards
+    // over slots that are still read by other threads. The two sets are swapped afterwards, and the second one is
+    // only reallocated when the capacity changes.
+    if(densified.capacity != capacity){
+        densified.allocate(capacity);
+    }
+    // The second set holds the gaussians of the previous densification, the scatter only writes the first total slots.
+    // The moments of the unused slots must be 0 for the next densification.
+    densified.clearMoments(total);
+    densified.fillUniforms(u);
+    densify_uniforms.storeData(&u, 1, sizeof(DensifyUniforms));
+    glBindBufferBase(GL_UNIFORM_BUFFER, 1, densify_uniforms.getID());
+
+    cloud.densifyScatterShader.start();
+    glDispatchCompute((n+127)/128, 1, 1);
+    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    cloud.densifyScatterShader.stop();
+
+    densified.swap(cloud);
+    cloud.num_gaussians = total;
+    if(capacity != cloud.capacity){
+        cloud.capacity = capacity;
+        cloud.allocateWorkBuffers();
+        allocateGradients(cloud);
+        // the previous buffers are too small, the next densification allocates the second set with the new capacity
+        densified.reset();
+    }
+    cloud.densification_stats.clearData(GL_R32I, GL_RED_INTEGER, GL_INT, &zero);
+    cloud.invalidateColorCache();
+    cloud.gaussians_soa.count = 0;
+    if(cloud.selected_gaussian >= total){
+        cloud.selected_gaussian = -1;
+    }
+    densifications++;
+    q.end();
+
+    if(validateDensification){
+        const CpuDensification::Result result = CpuDensification::mark(settings, before, stats);
+        CpuAdam::Parameters cpu;
+        CpuAdam::Moments cpu_moments;
+        CpuDensification::scatter(settings, result, before, moments_before, cpu, cpu_moments);
+
+        densificationMismatches = 0;
+        for(int i=0; i<n; i++){
+            densificationMismatches += result.kinds[i] != gpu_kinds[i];
+        }
+        if(int(result.sources.size()) == total){
+            densificationMismatches += CpuDensification::countMismatches(downloadParameters(cloud), cpu,
+                                                                         downloadMoments(cloud), cpu_moments);
+        }else{
+            densificationMismatches += std::abs(int(result.sources.size()) - total);
+        }
+        densificationValidatedOn = n;
+        validateDensification = false;
+    }
+    return true;
+}
+
+void Trainer::captureTarget(GaussianCloud &cloud, Camera &camera) {
+    targetfbo.reset(); // render at the size of the framebuffer
+    const Settings saved = useTrainingSettings(cloud, ivec2(0));
+    cloud.render(camera);
+    restoreSettings(cloud, saved);
+
+    targetfbo.init(cloud.fbo.getWidth(), cloud.fbo.getHeight());
+    targetfbo.createAttachment(GL_COLOR_ATTACHMENT0, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+    targetfbo.drawBuffersAllAttachments();
+    cloud.fbo.blit(targetfbo.getID(), GL_COLOR_BUFFER_BIT);
+    targetPose = camera.getPose();
+    prefetcher.reset();
+    steps = 0;
+}
+
+bool Trainer::loadTarget(const std::string &path, Camera &camera) {
+    try{
+        // the first row of the fbo is at the bottom
+        const Texture2D::TextureData data = Texture2D::readTextureFromDisk(path, true, 4);
+        Texture2D image(data, false, false, false, 1);
+
+        targetfbo.init(data.width, data.height);
+        targetfbo.createAttachment(GL_COLOR_ATTACHMENT0, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+        targetfbo.drawBuffersAllAttachments();
+        glCopyImageSubData(image.getID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                           targetfbo.getAttachment(GL_COLOR_ATTACHMENT0)->getID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                           data.width, data.height, 1);
+    }catch(const std::string& e){
+        std::cout << e << std::endl;
+        return false;
+    }
+    targetPose = camera.getPose();
+    prefetcher.reset();
+    steps = 0;
+    return true;
+}
+
+bool Trainer::loadDataset(const std::string &path) {
+    try{
+        Dataset dataset = Dataset::load(path);
+        if(dataset.views.empty()){
+            std::cout << "The dataset " << path << " has no views." << std::endl;
+            return false;
+        }
+        batchImages.clear();
+        prefetcher.reset();
+        prefetcher = std::make_unique<DatasetPrefetcher>(std::move(dataset), sharedContext, prefetchQueueSize);
+    }catch(const std::string& e){
+        std::cout << e << std::endl;
+        return false;
+    }
+    steps = 0;
+    return true;
+}
+
+void Trainer::perturbPositions(GaussianCloud &cloud) {
+    cloud.downloadAttributes();
+
+    std::mt19937 rng(steps);
+    std::normal_distribution<float> noise(0.0f, perturbation);
+    for(int i=0; i<cloud.num_gaussians; i++){
+        const vec4 s = cloud.scales_cpu[i];
+        const float extent = std::max(s.x, std::max(s.y, s.z));
+        cloud.positions_cpu[i] += vec4(noise(rng), noise(rng), noise(rng), 0.0f) * extent;
+    }
+    cloud.positions.updateData(cloud.positions_cpu.data(), cloud.num_gaussians, 4*sizeof(float), 0);
+    cloud.gaussians_soa.count = 0;
+}
+
+void Trainer::GUI(GaussianCloud &cloud, Camera &camera) {
+    if(!ImGui::TreeNode("Training")){
+        return;
+    }
+
+    if(ImGui::Button("Capture target from the current view")){
+        captureTarget(cloud, camera);
+    }
+    HelpMarker("Renders the current view with the software blending and uses it as the target image. "
+               "Perturb the gaussians, then train to check that the target is recovered.");
+    ImGui::InputText("Image", targetPath, sizeof(targetPath));
+    ImGui::SameLine();
+    if(ImGui::Button("Load target")){
+        loadTarget(targetPath, camera);
+    }
+    HelpMarker("The target image is seen from the current pose, with the field of view of the camera.");
+    ImGui::InputText("Dataset", datasetPath, sizeof(datasetPath));
+    ImGui::SameLine();
+    if(ImGui::Button("Load dataset")){
+        loadDataset(datasetPath);
+    }
+    HelpMarker("A COLMAP folder (sparse/0/cameras.bin, sparse/0/images.bin and images/) or a transforms.json file. "
+               "Each training step uses the next view, in a random order. The images are decoded on worker threads "
+               "and uploaded on the shared context ahead of the training steps.");
+    ImGui::SliderInt("Prefetched images", &prefetchQueueSize, 1, 64);
+    HelpMarker("Number of images decoded or uploaded ahead of the training steps, applied when the dataset is loaded.");
+
+    if(prefetcher){
+        const DatasetPrefetcher::Stats stats = prefetcher->getStats();
+        ImGui::Text("Dataset: %d views, last view %d (%dx%d)", int(prefetcher->getDataset().views.size()),
+                    batchImages.empty() ? -1 : batchImages.back().view, targetSize.x, targetSize.y);
+        ImGui::Text("Decode: %.2fms, upload: %.2fms, stalls: %d/%d, waited %.1fms, failed: %d",
+                    stats.decode_ms, stats.upload_ms, stats.stalls, stats.consumed, stats.wait_ms, stats.failed);
+        if(ImGui::Button("Unload the dataset")){
+            batchImages.clear();
+            prefetcher.reset();
+            steps = 0;
+        }
+    }else if(targetfbo.getWidth() > 0){
+        ImGui::Text("Target: %dx%d", targetfbo.getWidth(), targetfbo.getHeight());
+    }
+
+    if(targetfbo.getWidth() > 0 || prefetcher){
+
+        ImGui::SliderFloat("Position noise", &perturbation, 0.01f, 10.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+        HelpMarker("Standard deviation of the noise added to the positions, relative to the largest scale of each gaussian.");
+        if(ImGui::Button("Perturb the positions")){
+            perturbPositions(cloud);
+        }
+
+        const bool was_training = training;
+        ImGui::Checkbox("Train", &training);
+        ImGui::SameLine();
+        if(ImGui::Button("Single step")){
+            step(cloud, camera);
+            cloud.downloadAttributes();
+        }
+        if(was_training && !training){
+            cloud.downloadAttributes();
+        }
+
+        ImGui::SliderInt("Batch size", &batchSize, 1, MAX_BATCH_SIZE);
+        HelpMarker("Views rendered and backpropagated per optimizer step, their gradients are summed. "
+                   "With a single target image, the same view is repeated.");
+        ImGui::SliderInt("Benchmark steps", &benchmarkSteps, 1, 200);
+        ImGui::SameLine();
+        if(ImGui::Button("Benchmark the batch sizes")){
+            benchmarkBatchSizes(cloud, camera);
+        }
+        HelpMarker("Times the training steps with each batch size from 1 to 8. The gaussians are trained during the "
+                   "benchmark, and the densification is paused.");
+        if(stepsPerSecond[0] > 0.0){
+            for(int b=0; b<MAX_BATCH_SIZE; b++){
+                ImGui::Text("B=%d: %.1f steps/s, %.1f images/s", b+1, stepsPerSecond[b], imagesPerSecond[b]);
+            }
+        }
+
+        ImGui::SliderFloat("lr positions", &adam.lr_positions, 1.0E-8f, 1.0E-1f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        ImGui::SliderFloat("lr scales", &adam.lr_scales, 1.0E-6f, 1.0f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        HelpMarker("The step is taken on log(scale).");
+        ImGui::SliderFloat("lr rotations", &adam.lr_rotations, 1.0E-6f, 1.0f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        ImGui::SliderFloat("lr opacities", &adam.lr_opacities, 1.0E-6f, 1.0f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        HelpMarker("The step is taken on the logit of the opacity.");
+        ImGui::SliderFloat("lr SH degree 0", &adam.lr_sh_dc, 1.0E-6f, 1.0f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        ImGui::SliderFloat("lr SH degrees 1-3", &adam.lr_sh_rest, 1.0E-7f, 1.0f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        ImGui::SliderFloat("beta1", &adam.beta1, 0.0f, 0.999f, "%.3f");
+        ImGui::SliderFloat("beta2", &adam.beta2, 0.0f, 0.99999f, "%.5f");
+        if(ImGui::Button("Reset the optimizer")){
+            steps = 0;
+        }
+        HelpMarker("Adam optimizer. The moments are reset with the next step, and when a new target is set.");
+
+        if(ImGui::Button("Validate the next step on the cpu")){
+            validateOptimizer = true;
+        }
+        HelpMarker("Downloads the attributes, gradients and moments before the next optimizer step, "
+                   "runs the same step with the cpu reference (CpuAdam), and compares the updates.");
+        if(optimizerValidatedOn > 0){
+            const CpuAdam::Difference& d = optimizerDifference;
+            ImGui::Text("On %d gaussians, largest difference relative to the largest update:", optimizerValidatedOn);
+            ImGui::Text("positions %.2e, scales %.2e, rotations %.2e, opacities %.2e, SH %.2e, moments %.2e",
+                        d.positions, d.scales, d.rotations, d.opacities, d.sh, d.moments);
+        }
+
+        ImGui::SliderInt("Densify every", &densifyInterval, 0, 1000, densifyInterval > 0 ? "%d steps" : "never");
+        HelpMarker("The gaussians whose mean gradient of their 2D position is above the threshold are cloned when "
+                   "small, or split in two smaller gaussians when large. The transparent gaussians are pruned. "
+                   "The gradients are accumulated over the training steps since the last densification.");
+        ImGui::SliderFloat("Gradient threshold", &densification.grad_threshold, 1.0E-4f, 1.0f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        HelpMarker("Mean norm of the derivative of the loss with respect to the 2D position, in pixels.");
+        ImGui::SliderFloat("Split above scale", &densification.split_scale, 1.0E-4f, 10.0f, "%.2e", ImGuiSliderFlags_Logarithmic);
+        ImGui::SliderFloat("Prune below opacity", &densification.prune_opacity, 0.0f, 0.5f, "%.3f");
+        ImGui::SliderFloat("Prune above scale", &densification.prune_scale, 0.0f, 100.0f, densification.prune_scale > 0.0f ? "%.2f" : "disabled");
+        if(ImGui::Button("Densify now")){
+            if(densify(cloud, camera)){
+                cloud.downloadAttributes();
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Validate on the cpu", &validateDensification);
+        HelpMarker("Compares the next densification with the cpu reference (CpuDensification).");
+        if(densifications > 0){
+            ImGui::Text("Last densification: %d pruned, %d cloned, %d split, %d gaussians (capacity %d), %.3fms",
+                        lastKindCounts[0], lastKindCounts[2], lastKindCounts[3], cloud.num_gaussians, cloud.capacity,
+                        timers[STAGES::DENSIFICATION].getLastResult() * 1.0E-6);
+        }
+        if(densificationValidatedOn > 0){
+            ImGui::Text("On %d gaussians, %d mismatches with the cpu reference", densificationValidatedOn, densificationMismatches);
+        }
+
+        const char* modes[] = {"fp16, subgroup sums", "fp16 atomics", "fp32 atomics", "fp32, subgroup sums"};
+        ImGui::Combo("Gradient accumulation", &cloud.gradientAccumulation, modes, GRADIENTS_MODES);
+        HelpMarker("Precision of the derivatives with respect to the 2D splats summed over the fragments by "
+                   "quad_interlock_bwd.fs. The subgroup sums reduce the fragments of the same splat in the "
+                   "subgroup before a single atomic, the fp16 atomics save bandwidth but lose precision "
+                   "on the splats covering many pixels.");
+        ImGui::SliderInt("Repeats", &accumulationRepeats, 1, 100);
+        ImGui::SameLine();
+        if(ImGui::Button("Compare the accumulation modes")){
+            compareAccumulationModes(cloud, camera);
+        }
+        HelpMarker("Runs the backward blending on the current target view with each mode, compares the gradients "
+                   "with the double precision cpu reference (CpuBlendingBackward), and times the blending.");
+        if(accumulationComparedOn > 0){
+            ImGui::Text("On %d visible gaussians, relative L2 error of the gradients:", accumulationComparedOn);
+            for(int m=0; m<GRADIENTS_MODES; m++){
+                const CpuBlendingBackward::Error& e = accumulationErrors[m];
+                ImGui::Text("%-20s colors %.2e, conic/opacity %.2e, mean2D %.2e, %.3fms",
+                            modes[m], e.colors, e.conic_opacity, e.mean2D, accumulationTimes[m]);
+            }
+        }
+
+        if(steps > 0){
+            // mean of the squared error over the pixels and color channels
+            const double mse = lastLoss / (3.0 * targetSize.x * targetSize.y);
+            ImGui::Text("Step %d, loss: %.2f, PSNR: %.2fdB", steps, lastLoss, mse > 0.0 ? -10.0 * log10(mse) : INFINITY);
+            ImGui::Text("Loss: %.3fms, backward blending: %.3fms, colors: %.3fms, geometry: %.3fms, step: %.3fms",
+                        timers[STAGES::LOSS].getLastResult() * 1.0E-6,
+                        timers[STAGES::BACKWARD_BLENDING].getLastResult() * 1.0E-6,
+                        timers[STAGES::BACKWARD_COLORS].getLastResult() * 1.0E-6,
+                        timers[STAGES::BACKWARD_GEOMETRY].getLastResult() * 1.0E-6,
+                        timers[STAGES::OPTIMIZER_STEP].getLastResult() * 1.0E-6);
+        }
+    }else{
+        training = false;
+    }
+
+    ImGui::TreePop();
+}
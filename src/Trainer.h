@@ -0,0 +1,218 @@
+//
+// Created by Briac on 19/10/2026.
+//
+
+#ifndef HARDWARERASTERIZED3DGS_TRAINER_H
+#define HARDWARERASTERIZED3DGS_TRAINER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RenderingBase/FBO.h"
+#include "RenderingBase/GLTimer.h"
+#include "RenderingBase/Camera.h"
+#include "RenderingBase/Texture2D.h"
+
+#include "CpuAdam.h"
+#include "CpuDensification.h"
+#include "CpuBlendingBackward.h"
+#include "Dataset.h"
+#include "RenderingBase/GLBuffer.h"
+
+class GaussianCloud;
+class SharedContext;
+struct DensifyUniforms;
+
+/**
+ * Fine-tunes the gaussians on a target image with the hardware rasterizer.
+ * A training step renders the target view with the software alpha-blending (quad_interlock.fs),
+ * computes the loss, then runs the backward pass:
+ * quad_interlock_bwd.fs blends the quads again in the same order to get the derivatives with respect to
+ * the 2D splats and colors, predict_colors_bwd.cp and computeBoundingBoxes_bwd.cp propagate them to the
+ * attributes of the gaussians, and adamStep.cp updates the attributes in place with the Adam optimizer.
+ * Every densifyInterval steps, the gaussians with a large mean gradient of their 2D position are cloned or split,
+ * and the transparent ones are pruned (densifyMark.cp, densifyScatter.cp).
+ * The target is either a single image, or the views of a dataset prefetched on the shared context.
+ * Loss = sum over the pixels of dot(color - target, color - target).
+ */
+class Trainer {
+public:
+    explicit Trainer(SharedContext& sharedContext) : sharedContext(sharedContext) {}
+    virtual ~Trainer() = default;
+
+    Trainer(const Trainer&) = delete;
+    Trainer& operator=(const Trainer&) = delete;
+
+    void GUI(GaussianCloud& cloud, Camera& camera);
+
+    // the training steps replace the regular render while true
+    bool isTraining() const{
+        return training;
+    }
+
+    /**
+     * One training step on the target view, or on the next views of the dataset when one is loaded.
+     * The gradients of batchSize views are summed before the optimizer step. The settings of the cloud that
+     * the backward pass doesn't support are overridden during the step.
+     * Returns false when there is no target or no visible gaussian.
+     */
+    bool step(GaussianCloud& cloud, Camera& camera);
+
+    /**
+     * Times benchmarkSteps training steps with each batch size from 1 to MAX_BATCH_SIZE.
+     * The gaussians are trained by the benchmark.
+     */
+    void benchmarkBatchSizes(GaussianCloud& cloud, Camera& camera);
+
+    // Renders the current view and uses it as the target, with the same pose.
+    void captureTarget(GaussianCloud& cloud, Camera& camera);
+    // Loads the target from an image file, seen from the current pose.
+    bool loadTarget(const std::string& path, Camera& camera);
+    // Loads a COLMAP folder or a transforms.json file, the next steps iterate over its views.
+    bool loadDataset(const std::string& path);
+
+    float getLastLoss() const{
+        return lastLoss;
+    }
+
+    /**
+     * Clones, splits and prunes the gaussians with the statistics accumulated since the last densification,
+     * then resets the statistics. The gaussians are written to a second set of attribute and moment buffers,
+     * which is swapped with the buffers of the cloud. Both sets are reallocated only when the capacity is exceeded.
+     * Returns false when there are no statistics or when all the gaussians would be pruned.
+     */
+    bool densify(GaussianCloud& cloud, Camera& camera);
+
+    /**
+     * Runs the backward blending on the current target view with each accumulation mode of the gradients (GRADIENTS_*),
+     * and compares the derivatives with respect to the 2D splats with the double precision cpu reference.
+     * The attributes of the gaussians are not modified.
+     * Returns false when there is no target or no visible gaussian.
+     */
+    bool compareAccumulationModes(GaussianCloud& cloud, Camera& camera);
+
+private:
+    // the settings of the cloud changed by the training steps
+    struct Settings{
+        bool renderAsPoints;
+        bool renderAsQuads;
+        int blending;
+        bool front_to_back;
+        bool antialiasing;
+        float scale_modifier;
+        bool earlyTermination;
+        bool foveation;
+        bool colorCache;
+        bool shLod;
+        bool dynamicResolution;
+        glm::ivec2 renderSize;
+    };
+    // returns the previous settings, the render size is kept when size is 0
+    Settings useTrainingSettings(GaussianCloud& cloud, glm::ivec2 size) const;
+    void restoreSettings(GaussianCloud& cloud, const Settings& settings) const;
+    // the next count images of the dataset, returns false when they can't be decoded
+    bool acquireBatch(int count);
+    // Sets the pose and size of the view of the target, the image of the batch at index when a dataset is loaded.
+    Texture2D* selectTarget(Camera& view, int index);
+
+    void allocateGradients(GaussianCloud& cloud);
+    void allocateMoments(GaussianCloud& cloud);
+    void clearGradients(GaussianCloud& cloud);
+    // the gradients of the visible gaussians of a view, cleared between the views of a batch
+    void clearSplatGradients(GaussianCloud& cloud);
+    void clearMoments(GaussianCloud& cloud);
+    void allocateBackwardImage(); // at the size of the target
+    void backward(GaussianCloud& cloud);
+    // the loss and quad_interlock_bwd.fs, the first half of backward
+    void backwardBlending(GaussianCloud& cloud);
+    void optimizerStep(GaussianCloud& cloud);
+    // runs the optimizer step on the gpu and on the cpu with CpuAdam, and compares the results
+    void validateOptimizerStep(GaussianCloud& cloud);
+    void perturbPositions(GaussianCloud& cloud);
+
+    FBO targetfbo; // rgba8 target image
+    Camera::Pose targetPose{};
+    std::unique_ptr<Texture2D> backward_image; // blending of the backward pass, same size and format as the fbo
+    glm::ivec2 targetSize = glm::ivec2(0); // of the last step
+
+    SharedContext& sharedContext;
+    std::unique_ptr<DatasetPrefetcher> prefetcher; // the dataset replaces the target image when loaded
+    std::vector<DatasetPrefetcher::Image> batchImages; // targets of the last step
+    char datasetPath[256] = "dataset";
+    int prefetchQueueSize = 8;
+
+    static constexpr int MAX_BATCH_SIZE = 8;
+    int batchSize = 1; // views per optimizer step
+    int benchmarkSteps = 20;
+    double stepsPerSecond[MAX_BATCH_SIZE] = {0}; // of the last benchmark, for each batch size
+    double imagesPerSecond[MAX_BATCH_SIZE] = {0};
+
+    bool training = false;
+    int steps = 0; // the moments of the optimizer are reset when 0
+    float lastLoss = 0.0f;
+    char targetPath[256] = "target.png";
+    float perturbation = 0.5f; // standard deviation of the position noise, relative to the largest scale
+
+    AdamSettings adam;
+    bool validateOptimizer = false; // compare the next optimizer step with the cpu reference
+    int optimizerValidatedOn = 0; // number of gaussians of the last comparison
+    CpuAdam::Difference optimizerDifference;
+
+    DensificationSettings densification;
+    int densifyInterval = 0; // steps between two densifications, disabled when 0
+    int densifications = 0; // seed of the positions of the split gaussians
+    bool validateDensification = false; // compare the next densification with the cpu reference
+    int densificationValidatedOn = 0; // number of gaussians of the last comparison
+    int densificationMismatches = 0; // kinds and output gaussians that differ from the cpu reference
+    int lastKindCounts[4] = {0}; // pruned, kept, cloned and split gaussians of the last densification
+
+    // The output of the densification, with the capacity of the cloud, swapped with its attributes and moments.
+    struct DensifiedBuffers{
+        int capacity = 0; // 0 when not allocated
+        GLBuffer positions;
+        GLBuffer scales;
+        GLBuffer rotations;
+        GLBuffer opacities;
+        GLBuffer sh_coeffs[3];
+        GLBuffer sh_coeffs_interleaved;
+        GLBuffer baked_colors;
+        GLBuffer moments_positions;
+        GLBuffer moments_scales;
+        GLBuffer moments_rotations;
+        GLBuffer moments_opacities;
+        GLBuffer moments_sh;
+
+        void allocate(int capacity);
+        void reset();
+        // the moments of the gaussians from first to capacity
+        void clearMoments(int first);
+        void fillUniforms(DensifyUniforms& u) const;
+        void swap(GaussianCloud& cloud);
+    };
+    DensifiedBuffers densified;
+
+    int accumulationComparedOn = 0; // number of visible gaussians of the last comparison
+    int accumulationRepeats = 10; // backward blendings timed for each mode
+    std::vector<CpuBlendingBackward::Error> accumulationErrors; // for each GRADIENTS_* mode
+    std::vector<double> accumulationTimes; // mean time of the backward blending for each mode, in ms
+    GLBuffer densify_kinds;
+    GLBuffer densify_counts; // cuda interop for the prefix sum
+    GLBuffer densify_offsets;
+    GLBuffer densify_kind_counters;
+    GLBuffer densify_uniforms;
+
+    enum STAGES{
+        LOSS,
+        BACKWARD_BLENDING,
+        BACKWARD_COLORS,
+        BACKWARD_GEOMETRY,
+        OPTIMIZER_STEP,
+        DENSIFICATION,
+        NUM_STAGES
+    };
+    QueryBuffer timers[STAGES::NUM_STAGES];
+};
+
+
+#endif //HARDWARERASTERIZED3DGS_TRAINER_H
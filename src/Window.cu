@@ -18,8 +18,13 @@
 #include "RenderingBase/GLShaderLoader.h"
 #include "RenderingBase/GLIntrospection.h"
 #include "RenderingBase/CudaIntrospection.cuh"
+#include "RenderingBase/SharedContext.h"
+#include "RenderingBase/Profiler.h"
 
 #include "PointCloudLoader.h"
+#include "Trainer.h"
+#include "Benchmark.h"
+#include "CameraPath.h"
 
 #include <thread>
 #include <chrono>
@@ -87,7 +92,7 @@ static void scroll_callback(GLFWwindow *window, double xoffset,
     scroll = yoffset;
 }
 
-Window::Window(const std::string &title, int samples) {
+Window::Window(const std::string &title, int samples, bool visible) {
     if (!glfwInit())
         throw "Error while initializing GLFW";
 
@@ -97,7 +102,7 @@ Window::Window(const std::string &title, int samples) {
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_API, GLFW_TRUE);
     glfwWindowHint(GLFW_SAMPLES, samples);
-    glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
+    glfwWindowHint(GLFW_MAXIMIZED, visible ? GLFW_TRUE : GLFW_FALSE);
     glfwWindowHint(GLFW_FOCUS_ON_SHOW, GLFW_TRUE);
 //    glfwWindowHint(GLFW_CONTEXT_RELEASE_BEHAVIOR, GLFW_RELEASE_BEHAVIOR_FLUSH);
     glfwWindowHint(GLFW_CONTEXT_RELEASE_BEHAVIOR, GLFW_RELEASE_BEHAVIOR_NONE);
@@ -106,7 +111,7 @@ Window::Window(const std::string &title, int samples) {
     glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
 //    glfwWindowHint(GLFW_CONTEXT_NO_ERROR, GLFW_FALSE);
 
-//    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 //    glfwWindowHint(GLFW_FOCUS_ON_SHOW, GLFW_FALSE);
 
     w = glfwCreateWindow(800, 600, title.c_str(), NULL, NULL);
@@ -192,6 +197,12 @@ void loadHeaders(){
     headers.push_back("resources/shaders/common/CommonTypes.h");
     headers.push_back("resources/shaders/common/Uniforms.h");
     headers.push_back("resources/shaders/common/Covariance.h");
+    headers.push_back("resources/shaders/common/SphericalHarmonics.h");
+    headers.push_back("resources/shaders/common/ColorCache.h");
+    headers.push_back("resources/shaders/common/Tiles.h");
+    headers.push_back("resources/shaders/common/SplatProxy.h");
+    headers.push_back("resources/shaders/common/Foveation.h");
+    headers.push_back("resources/shaders/common/Densification.h");
     GLShaderLoader::instance->loadHeaders(headers, m, re);
 }
 
@@ -199,6 +210,7 @@ void Window::mainloop(int argc, char **argv) {
 
     Camera camera;
     GLShaderLoader shaderLoader("resources/shaders", "SparseVoxelReconstruction");
+    Profiler profiler;
     loadHeaders();
 
     unsigned int gl_device_count;
@@ -217,9 +229,27 @@ void Window::mainloop(int argc, char **argv) {
 
     GaussianCloud cloud;
     cloud.initShaders();
+    // uploads the images of the training datasets in the background
+    SharedContext sharedContext(w, EGL_Data{});
+    Trainer trainer(sharedContext);
+
+    // command line benchmark, without the GUI
+    const Benchmark::Options options = Benchmark::parse(argc, argv);
+    if(options.enabled){
+        Benchmark benchmark(options);
+        if(!benchmark.run(w, cloud, camera)){
+            throw std::string("The benchmark failed");
+        }
+        return;
+    }
+
+    CameraPathPlayer cameraPathPlayer;
 
     bool windowHovered = false;
     while (!glfwWindowShouldClose(this->w)) {
+        profiler.newFrame();
+        Profiler::CpuScope frameScope("frame");
+
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
@@ -243,6 +273,9 @@ void Window::mainloop(int argc, char **argv) {
         }
 
         camera.updateView(w, windowHovered, (float)scroll);
+        cameraPathPlayer.GUI();
+        cameraPathPlayer.update(camera);
+        profiler.GUI();
 
 
         int width, height;
@@ -256,19 +289,33 @@ void Window::mainloop(int argc, char **argv) {
 
         if(cloud.initialized){
             cloud.GUI(camera);
-            cloud.render(camera);
+            trainer.GUI(cloud, camera);
+            if(trainer.isTraining()){
+                Profiler::CpuScope scope("training step");
+                trainer.step(cloud, camera);
+            }else{
+                Profiler::CpuScope scope("render");
+                cloud.render(camera);
+            }
         }
 
         windowHovered = ImGui::GetIO().WantCaptureMouse;
 
         ImGui::End();
 
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            Profiler::CpuScope scope("imgui");
+            Profiler::GLScope glScope("imgui");
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
         scroll *= 0.90f;
 
-        glfwSwapBuffers(this->w);
+        {
+            Profiler::CpuScope scope("swap buffers");
+            glfwSwapBuffers(this->w);
+        }
         glfwPollEvents();
 
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
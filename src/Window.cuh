@@ -13,7 +13,8 @@
 
 class Window {
 public:
-    Window(const std::string& title, int samples);
+    // The window is hidden when not visible, for the benchmark
+    Window(const std::string& title, int samples, bool visible = true);
     ~Window();
 
     void mainloop(int argc, char* argv[]);